@@ -0,0 +1,27 @@
+#ifndef RM_DS_SLL_BENCH_COMMON_H
+#define RM_DS_SLL_BENCH_COMMON_H
+
+#include <stdint.h>
+#include <time.h>
+
+/* Monotonic wall clock in seconds */
+static inline double benchNow(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* xorshift32: a cheap per thread pseudo random sequence (seed must not be 0) */
+static inline uint32_t benchRandom(uint32_t* state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+/* Keeps the optimizer from discarding a computed result */
+static volatile uintptr_t bench_sink;
+
+#endif //RM_DS_SLL_BENCH_COMMON_H
@@ -0,0 +1,142 @@
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "SinglyLinkedList.h"
+#include "SinglyLinkedListEpoch.h"
+#include "bench_common.h"
+
+/*
+ * Reader scaling of a read-mostly list: R readers traverse the whole list in a loop while one writer
+ * replaces a node every WRITE_INTERVAL_US. Compares a plain list behind a pthread reader-writer lock
+ * with the epoch list (lock free readers, quiescent state reclamation).
+ */
+
+#define LENGTH 1000
+#define MAX_READERS 8
+#define RUN_SECONDS 0.5
+#define WRITE_INTERVAL_US 100
+
+typedef struct shared_t {
+    int use_epoch;
+    int stop; /* accessed atomically */
+    ds_sll_t* list;
+    pthread_rwlock_t rwlock;
+    ds_sll_epoch_list_t* epochList;
+} shared_t;
+
+typedef struct reader_t {
+    pthread_t thread;
+    shared_t* shared;
+    long traversals;
+    long sum;
+} reader_t;
+
+static ds_sll_func_return_t addElement(void* element, ds_sll_node_t* node, int index, void* sum) {
+    *(long*)sum += *(int*)element;
+    return DS_SLL_CONTINUE_EXECUTION;
+}
+
+static int* newElement(int value) {
+    int* element = (int*)malloc(sizeof(int));
+    *element = value;
+    return element;
+}
+
+static void* readerBody(void* arg) {
+    reader_t* reader = (reader_t*)arg;
+    shared_t* shared = reader->shared;
+    ds_sll_epoch_reader_t* epochReader = shared->use_epoch ? ds_sll_epochRegisterReader(shared->epochList) : NULL;
+    long sum = 0;
+
+    while(!__atomic_load_n(&shared->stop, __ATOMIC_RELAXED)) {
+        if(shared->use_epoch) {
+            ds_sll_epochExecuteFunctionOnElements(shared->epochList, addElement, &sum);
+            ds_sll_epochQuiescentState(shared->epochList, epochReader);
+        } else {
+            pthread_rwlock_rdlock(&shared->rwlock);
+            ds_sll_executeFunctionOnElements(shared->list, addElement, &sum);
+            pthread_rwlock_unlock(&shared->rwlock);
+        }
+        reader->traversals++;
+    }
+
+    if(epochReader != NULL) {
+        ds_sll_epochUnregisterReader(shared->epochList, &epochReader);
+    }
+    reader->sum = sum;
+    return NULL;
+}
+
+static void* writerBody(void* arg) {
+    shared_t* shared = (shared_t*)arg;
+    struct timespec pause = { 0, WRITE_INTERVAL_US * 1000L };
+    int value = LENGTH;
+
+    while(!__atomic_load_n(&shared->stop, __ATOMIC_RELAXED)) {
+        if(shared->use_epoch) {
+            ds_sll_epochDeleteNodeAtIndex(shared->epochList, LENGTH / 2);
+            ds_sll_epochInsertElementAtIndex(shared->epochList, newElement(value++), LENGTH / 2);
+        } else {
+            pthread_rwlock_wrlock(&shared->rwlock);
+            ds_sll_deleteNodeAtIndex(shared->list, LENGTH / 2);
+            ds_sll_insertElementAtIndex(shared->list, newElement(value++), LENGTH / 2);
+            pthread_rwlock_unlock(&shared->rwlock);
+        }
+        nanosleep(&pause, NULL);
+    }
+    return NULL;
+}
+
+int main(void) {
+    static const char* mode_names[] = { "rwlock", "epoch" };
+
+    printf("%-7s %8s %16s %20s\n", "list", "readers", "traversals/s", "per reader/s");
+    for(int use_epoch = 0; use_epoch <= 1; use_epoch++) {
+        for(int readers = 1; readers <= MAX_READERS; readers *= 2) {
+            shared_t shared = { use_epoch, 0, NULL, PTHREAD_RWLOCK_INITIALIZER, NULL };
+            if(use_epoch) {
+                shared.epochList = ds_sll_newEpochList();
+                for(int i = 0; i < LENGTH; i++) {
+                    ds_sll_epochAppendElement(shared.epochList, newElement(i));
+                }
+            } else {
+                shared.list = ds_sll_newSinglyLinkedList();
+                for(int i = 0; i < LENGTH; i++) {
+                    ds_sll_appendElement(shared.list, newElement(i));
+                }
+            }
+
+            reader_t threads[MAX_READERS];
+            pthread_t writer;
+            double start = benchNow();
+            for(int r = 0; r < readers; r++) {
+                threads[r].shared = &shared;
+                threads[r].traversals = 0;
+                pthread_create(&threads[r].thread, NULL, readerBody, &threads[r]);
+            }
+            pthread_create(&writer, NULL, writerBody, &shared);
+
+            struct timespec run = { 0, (long)(RUN_SECONDS * 1e9) };
+            nanosleep(&run, NULL);
+            __atomic_store_n(&shared.stop, 1, __ATOMIC_RELAXED);
+
+            long total = 0;
+            pthread_join(writer, NULL);
+            for(int r = 0; r < readers; r++) {
+                pthread_join(threads[r].thread, NULL);
+                total += threads[r].traversals;
+                bench_sink += (uintptr_t)threads[r].sum;
+            }
+            double elapsed = benchNow() - start;
+            printf("%-7s %8d %16.0f %20.0f\n", mode_names[use_epoch], readers, total / elapsed, total / elapsed / readers);
+
+            if(use_epoch) {
+                ds_sll_destroyEpochList(&shared.epochList);
+            } else {
+                ds_sll_destroySinglyLinkedList(&shared.list);
+            }
+        }
+    }
+    return 0;
+}
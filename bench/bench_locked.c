@@ -0,0 +1,63 @@
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "SinglyLinkedListLocked.h"
+#include "bench_common.h"
+
+/*
+ * Writer throughput of the hand-over-hand locked list against the number of writer threads.
+ * Each writer alternates an insert and a delete at random indices in the first PREFILL nodes,
+ * so the list length stays constant for the whole run.
+ */
+
+#define PREFILL 1000
+#define OPS_PER_RUN 40000
+#define MAX_WRITERS 8
+
+typedef struct writer_t {
+    pthread_t thread;
+    ds_sll_locked_t* list;
+    int operations;
+    uint32_t seed;
+} writer_t;
+
+static void* writerBody(void* arg) {
+    writer_t* writer = (writer_t*)arg;
+    for(int i = 0; i < writer->operations; i += 2) {
+        int* element = (int*)malloc(sizeof(int));
+        *element = i;
+        ds_sll_lockedInsertElementAtIndex(writer->list, element, (int)(benchRandom(&writer->seed) % (PREFILL + 1)));
+        ds_sll_lockedDeleteNodeAtIndex(writer->list, (int)(benchRandom(&writer->seed) % PREFILL));
+    }
+    return NULL;
+}
+
+int main(void) {
+    printf("%8s %14s %12s\n", "writers", "ops/s", "ns/op");
+    for(int writers = 1; writers <= MAX_WRITERS; writers *= 2) {
+        ds_sll_locked_t* list = ds_sll_newLockedList();
+        for(int i = 0; i < PREFILL; i++) {
+            int* element = (int*)malloc(sizeof(int));
+            *element = i;
+            ds_sll_lockedInsertElementAtIndex(list, element, i);
+        }
+
+        writer_t threads[MAX_WRITERS];
+        double start = benchNow();
+        for(int t = 0; t < writers; t++) {
+            threads[t].list = list;
+            threads[t].operations = OPS_PER_RUN / writers;
+            threads[t].seed = 0x9E3779B9u * (uint32_t)(t + 1);
+            pthread_create(&threads[t].thread, NULL, writerBody, &threads[t]);
+        }
+        for(int t = 0; t < writers; t++) {
+            pthread_join(threads[t].thread, NULL);
+        }
+        double elapsed = benchNow() - start;
+
+        int total = (OPS_PER_RUN / writers) * writers;
+        printf("%8d %14.0f %12.1f\n", writers, total / elapsed, elapsed * 1e9 / total);
+        ds_sll_destroyLockedList(&list);
+    }
+    return 0;
+}
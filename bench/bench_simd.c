@@ -0,0 +1,144 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "SinglyLinkedListSimd.h"
+#include "bench_common.h"
+
+/*
+ * List kernels (find, count, min, max, sum) for every value type, against the baseline users have without
+ * this module: ds_sll_findNodeContainingElement with an equality callback for find, and
+ * ds_sll_executeFunctionOnElements with a callback for the others. The same kernels are also run at every
+ * supported level on a plain array holding the same values (the list kernels always run the scalar kernels).
+ * Reports ns per value and the speedup over the callback baseline.
+ */
+
+#define LENGTH 200000
+#define REPEATS 20
+
+static const char* type_names[] = { "int32", "int64", "float", "double" };
+static const char* level_names[] = { "scalar", "sse2", "avx2" };
+static const char* kernel_names[] = { "find", "count", "min", "max", "sum" };
+
+/* State shared with the baseline callbacks */
+typedef struct baseline_t {
+    const void* key;
+    long count;
+    double acc;
+} baseline_t;
+
+#define BASELINE_CALLBACKS(NAME, TYPE) \
+static int equal_##NAME(void* a, void* b) { return *(TYPE*)a == *(TYPE*)b; } \
+static ds_sll_func_return_t count_##NAME(void* element, ds_sll_node_t* node, int index, void* data) { \
+    baseline_t* b = data; b->count += (*(TYPE*)element == *(const TYPE*)b->key); return DS_SLL_CONTINUE_EXECUTION; } \
+static ds_sll_func_return_t min_##NAME(void* element, ds_sll_node_t* node, int index, void* data) { \
+    baseline_t* b = data; if(index == 0 || *(TYPE*)element < b->acc) b->acc = *(TYPE*)element; return DS_SLL_CONTINUE_EXECUTION; } \
+static ds_sll_func_return_t max_##NAME(void* element, ds_sll_node_t* node, int index, void* data) { \
+    baseline_t* b = data; if(index == 0 || *(TYPE*)element > b->acc) b->acc = *(TYPE*)element; return DS_SLL_CONTINUE_EXECUTION; } \
+static ds_sll_func_return_t sum_##NAME(void* element, ds_sll_node_t* node, int index, void* data) { \
+    baseline_t* b = data; b->acc += *(TYPE*)element; return DS_SLL_CONTINUE_EXECUTION; }
+
+BASELINE_CALLBACKS(int32, int32_t)
+BASELINE_CALLBACKS(int64, int64_t)
+BASELINE_CALLBACKS(float, float)
+BASELINE_CALLBACKS(double, double)
+
+static int (*const equal_funcs[])(void*, void*) = { equal_int32, equal_int64, equal_float, equal_double };
+static ds_sll_func_return_t (*const callback_funcs[][4])(void*, ds_sll_node_t*, int, void*) = {
+    { count_int32, count_int64, count_float, count_double },
+    { min_int32, min_int64, min_float, min_double },
+    { max_int32, max_int64, max_float, max_double },
+    { sum_int32, sum_int64, sum_float, sum_double },
+};
+
+static void runBaseline(int kernel, ds_sll_t* list, ds_sll_simd_type_t type, const void* key) {
+    baseline_t b = { key, 0, 0.0 };
+    if(kernel == 0) {
+        bench_sink += (uintptr_t)ds_sll_findNodeContainingElement(list, (void*)key, equal_funcs[type], NULL);
+    } else {
+        ds_sll_executeFunctionOnElements(list, callback_funcs[kernel - 1][type], &b);
+        bench_sink += (uintptr_t)b.count + (uintptr_t)b.acc;
+    }
+}
+
+static void runKernel(int kernel, ds_sll_t* list, ds_sll_simd_type_t type, const void* key) {
+    unsigned char result[8];
+    switch(kernel) {
+        case 0: bench_sink += (uintptr_t)ds_sll_findNodeContainingValue(list, type, key, NULL); break;
+        case 1: bench_sink += (uintptr_t)ds_sll_countNodesContainingValue(list, type, key); break;
+        case 2: ds_sll_minValue(list, type, result); bench_sink += result[0]; break;
+        case 3: ds_sll_maxValue(list, type, result); bench_sink += result[0]; break;
+        default: ds_sll_sumValues(list, type, result); bench_sink += result[0]; break;
+    }
+}
+
+static void runArrayKernel(int kernel, const void* values, ds_sll_simd_type_t type, const void* key) {
+    unsigned char result[8];
+    switch(kernel) {
+        case 0: bench_sink += (uintptr_t)ds_sll_simdFindFirst(values, LENGTH, type, key); break;
+        case 1: bench_sink += (uintptr_t)ds_sll_simdCount(values, LENGTH, type, key); break;
+        case 2: ds_sll_simdMin(values, LENGTH, type, result); bench_sink += result[0]; break;
+        case 3: ds_sll_simdMax(values, LENGTH, type, result); bench_sink += result[0]; break;
+        default: ds_sll_simdSum(values, LENGTH, type, result); bench_sink += result[0]; break;
+    }
+}
+
+/* ns per value of one way to run a kernel (on_array selects the array kernels, baseline the callback path) */
+static double timeKernel(int kernel, ds_sll_t* list, const void* values, ds_sll_simd_type_t type, const void* key,
+                         int on_array, int baseline) {
+    double start = 0.0;
+    for(int r = -1; r < REPEATS; r++) { // r == -1 warms up
+        if(r == 0) {
+            start = benchNow();
+        }
+        if(baseline) {
+            runBaseline(kernel, list, type, key);
+        } else if(on_array) {
+            runArrayKernel(kernel, values, type, key);
+        } else {
+            runKernel(kernel, list, type, key);
+        }
+    }
+    return (benchNow() - start) * 1e9 / ((double)REPEATS * LENGTH);
+}
+
+int main(void) {
+    ds_sll_simd_level_t best = ds_sll_simdDetectLevel();
+    uint32_t seed = 12345;
+
+    printf("%-7s %-6s %-16s %10s %12s\n", "type", "kernel", "variant", "ns/value", "vs callback");
+    for(int type = DS_SLL_SIMD_INT32; type <= DS_SLL_SIMD_DOUBLE; type++) {
+        size_t size = ds_sll_simdTypeSize((ds_sll_simd_type_t)type);
+        unsigned char value[8], key[8];
+        unsigned char* values = malloc(size * LENGTH);
+        ds_sll_t* list = ds_sll_newSinglyLinkedList();
+        for(int i = 0; i < LENGTH; i++) {
+            int32_t v = (int32_t)(benchRandom(&seed) % 100000);
+            switch(type) {
+                case DS_SLL_SIMD_INT32: memcpy(value, &v, 4); break;
+                case DS_SLL_SIMD_INT64: { int64_t w = v; memcpy(value, &w, 8); break; }
+                case DS_SLL_SIMD_FLOAT: { float w = (float)v; memcpy(value, &w, 4); break; }
+                default: { double w = v; memcpy(value, &w, 8); break; }
+            }
+            ds_sll_appendElementCopy(list, value, size);
+            memcpy(values + i * size, value, size);
+        }
+        memset(key, 0xFF, sizeof(key)); // never found: find and count walk the whole list
+
+        for(int kernel = 0; kernel < 5; kernel++) {
+            double callback_ns = timeKernel(kernel, list, values, (ds_sll_simd_type_t)type, key, 0, 1);
+            printf("%-7s %-6s %-16s %10.3f %11.2fx\n", type_names[type], kernel_names[kernel], "list callback", callback_ns, 1.0);
+            double ns = timeKernel(kernel, list, values, (ds_sll_simd_type_t)type, key, 0, 0);
+            printf("%-7s %-6s %-16s %10.3f %11.2fx\n", type_names[type], kernel_names[kernel], "list kernel", ns, callback_ns / ns);
+            for(int level = DS_SLL_SIMD_SCALAR; level <= (int)best; level++) {
+                char variant[32];
+                ds_sll_simdSetLevel((ds_sll_simd_level_t)level);
+                ns = timeKernel(kernel, list, values, (ds_sll_simd_type_t)type, key, 1, 0);
+                snprintf(variant, sizeof(variant), "array %s", level_names[level]);
+                printf("%-7s %-6s %-16s %10.3f %11.2fx\n", type_names[type], kernel_names[kernel], variant, ns, callback_ns / ns);
+            }
+        }
+        ds_sll_destroySinglyLinkedList(&list);
+        free(values);
+    }
+    return 0;
+}
@@ -0,0 +1,104 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "SinglyLinkedList.h"
+#include "SinglyLinkedListSlab.h"
+#include "bench_common.h"
+
+/*
+ * ds_sll_executeFunctionOnElements throughput on nodes from malloc against nodes from a slab
+ * (regular, transparent huge and explicit huge pages). The nodes are linked in a random order after
+ * they are allocated, so the traversal pays for TLB misses the way a long lived, churned list does.
+ * Explicit huge pages need pages reserved by the administrator (vm.nr_hugepages); without them the slab falls back
+ * to transparent huge pages and the row is labelled with the fallback.
+ *
+ * Usage: bench_slab [nodes]   (default 2^21)
+ */
+
+#define REPEATS 3
+
+static const char* mode_names[] = { "malloc", "slab regular pages", "slab transparent huge", "slab explicit huge" };
+
+static ds_sll_func_return_t addElement(void* element, ds_sll_node_t* node, int index, void* sum) {
+    *(long*)sum += *(int*)element;
+    return DS_SLL_CONTINUE_EXECUTION;
+}
+
+/* Relink the nodes in a random order to defeat the sequential layout of both allocators */
+static void shuffleLinks(ds_sll_t* list, int length, uint32_t* seed) {
+    ds_sll_node_t** nodes = (ds_sll_node_t**)malloc(sizeof(ds_sll_node_t*) * length);
+    int i = 0;
+    for(ds_sll_node_t* node = list->head; node != NULL; node = node->next) {
+        nodes[i++] = node;
+    }
+    for(i = length - 1; i > 0; i--) {
+        int j = (int)(benchRandom(seed) % (uint32_t)(i + 1));
+        ds_sll_node_t* swap = nodes[i];
+        nodes[i] = nodes[j];
+        nodes[j] = swap;
+    }
+    for(i = 0; i < length - 1; i++) {
+        nodes[i]->next = nodes[i + 1];
+    }
+    nodes[length - 1]->next = NULL;
+    list->head = nodes[0];
+    list->tail = nodes[length - 1];
+    free(nodes);
+}
+
+int main(int argc, char** argv) {
+    int length = (argc > 1) ? atoi(argv[1]) : (1 << 21);
+    static const ds_sll_slab_pages_t pages[] = { DS_SLL_SLAB_PAGES_DEFAULT, DS_SLL_SLAB_PAGES_TRANSPARENT, DS_SLL_SLAB_PAGES_EXPLICIT };
+    double baseline = 0.0;
+
+    if(length < 1) {
+        fprintf(stderr, "usage: %s [nodes]\n", argv[0]);
+        return 1;
+    }
+
+    printf("%-40s %12s %9s %14s\n", "nodes from", "Mnodes/s", "speedup", "huge bytes");
+    for(int mode = 0; mode < 4; mode++) {
+        uint32_t seed = 2463534242u;
+        ds_sll_t* list = ds_sll_newSinglyLinkedList();
+        ds_sll_slab_t* slab = NULL;
+
+        if(mode == 0) {
+            for(int i = 0; i < length; i++) {
+                ds_sll_appendElementCopy(list, &i, sizeof(i));
+            }
+        } else {
+            slab = ds_sll_newSlab(sizeof(int), 0, pages[mode - 1]);
+            for(int i = 0; i < length; i++) {
+                ds_sll_slabAppendElementCopy(slab, list, &i, sizeof(i));
+            }
+        }
+        shuffleLinks(list, length, &seed);
+
+        long sum = 0;
+        ds_sll_executeFunctionOnElements(list, addElement, &sum); // warm up
+        double start = benchNow();
+        for(int r = 0; r < REPEATS; r++) {
+            ds_sll_executeFunctionOnElements(list, addElement, &sum);
+        }
+        double rate = (double)REPEATS * length / (benchNow() - start) / 1e6;
+        bench_sink += (uintptr_t)sum;
+        if(mode == 0) {
+            baseline = rate;
+        }
+        char name[64];
+        snprintf(name, sizeof(name), "%s", mode_names[mode]);
+        if((slab != NULL) && (pages[mode - 1] == DS_SLL_SLAB_PAGES_EXPLICIT) && (ds_sll_slabPageBytes(slab, DS_SLL_SLAB_PAGES_EXPLICIT) == 0)) {
+            snprintf(name, sizeof(name), "%s (fallback: %s)", mode_names[mode],
+                     (ds_sll_slabPageBytes(slab, DS_SLL_SLAB_PAGES_TRANSPARENT) != 0) ? "THP" : "regular pages");
+        }
+        printf("%-40s %12.2f %8.2fx %14zu\n", name, rate, rate / baseline, slab != NULL ? ds_sll_slabHugePageBytes(slab) : (size_t)0);
+
+        if(slab != NULL) {
+            ds_sll_slabReleaseList(slab, list);
+            ds_sll_destroySlab(&slab);
+            free(list);
+        } else {
+            ds_sll_destroySinglyLinkedList(&list);
+        }
+    }
+    return 0;
+}
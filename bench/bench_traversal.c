@@ -0,0 +1,85 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "SinglyLinkedList.h"
+#include "bench_common.h"
+
+/*
+ * Per node traversal cost with the accessors inlined from the header (after the static inline move),
+ * against the same loop calling out of line copies of them (what every caller outside SinglyLinkedList.c
+ * paid before the move), and against ds_sll_executeFunctionOnElements.
+ *
+ * The default list fits in the caches so the loop overhead is not hidden behind cache misses;
+ * pass a larger node count to see the memory bound case.
+ *
+ * Usage: bench_traversal [nodes]   (default 2^14)
+ */
+
+#define NODE_VISITS (1L << 26)
+
+/* Out of line accessors, the way callers in other translation units saw them before the move */
+__attribute__((noinline)) static ds_sll_node_t* outOfLineNextNode(const ds_sll_node_t* node) {
+    __asm__ volatile("" ::: "memory");
+    return node->next;
+}
+
+__attribute__((noinline)) static void* outOfLineExtractElement(const ds_sll_node_t* node) {
+    __asm__ volatile("" ::: "memory");
+    return node->element;
+}
+
+static long sumInline(const ds_sll_t* list) {
+    long sum = 0;
+    for(ds_sll_node_t* node = list->head; node != NULL; node = ds_sll_nextNode(node)) {
+        sum += *(int*)ds_sll_extractElementFromNode(node);
+    }
+    return sum;
+}
+
+static long sumOutOfLine(const ds_sll_t* list) {
+    long sum = 0;
+    for(ds_sll_node_t* node = list->head; node != NULL; node = outOfLineNextNode(node)) {
+        sum += *(int*)outOfLineExtractElement(node);
+    }
+    return sum;
+}
+
+static ds_sll_func_return_t addElement(void* element, ds_sll_node_t* node, int index, void* sum) {
+    *(long*)sum += *(int*)element;
+    return DS_SLL_CONTINUE_EXECUTION;
+}
+
+static long sumExecute(const ds_sll_t* list) {
+    long sum = 0;
+    ds_sll_executeFunctionOnElements((ds_sll_t*)list, addElement, &sum);
+    return sum;
+}
+
+int main(int argc, char** argv) {
+    int length = (argc > 1) ? atoi(argv[1]) : (1 << 14);
+    static const char* names[] = { "inline accessors", "out of line accessors", "executeFunctionOnElements" };
+    long (*walks[])(const ds_sll_t*) = { sumInline, sumOutOfLine, sumExecute };
+
+    if(length < 1) {
+        fprintf(stderr, "usage: %s [nodes]\n", argv[0]);
+        return 1;
+    }
+
+    long repeats = NODE_VISITS / length + 1;
+    ds_sll_t* list = ds_sll_newSinglyLinkedList();
+    for(int i = 0; i < length; i++) {
+        ds_sll_appendElementCopy(list, &i, sizeof(i));
+    }
+
+    printf("%-26s %10s\n", "traversal", "ns/node");
+    for(int w = 0; w < 3; w++) {
+        bench_sink += (uintptr_t)walks[w](list); // warm up
+        double start = benchNow();
+        for(long r = 0; r < repeats; r++) {
+            bench_sink += (uintptr_t)walks[w](list);
+        }
+        printf("%-26s %10.3f\n", names[w], (benchNow() - start) * 1e9 / ((double)repeats * length));
+    }
+
+    ds_sll_destroySinglyLinkedList(&list);
+    return 0;
+}
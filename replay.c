@@ -0,0 +1,395 @@
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "src/SinglyLinkedList.h"
+#include "src/SinglyLinkedListTrace.h"
+#include "src/SinglyLinkedListLocked.h"
+#include "src/SinglyLinkedListEpoch.h"
+
+/*
+ * Replays a trace recorded with ds_sll_traceStart (see SinglyLinkedListTrace.h) against one of the list implementations,
+ * and reports the throughput and the latency distribution of the replayed operations.
+ *
+ * Usage: ds_sll_replay <trace file> [sll|locked|epoch]
+ *
+ * Element values are not recorded, so every inserted element is a fresh int.
+ * The replay tracks the length of every list itself and skips the operations that would be out of range.
+ * Set operations and partitioning are not recorded (see SinglyLinkedListTrace.h), so after them the tracked lengths
+ * differ from the recorded workload's, and the operations that depend on them are replayed approximately or skipped.
+ * Operations that an implementation does not offer are approximated:
+ *  - find and execute become a full traversal
+ *  - an insert after an unknown node becomes an append, a delete after an unknown node deletes the head
+ *  - split, splice, concatenate, merge, and batched lookups are only replayed against "sll"
+ *  - sorted inserts become appends on "epoch"
+ */
+
+/* Engines */
+typedef struct engine_t {
+    const char* name;
+    void* (*create)();
+    void (*destroy)(void* list);
+    void (*append)(void* list, int* element, int length); /* length is the current length of the list */
+    void (*insert)(void* list, int* element, int index);
+    void (*insertSorted)(void* list, int* element);
+    void (*remove)(void* list, int index);
+    void (*get)(void* list, int index);
+    void (*traverse)(void* list);
+    void (*length)(void* list);
+    int twoListOps; /* split, splice, concatenate, merge, and batched lookups are supported */
+} engine_t;
+
+static volatile int sink;
+
+int compareInts(void* a, void* b) {
+    return *(int*)a - *(int*)b;
+}
+
+ds_sll_func_return_t touchElement(void* element, ds_sll_node_t* node, int index, void* extra) {
+    sink = *(int*)element;
+    return DS_SLL_CONTINUE_EXECUTION;
+}
+
+// core list
+void* sllCreate() { return ds_sll_newSinglyLinkedList(); }
+void sllDestroy(void* list) { ds_sll_destroySinglyLinkedList((ds_sll_t**)&list); }
+void sllAppend(void* list, int* element, int length) { ds_sll_appendElement(list, element); }
+void sllInsert(void* list, int* element, int index) { ds_sll_insertElementAtIndex(list, element, index); }
+void sllInsertSorted(void* list, int* element) { ds_sll_insertElementSorted(list, element, compareInts); }
+void sllRemove(void* list, int index) { ds_sll_deleteNodeAtIndex(list, index); }
+void sllGet(void* list, int index) { sink = *(int*)ds_sll_getElementAtIndex(list, index); }
+void sllTraverse(void* list) { ds_sll_executeFunctionOnElements(list, touchElement, NULL); }
+void sllLength(void* list) { sink = ds_sll_calculateLength(list); }
+
+// thread-safe list
+typedef struct lockedGetParams {
+    int index;
+} lockedGetParams;
+
+ds_sll_func_return_t lockedTouchElement(void* element, ds_sll_locked_node_t* node, int index, void* extra) {
+    sink = *(int*)element;
+    if((extra != NULL) && (((lockedGetParams*)extra)->index == index)) {
+        return DS_SLL_STOP_EXECUTION;
+    }
+    return DS_SLL_CONTINUE_EXECUTION;
+}
+
+void* lockedCreate() { return ds_sll_newLockedList(); }
+void lockedDestroy(void* list) { ds_sll_destroyLockedList((ds_sll_locked_t**)&list); }
+void lockedAppend(void* list, int* element, int length) { ds_sll_lockedInsertElementAtIndex(list, element, length); }
+void lockedInsert(void* list, int* element, int index) { ds_sll_lockedInsertElementAtIndex(list, element, index); }
+void lockedInsertSorted(void* list, int* element) { ds_sll_lockedInsertElementSorted(list, element, compareInts); }
+void lockedRemove(void* list, int index) { ds_sll_lockedDeleteNodeAtIndex(list, index); }
+void lockedGet(void* list, int index) {
+    lockedGetParams params = { index };
+    ds_sll_lockedExecuteFunctionOnElements(list, lockedTouchElement, &params);
+}
+void lockedTraverse(void* list) { ds_sll_lockedExecuteFunctionOnElements(list, lockedTouchElement, NULL); }
+void lockedLength(void* list) { sink = ds_sll_lockedCalculateLength(list); }
+
+// read-mostly list (the replay thread is the only writer and there are no registered readers)
+void* epochCreate() { return ds_sll_newEpochList(); }
+void epochDestroy(void* list) { ds_sll_destroyEpochList((ds_sll_epoch_list_t**)&list); }
+void epochAppend(void* list, int* element, int length) { ds_sll_epochAppendElement(list, element); }
+void epochInsert(void* list, int* element, int index) { ds_sll_epochInsertElementAtIndex(list, element, index); }
+void epochInsertSorted(void* list, int* element) { ds_sll_epochAppendElement(list, element); }
+void epochRemove(void* list, int index) { ds_sll_epochDeleteNodeAtIndex(list, index); ds_sll_epochReclaim(list); }
+void epochGet(void* list, int index) {
+    ds_sll_node_t* node = ds_sll_epochHead(list);
+    while(index-- > 0) {
+        node = ds_sll_epochNextNode(node);
+    }
+    sink = *(int*)ds_sll_extractElementFromNode(node);
+}
+void epochTraverse(void* list) { ds_sll_epochExecuteFunctionOnElements(list, touchElement, NULL); }
+void epochLength(void* list) {
+    int length = 0;
+    ds_sll_node_t* node;
+    for(node = ds_sll_epochHead(list); node != NULL; node = ds_sll_epochNextNode(node)) {
+        length++;
+    }
+    sink = length;
+}
+
+static const engine_t engines[] = {
+    { "sll", sllCreate, sllDestroy, sllAppend, sllInsert, sllInsertSorted, sllRemove, sllGet, sllTraverse, sllLength, 1 },
+    { "locked", lockedCreate, lockedDestroy, lockedAppend, lockedInsert, lockedInsertSorted, lockedRemove, lockedGet, lockedTraverse, lockedLength, 0 },
+    { "epoch", epochCreate, epochDestroy, epochAppend, epochInsert, epochInsertSorted, epochRemove, epochGet, epochTraverse, epochLength, 0 }
+};
+
+
+/* Replay state */
+typedef struct replayList {
+    void* list; /* NULL until the list is first used */
+    int length;
+} replayList;
+
+typedef struct replayState {
+    const engine_t* engine;
+    replayList* lists;
+    int capacity;
+    unsigned next_value;
+} replayState;
+
+/* Returns the list with the given trace id, creating it if it was not seen before (or NULL on error) */
+replayList* getList(replayState* state, uint32_t id) {
+    if(id >= (uint32_t) state->capacity) {
+        int capacity = (state->capacity == 0) ? 64 : state->capacity;
+        while((uint32_t) capacity <= id) {
+            capacity *= 2;
+        }
+        replayList* lists = realloc(state->lists, capacity * sizeof(replayList));
+        if(lists == NULL) {
+            return NULL;
+        }
+        memset(lists + state->capacity, 0, (capacity - state->capacity) * sizeof(replayList));
+        state->lists = lists;
+        state->capacity = capacity;
+    }
+    if(state->lists[id].list == NULL) {
+        state->lists[id].list = state->engine->create();
+        state->lists[id].length = 0;
+    }
+    return &state->lists[id];
+}
+
+int* newElement(replayState* state) {
+    int* element = malloc(sizeof(int));
+    if(element != NULL) {
+        *element = (int)(state->next_value >> 8);
+        state->next_value = state->next_value * 1103515245u + 12345u;
+    }
+    return element;
+}
+
+/* Replays one record. Returns 1 if it was replayed, 0 if it was skipped */
+int replayRecord(replayState* state, const ds_sll_trace_record_t* record) {
+    const engine_t* engine = state->engine;
+    replayList* list;
+    replayList* other = NULL;
+    int* element;
+
+    if((record->list_id == 0) || ((list = getList(state, record->list_id)) == NULL)) {
+        return 0;
+    }
+    if(record->other_list_id != 0) {
+        if(!engine->twoListOps || (record->other_list_id == record->list_id)
+           || ((other = getList(state, record->other_list_id)) == NULL)) {
+            return 0;
+        }
+        list = &state->lists[record->list_id]; // getList may have moved the array
+    }
+
+    switch(record->op) {
+        case DS_SLL_TRACE_NEW_LIST:
+            return 1;
+        case DS_SLL_TRACE_DESTROY_LIST:
+            engine->destroy(list->list);
+            list->list = NULL;
+            return 1;
+        case DS_SLL_TRACE_APPEND:
+        case DS_SLL_TRACE_INSERT_AT_INDEX:
+        case DS_SLL_TRACE_INSERT_AFTER:
+        case DS_SLL_TRACE_INSERT_SORTED:
+            if((element = newElement(state)) == NULL) {
+                return 0;
+            }
+            if(record->op == DS_SLL_TRACE_INSERT_SORTED) {
+                engine->insertSorted(list->list, element);
+            } else if((record->op == DS_SLL_TRACE_INSERT_AT_INDEX) && (record->index >= 0) && (record->index < list->length)) {
+                engine->insert(list->list, element, record->index);
+            } else if((record->op == DS_SLL_TRACE_INSERT_AFTER) && (record->index == 0) && (list->length > 0)) {
+                engine->insert(list->list, element, 0);
+            } else {
+                engine->append(list->list, element, list->length);
+            }
+            list->length++;
+            return 1;
+        case DS_SLL_TRACE_DELETE_AT_INDEX:
+        case DS_SLL_TRACE_DELETE_AFTER:
+            if(record->op == DS_SLL_TRACE_DELETE_AFTER) {
+                if(list->length == 0) {
+                    return 0;
+                }
+                engine->remove(list->list, 0);
+            } else {
+                if((record->index < 0) || (record->index >= list->length)) {
+                    return 0;
+                }
+                engine->remove(list->list, record->index);
+            }
+            list->length--;
+            return 1;
+        case DS_SLL_TRACE_GET_AT_INDEX:
+            if((record->index < 0) || (record->index >= list->length)) {
+                return 0;
+            }
+            engine->get(list->list, record->index);
+            return 1;
+        case DS_SLL_TRACE_FIND:
+        case DS_SLL_TRACE_EXECUTE:
+            engine->traverse(list->list);
+            return 1;
+        case DS_SLL_TRACE_LENGTH:
+            engine->length(list->list);
+            return 1;
+        case DS_SLL_TRACE_SPLIT:
+            if((other == NULL) || (other->length != 0) || (list->length < 2) || (record->index < 0) || (record->index >= list->length - 1)) {
+                return 0;
+            }
+            ds_sll_splitSinglyLinkedListAtIndex(list->list, other->list, record->index);
+            other->length = list->length - record->index - 1;
+            list->length = record->index + 1;
+            return 1;
+        case DS_SLL_TRACE_SPLICE:
+        case DS_SLL_TRACE_CONCATENATE:
+        case DS_SLL_TRACE_MERGE:
+            if(other == NULL) {
+                return 0;
+            }
+            if(record->op == DS_SLL_TRACE_SPLICE) {
+                ds_sll_spliceAfter(list->list, (record->index == 0) ? NULL : ((ds_sll_t*)list->list)->tail, other->list);
+            } else if(record->op == DS_SLL_TRACE_CONCATENATE) {
+                ds_sll_concatenate(list->list, other->list);
+            } else {
+                ds_sll_mergeSortedLists(list->list, other->list, compareInts);
+            }
+            list->length += other->length;
+            other->length = 0;
+            return 1;
+        case DS_SLL_TRACE_BATCH_GET: {
+            int count = record->index, i;
+            if(!engine->twoListOps || (count <= 0) || (list->length == 0)) {
+                return 0;
+            }
+            int* indices = malloc(count * sizeof(int));
+            void** results = malloc(count * sizeof(void*));
+            if((indices != NULL) && (results != NULL)) {
+                for(i = 0; i < count; i++) {
+                    indices[i] = (int)(((long long) i * list->length) / count);
+                }
+                ds_sll_getElementsAtIndices(list->list, indices, count, results);
+            }
+            free(indices);
+            free(results);
+            return 1;
+        }
+        default:
+            return 0;
+    }
+}
+
+
+/* Latency statistics */
+typedef struct latencies {
+    double* samples; /* nanoseconds */
+    long count;
+    long capacity;
+} latencies;
+
+void addSample(latencies* lat, double ns) {
+    if(lat->count == lat->capacity) {
+        long capacity = (lat->capacity == 0) ? 1024 : lat->capacity * 2;
+        double* samples = realloc(lat->samples, capacity * sizeof(double));
+        if(samples == NULL) {
+            return;
+        }
+        lat->samples = samples;
+        lat->capacity = capacity;
+    }
+    lat->samples[lat->count++] = ns;
+}
+
+int compareDoubles(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+double percentile(const latencies* lat, double p) {
+    long rank = (long)(p * (lat->count - 1) + 0.5);
+    return lat->samples[rank];
+}
+
+void printLatencies(const char* name, latencies* lat) {
+    if(lat->count == 0) {
+        return;
+    }
+    qsort(lat->samples, lat->count, sizeof(double), compareDoubles);
+    printf("%-14s %10ld %10.0f %10.0f %10.0f %10.0f %12.0f\n", name, lat->count,
+           percentile(lat, 0.5), percentile(lat, 0.9), percentile(lat, 0.99), percentile(lat, 0.999),
+           lat->samples[lat->count - 1]);
+}
+
+double elapsedNs(const struct timespec* start, const struct timespec* end) {
+    return (end->tv_sec - start->tv_sec) * 1e9 + (end->tv_nsec - start->tv_nsec);
+}
+
+
+int main(int argc, char** argv) {
+    replayState state = { &engines[0], NULL, 0, 1 };
+    latencies all = { NULL, 0, 0 };
+    latencies perOp[DS_SLL_TRACE_OP_COUNT];
+    ds_sll_trace_record_t record;
+    struct timespec start, end;
+    double total_ns = 0;
+    long skipped = 0;
+    FILE* trace;
+    int i;
+
+    if((argc < 2) || (argc > 3)) {
+        fprintf(stderr, "Usage: %s <trace file> [sll|locked|epoch]\n", argv[0]);
+        return 2;
+    }
+    if(argc == 3) {
+        state.engine = NULL;
+        for(i = 0; i < (int)(sizeof(engines) / sizeof(engines[0])); i++) {
+            if(strcmp(argv[2], engines[i].name) == 0) {
+                state.engine = &engines[i];
+            }
+        }
+        if(state.engine == NULL) {
+            fprintf(stderr, "Unknown list implementation: %s\n", argv[2]);
+            return 2;
+        }
+    }
+    if((trace = ds_sll_traceOpen(argv[1])) == NULL) {
+        fprintf(stderr, "Could not open trace: %s\n", argv[1]);
+        return 1;
+    }
+    memset(perOp, 0, sizeof(perOp));
+
+    while(ds_sll_traceRead(trace, &record)) {
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        int replayed = replayRecord(&state, &record);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+
+        if(!replayed) {
+            skipped++;
+            continue;
+        }
+        double ns = elapsedNs(&start, &end);
+        total_ns += ns;
+        addSample(&all, ns);
+        addSample(&perOp[record.op], ns);
+    }
+    fclose(trace);
+
+    printf("engine: %s, replayed: %ld, skipped: %ld, throughput: %.0f ops/s\n", state.engine->name, all.count, skipped,
+           (total_ns > 0) ? all.count / (total_ns / 1e9) : 0.0);
+    printf("%-14s %10s %10s %10s %10s %10s %12s\n", "latency (ns)", "count", "p50", "p90", "p99", "p99.9", "max");
+    printLatencies("all", &all);
+    for(i = 0; i < DS_SLL_TRACE_OP_COUNT; i++) {
+        printLatencies(ds_sll_traceOpName((ds_sll_trace_op_t) i), &perOp[i]);
+        free(perOp[i].samples);
+    }
+    free(all.samples);
+
+    for(i = 0; i < state.capacity; i++) {
+        if(state.lists[i].list != NULL) {
+            state.engine->destroy(state.lists[i].list);
+        }
+    }
+    free(state.lists);
+    return 0;
+}
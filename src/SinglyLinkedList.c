@@ -69,6 +69,11 @@ SOFTWARE.
  * + Extract Element From Node: Extract the element from a given node
  * + Find: Find an element in the linked list using the given equality function
  * + Split: Split the linked list at the given index
+ * + Insert/Delete After: Insert or delete a node right after a given node (constant time)
+ * + Pop Head: Unlink the head of the linked list
+ * + Splice/Concatenate: Move all the nodes of a linked list after a given node or to the end of another list (constant time)
+ * + Insert Sorted: Insert a node in comparator order in a single traversal
+ * + Merge: Merge two (or k) sorted linked lists by relinking their nodes
  * + Execute Function on Elements: Executes the given function on the element of every node
  * + Length Of: Get the length of the linked list
  *
@@ -86,6 +91,7 @@ SOFTWARE.
  **/
 
 #include "SinglyLinkedList.h"
+#include "SinglyLinkedListTrace.h"
 #include <assert.h>
 #include <memory.h>
 
@@ -96,6 +102,16 @@ SOFTWARE.
  */
 #define ASSERT assert
 
+/**
+ * @brief Hint the CPU to start loading the given address into the cache
+ * Used to overlap the cache misses of independent traversals
+ */
+#if defined(__GNUC__)
+#define DS_SLL_PREFETCH(address) __builtin_prefetch(address)
+#else
+#define DS_SLL_PREFETCH(address) ((void)(address))
+#endif
+
 /**
  * @brief Create a new singly linked list
  * @return Returns a pointer to a new Singly Linked List struct (linked list header)
@@ -111,6 +127,7 @@ ds_sll_t* ds_sll_newSinglyLinkedList()
     new_list->head = NULL;
     new_list->tail = NULL;
 
+    DS_SLL_TRACE_RECORD(DS_SLL_TRACE_NEW_LIST, new_list, NULL, 0, 0);
     return new_list;
 }
 
@@ -134,45 +151,6 @@ ds_sll_node_t* ds_sll_createNode(void* element)
 }
 
 
-/**
- * @brief Extract the element contained in the given node
- * @param node The node that contains the element you wish to extract
- * @return The element contained within the given node (void *)
- */
- inline void* ds_sll_extractElementFromNode(ds_sll_node_t* node)
-{
-    return node->element;
-}
-
-
-/**
- * @brief Encapsulate an element within a given node
- * @param node The node to store the element in
- * @param element The element to store in the node
- * The reason that I have abstracted this function is to allow the programmer to change the way data is being
- * stored and extracted within nodes. Note that at the moment of this writing, the nodes store void pointers. Though
- * you may use those pointers as a gate to more complex operations as you see fit.
- */
- inline void ds_sll_storeElementInNode(ds_sll_node_t* node, void* element)
-{
-    node->element = element;
-}
-
-
-/**
- * @brief Inline function that returns the next node in the given list
- * @param node The node to extract the 'next node' from
- * @return The next node located right after the given node
- *
- * The point of this function is to abstract the node->next operation
- * allowing the developer to easily customize the way linked lists are traversed
- */
-inline ds_sll_node_t* ds_sll_nextNode(ds_sll_node_t* node)
-{
-    return node->next;
-}
-
-
 /**
  * @brief Delete an element contained within a node, free any allocated resources, and set the Element pointer to NULL
  * @param element Pointer to the element to delete
@@ -229,6 +207,7 @@ inline ds_sll_node_t* ds_sll_nextNode(ds_sll_node_t* node)
  */
 ds_sll_node_t* ds_sll_getNodeAtIndex(const ds_sll_t* linkedList, int index)
 {
+    DS_SLL_TRACE(DS_SLL_TRACE_GET_AT_INDEX, linkedList, NULL, index, 0);
     ASSERT((linkedList != NULL) && (linkedList->head != NULL) && (linkedList->tail != NULL) && (index >= 0));
 
     ds_sll_node_t* curr = linkedList->head;
@@ -270,6 +249,7 @@ ds_sll_node_t* ds_sll_getNodeAtIndex(const ds_sll_t* linkedList, int index)
  */
  ds_sll_error_t ds_sll_traverseNodeToIndex(const ds_sll_t* linkedList, ds_sll_node_t** node, int index)
 {
+    DS_SLL_TRACE(DS_SLL_TRACE_GET_AT_INDEX, linkedList, NULL, index, 0);
     ASSERT((linkedList != NULL) && (linkedList->head != NULL) && (linkedList->tail != NULL) && (index >= 0));
 
     *node = linkedList->head;
@@ -303,6 +283,7 @@ ds_sll_node_t* ds_sll_getNodeAtIndex(const ds_sll_t* linkedList, int index)
  */
 void* ds_sll_getElementAtIndex(const ds_sll_t* linkedList, int index)
 {
+    DS_SLL_TRACE(DS_SLL_TRACE_GET_AT_INDEX, linkedList, NULL, index, 0);
     ASSERT((linkedList != NULL) && (linkedList->head != NULL) && (linkedList->tail != NULL) && (index >= 0));
     ds_sll_node_t* res = ds_sll_getNodeAtIndex(linkedList, index);
     if(res == NULL) {
@@ -321,6 +302,7 @@ void* ds_sll_getElementAtIndex(const ds_sll_t* linkedList, int index)
  */
  ds_sll_error_t ds_sll_deleteNodeAtIndex(ds_sll_t* linkedList, int index)
 {
+    DS_SLL_TRACE(DS_SLL_TRACE_DELETE_AT_INDEX, linkedList, NULL, index, 0);
     ASSERT((linkedList != NULL) && (linkedList->head != NULL) && (linkedList->tail != NULL) && (index >= 0));
 
     ds_sll_node_t *todel = linkedList->head;
@@ -378,6 +360,7 @@ void* ds_sll_getElementAtIndex(const ds_sll_t* linkedList, int index)
  */
 ds_sll_error_t ds_sll_destroySinglyLinkedList(ds_sll_t **linkedList_toDelete)
 {
+    DS_SLL_TRACE(DS_SLL_TRACE_DESTROY_LIST, *linkedList_toDelete, NULL, 0, 0);
     ds_sll_t *linkedList = *linkedList_toDelete;
 
     if(linkedList == NULL) {
@@ -421,6 +404,7 @@ ds_sll_error_t ds_sll_destroySinglyLinkedList(ds_sll_t **linkedList_toDelete)
  */
 void ds_sll_appendNode(ds_sll_t* linkedList, ds_sll_node_t* node)
 {
+    DS_SLL_TRACE(DS_SLL_TRACE_APPEND, linkedList, NULL, 0, 0);
     ASSERT(linkedList != NULL);
     if(linkedList->head == NULL) { // first element in the list
         linkedList->head = node;
@@ -444,6 +428,7 @@ void ds_sll_appendNode(ds_sll_t* linkedList, ds_sll_node_t* node)
  */
 ds_sll_error_t ds_sll_appendElement(ds_sll_t* linkedList, void* element)
 {
+    DS_SLL_TRACE(DS_SLL_TRACE_APPEND, linkedList, NULL, 0, 0);
     ASSERT(linkedList != NULL);
     ds_sll_node_t* new_node = ds_sll_createNode(element);
 
@@ -466,6 +451,7 @@ ds_sll_error_t ds_sll_appendElement(ds_sll_t* linkedList, void* element)
  */
 ds_sll_error_t ds_sll_appendElementCopy(ds_sll_t* linkedList, void* element, const size_t element_size)
 {
+    DS_SLL_TRACE(DS_SLL_TRACE_APPEND, linkedList, NULL, 0, element_size);
     ASSERT(linkedList != NULL);
     void* copy = ds_sll_copyElement(element, element_size);
 
@@ -489,6 +475,7 @@ ds_sll_error_t ds_sll_appendElementCopy(ds_sll_t* linkedList, void* element, con
  */
 ds_sll_error_t ds_sll_insertNodeAtIndex(ds_sll_t* linkedList, ds_sll_node_t* node, int index)
 {
+    DS_SLL_TRACE(DS_SLL_TRACE_INSERT_AT_INDEX, linkedList, NULL, index, 0);
     ASSERT((linkedList != NULL) && (index >= 0));
 
     if(index == 0) {
@@ -540,6 +527,7 @@ ds_sll_error_t ds_sll_insertNodeAtIndex(ds_sll_t* linkedList, ds_sll_node_t* nod
  */
 ds_sll_error_t ds_sll_insertElementAtIndex(ds_sll_t* linkedList, void* element, int index)
 {
+    DS_SLL_TRACE(DS_SLL_TRACE_INSERT_AT_INDEX, linkedList, NULL, index, 0);
     ASSERT((linkedList != NULL) && (index >= 0));
     ds_sll_node_t* new_node = ds_sll_createNode(element);
 
@@ -562,6 +550,7 @@ ds_sll_error_t ds_sll_insertElementAtIndex(ds_sll_t* linkedList, void* element,
  */
 ds_sll_error_t ds_sll_insertElementCopyAtIndex(ds_sll_t* linkedList, void* element, const size_t element_size, int index)
 {
+    DS_SLL_TRACE(DS_SLL_TRACE_INSERT_AT_INDEX, linkedList, NULL, index, element_size);
     ASSERT((linkedList != NULL) && (index >= 0));
     void* copy = ds_sll_copyElement(element, element_size);
 
@@ -573,6 +562,355 @@ ds_sll_error_t ds_sll_insertElementCopyAtIndex(ds_sll_t* linkedList, void* eleme
 }
 
 
+/**
+ * @brief Insert the given node right after another node of the list, in constant time
+ * @param linkedList The singly linked list to insert the node into
+ * @param prev The node of the list to insert after, or NULL to insert the node as the new head
+ * @param node The node to insert
+ *
+ * Unlike @ref ds_sll_insertNodeAtIndex this does not traverse the list,
+ * it is meant to be used with a node handle obtained from an earlier search or traversal.
+ */
+void ds_sll_insertNodeAfter(ds_sll_t* linkedList, ds_sll_node_t* prev, ds_sll_node_t* node)
+{
+    DS_SLL_TRACE(DS_SLL_TRACE_INSERT_AFTER, linkedList, NULL, (prev == NULL) ? 0 : -1, 0);
+    ASSERT((linkedList != NULL) && (node != NULL));
+
+    if(prev == NULL) { // new head
+        node->next = linkedList->head;
+        linkedList->head = node;
+        if(linkedList->tail == NULL) {
+            linkedList->tail = node;
+        }
+    }
+    else {
+        ASSERT(linkedList->tail != NULL);
+        node->next = ds_sll_nextNode(prev);
+        prev->next = node;
+        if(prev == linkedList->tail) {
+            linkedList->tail = node;
+        }
+    }
+}
+
+
+/**
+ * @brief Create a new node with the given element and insert it right after another node of the list, in constant time
+ * @param linkedList The singly linked list to insert the node into
+ * @param prev The node of the list to insert after, or NULL to insert the new node as the head
+ * @param element The element pointer you wish to store in the new node
+ * @return An error code indicating the completion status of the function
+ * @see ds_sll_insertNodeAfter
+ */
+ds_sll_error_t ds_sll_insertElementAfter(ds_sll_t* linkedList, ds_sll_node_t* prev, void* element)
+{
+    DS_SLL_TRACE(DS_SLL_TRACE_INSERT_AFTER, linkedList, NULL, (prev == NULL) ? 0 : -1, 0);
+    ASSERT(linkedList != NULL);
+    ds_sll_node_t* new_node = ds_sll_createNode(element);
+
+    if(new_node == NULL) {
+        return DS_SLL_NODE_CREATION_ERROR;
+    }
+
+    ds_sll_insertNodeAfter(linkedList, prev, new_node);
+    return DS_SLL_NO_ERROR;
+}
+
+
+/**
+ * @brief Unlink the node right after the given node from the list, in constant time, without deleting it
+ * @param linkedList The singly linked list to unlink the node from
+ * @param prev The node right before the node to unlink, or NULL to unlink the head
+ * @return The unlinked node (its next pointer is set to NULL), or NULL if there is no node after `prev`.
+ *         The caller becomes responsible for the returned node.
+ */
+ds_sll_node_t* ds_sll_unlinkNodeAfter(ds_sll_t* linkedList, ds_sll_node_t* prev)
+{
+    DS_SLL_TRACE(DS_SLL_TRACE_DELETE_AFTER, linkedList, NULL, (prev == NULL) ? 0 : -1, 0);
+    ASSERT(linkedList != NULL);
+
+    ds_sll_node_t* unlinked;
+
+    if(prev == NULL) { // unlink the head
+        unlinked = linkedList->head;
+        if(unlinked == NULL) {
+            return NULL;
+        }
+        if(unlinked == linkedList->tail) {
+            linkedList->head = NULL;
+            linkedList->tail = NULL;
+        } else {
+            linkedList->head = ds_sll_nextNode(unlinked);
+        }
+    }
+    else {
+        if(prev == linkedList->tail) {
+            return NULL;
+        }
+        unlinked = ds_sll_nextNode(prev);
+        if(unlinked == NULL) { // broken list
+            return NULL;
+        }
+        prev->next = ds_sll_nextNode(unlinked);
+        if(unlinked == linkedList->tail) {
+            linkedList->tail = prev;
+            prev->next = NULL;
+        }
+    }
+
+    unlinked->next = NULL;
+    return unlinked;
+}
+
+
+/**
+ * @brief Delete the node right after the given node, in constant time, and free allocated resources.
+ * @param linkedList The singly linked list to delete the node from
+ * @param prev The node right before the node to delete, or NULL to delete the head
+ * @return @ref ds_sll_error_t Error code. DS_SLL_INDEX_OUT_OF_BOUNDS_ERROR if there is no node after `prev`
+ */
+ds_sll_error_t ds_sll_deleteNodeAfter(ds_sll_t* linkedList, ds_sll_node_t* prev)
+{
+    DS_SLL_TRACE(DS_SLL_TRACE_DELETE_AFTER, linkedList, NULL, (prev == NULL) ? 0 : -1, 0);
+    ASSERT(linkedList != NULL);
+    ds_sll_node_t* todel = ds_sll_unlinkNodeAfter(linkedList, prev);
+
+    if(todel == NULL) {
+        return DS_SLL_INDEX_OUT_OF_BOUNDS_ERROR;
+    }
+
+    ds_sll_deleteNode(&todel);
+    return DS_SLL_NO_ERROR;
+}
+
+
+/**
+ * @brief Unlink the head of the list, in constant time, without deleting it
+ * @param linkedList The singly linked list to pop the head of
+ * @return The old head (its next pointer is set to NULL), or NULL if the list is empty.
+ *         The caller becomes responsible for the returned node.
+ */
+ds_sll_node_t* ds_sll_popHeadNode(ds_sll_t* linkedList)
+{
+    DS_SLL_TRACE(DS_SLL_TRACE_DELETE_AFTER, linkedList, NULL, 0, 0);
+    return ds_sll_unlinkNodeAfter(linkedList, NULL);
+}
+
+
+/**
+ * @brief Move all the nodes of one list right after a node of another list, in constant time
+ * @param linkedList The singly linked list receiving the nodes
+ * @param prev The node of `linkedList` to splice after, or NULL to splice at the front of the list
+ * @param source The singly linked list to move the nodes from. It is left empty (head and tail set to NULL)
+ *
+ * No node is copied or reallocated, only the links at both ends of the spliced chain are updated.
+ */
+void ds_sll_spliceAfter(ds_sll_t* linkedList, ds_sll_node_t* prev, ds_sll_t* source)
+{
+    DS_SLL_TRACE(DS_SLL_TRACE_SPLICE, linkedList, source, (prev == NULL) ? 0 : -1, 0);
+    ASSERT((linkedList != NULL) && (source != NULL) && (linkedList != source));
+
+    if(source->head == NULL) {
+        return;
+    }
+
+    if(prev == NULL) { // splice in front of the head
+        source->tail->next = linkedList->head;
+        linkedList->head = source->head;
+        if(linkedList->tail == NULL) {
+            linkedList->tail = source->tail;
+        }
+    }
+    else {
+        ASSERT(linkedList->tail != NULL);
+        source->tail->next = (prev == linkedList->tail) ? NULL : ds_sll_nextNode(prev);
+        prev->next = source->head;
+        if(prev == linkedList->tail) {
+            linkedList->tail = source->tail;
+        }
+    }
+
+    source->head = NULL;
+    source->tail = NULL;
+}
+
+
+/**
+ * @brief Append all the nodes of the second list to the end of the first list, in constant time
+ * @param firstLinkedList The singly linked list to append to
+ * @param secondLinkedList The singly linked list whose nodes are moved. It is left empty (head and tail set to NULL)
+ *
+ * The counterpart of @ref ds_sll_splitSinglyLinkedListAtIndex, uses the tail of the first list
+ * instead of traversing it.
+ */
+void ds_sll_concatenate(ds_sll_t* firstLinkedList, ds_sll_t* secondLinkedList)
+{
+    DS_SLL_TRACE(DS_SLL_TRACE_CONCATENATE, firstLinkedList, secondLinkedList, 0, 0);
+    ASSERT(firstLinkedList != NULL);
+    ds_sll_spliceAfter(firstLinkedList, firstLinkedList->tail, secondLinkedList);
+}
+
+
+/**
+ * @brief Insert the given node before the first node containing a larger element, in a single traversal
+ * @param linkedList The sorted singly linked list to insert the node into
+ * @param node The node to insert
+ * @param compareFunc A function returning a negative, zero, or positive value if its first element is
+ *        smaller than, equal to, or larger than its second element
+ *
+ * The list must already be sorted according to `compareFunc`. Equal elements keep their insertion order.
+ * Nodes that belong at the end of the list (eg: monotonically increasing keys) are appended in constant
+ * time using the tail, without traversing the list.
+ */
+void ds_sll_insertNodeSorted(ds_sll_t* linkedList, ds_sll_node_t* node, int (*compareFunc)(void*, void*))
+{
+    DS_SLL_TRACE(DS_SLL_TRACE_INSERT_SORTED, linkedList, NULL, 0, 0);
+    ASSERT((linkedList != NULL) && (node != NULL) && (compareFunc != NULL));
+
+    void* element = ds_sll_extractElementFromNode(node);
+
+    // empty list, or tail fast path
+    if((linkedList->head == NULL) || (compareFunc(ds_sll_extractElementFromNode(linkedList->tail), element) <= 0)) {
+        node->next = NULL;
+        ds_sll_appendNode(linkedList, node);
+        return;
+    }
+
+    ds_sll_node_t* prev = NULL;
+    ds_sll_node_t* curr = linkedList->head;
+
+    // the tail is larger than the element, so the traversal stops before running off the end
+    while(compareFunc(ds_sll_extractElementFromNode(curr), element) <= 0) {
+        prev = curr;
+        curr = ds_sll_nextNode(curr);
+    }
+
+    ds_sll_insertNodeAfter(linkedList, prev, node);
+}
+
+
+/**
+ * @brief Create a new node with the given element and insert it in sorted order
+ * @param linkedList The sorted singly linked list to insert into
+ * @param element The element pointer you wish to store in the node
+ * @param compareFunc The function the list is sorted by (see @ref ds_sll_insertNodeSorted)
+ * @return An error code indicating the completion status of the function
+ */
+ds_sll_error_t ds_sll_insertElementSorted(ds_sll_t* linkedList, void* element, int (*compareFunc)(void*, void*))
+{
+    DS_SLL_TRACE(DS_SLL_TRACE_INSERT_SORTED, linkedList, NULL, 0, 0);
+    ASSERT((linkedList != NULL) && (compareFunc != NULL));
+    ds_sll_node_t* new_node = ds_sll_createNode(element);
+
+    if(new_node == NULL) {
+        return DS_SLL_NODE_CREATION_ERROR;
+    }
+
+    ds_sll_insertNodeSorted(linkedList, new_node, compareFunc);
+    return DS_SLL_NO_ERROR;
+}
+
+
+/**
+ * @brief Create a new node with a copy of the given element and insert it in sorted order
+ * @param linkedList The sorted singly linked list to insert into
+ * @param element A pointer to the element that you wish to store a copy of in the new node
+ * @param element_size The size (in bytes) of the given element
+ * @param compareFunc The function the list is sorted by (see @ref ds_sll_insertNodeSorted)
+ * @return An error code indicating the completion status of the function
+ */
+ds_sll_error_t ds_sll_insertElementCopySorted(ds_sll_t* linkedList, void* element, const size_t element_size, int (*compareFunc)(void*, void*))
+{
+    DS_SLL_TRACE(DS_SLL_TRACE_INSERT_SORTED, linkedList, NULL, 0, element_size);
+    ASSERT((linkedList != NULL) && (compareFunc != NULL));
+    void* copy = ds_sll_copyElement(element, element_size);
+
+    if(copy == NULL) {
+        return DS_SLL_ELEMENT_CREATION_ERROR;
+    }
+
+    ds_sll_error_t status = ds_sll_insertElementSorted(linkedList, copy, compareFunc);
+    if(status != DS_SLL_NO_ERROR) {
+        ds_sll_deleteElement(&copy);
+    }
+    return status;
+}
+
+
+/**
+ * @brief Merge two sorted singly linked lists into the first one, in linear time and without reallocating any node
+ * @param firstLinkedList A sorted singly linked list, receives all the nodes of both lists in sorted order
+ * @param secondLinkedList A sorted singly linked list. It is left empty (head and tail set to NULL)
+ * @param compareFunc The function both lists are sorted by (see @ref ds_sll_insertNodeSorted)
+ *
+ * The merge is stable: of two equal elements, the one from the first list comes first.
+ * If the whole second list belongs after the first one, the lists are concatenated in constant time.
+ */
+void ds_sll_mergeSortedLists(ds_sll_t* firstLinkedList, ds_sll_t* secondLinkedList, int (*compareFunc)(void*, void*))
+{
+    DS_SLL_TRACE(DS_SLL_TRACE_MERGE, firstLinkedList, secondLinkedList, 0, 0);
+    ASSERT((firstLinkedList != NULL) && (secondLinkedList != NULL) && (firstLinkedList != secondLinkedList) && (compareFunc != NULL));
+
+    if((firstLinkedList->head == NULL) || (secondLinkedList->head == NULL)
+       || (compareFunc(ds_sll_extractElementFromNode(firstLinkedList->tail), ds_sll_extractElementFromNode(secondLinkedList->head)) <= 0)) {
+        ds_sll_concatenate(firstLinkedList, secondLinkedList);
+        return;
+    }
+
+    ds_sll_node_t merged; // placeholder in front of the merged chain
+    ds_sll_node_t* last = &merged;
+    ds_sll_node_t* a = firstLinkedList->head;
+    ds_sll_node_t* b = secondLinkedList->head;
+
+    while((a != NULL) && (b != NULL)) {
+        if(compareFunc(ds_sll_extractElementFromNode(b), ds_sll_extractElementFromNode(a)) < 0) {
+            last->next = b;
+            b = ds_sll_nextNode(b);
+        } else {
+            last->next = a;
+            a = ds_sll_nextNode(a);
+        }
+        last = ds_sll_nextNode(last);
+    }
+
+    // link the rest of the list that was not exhausted, its tail is the new tail
+    if(a != NULL) {
+        last->next = a;
+    } else {
+        last->next = b;
+        firstLinkedList->tail = secondLinkedList->tail;
+    }
+
+    firstLinkedList->head = merged.next;
+    secondLinkedList->head = NULL;
+    secondLinkedList->tail = NULL;
+}
+
+
+/**
+ * @brief Merge any number of sorted singly linked lists into the first one, without reallocating any node
+ * @param linkedLists Array of `count` sorted singly linked lists. The first one receives all the nodes in sorted order,
+ *        all others are left empty
+ * @param count The number of lists in the array
+ * @param compareFunc The function all lists are sorted by (see @ref ds_sll_insertNodeSorted)
+ *
+ * Lists are merged pairwise in rounds (1 with 2, 3 with 4, ... then 1 with 3, ...), which takes O(n log k) comparisons
+ * for a total of n nodes in k lists and needs no extra memory. The merge is stable with respect to the order of the lists.
+ */
+void ds_sll_mergeSortedListsK(ds_sll_t** linkedLists, int count, int (*compareFunc)(void*, void*))
+{
+    ASSERT((linkedLists != NULL) && (count >= 0) && (compareFunc != NULL));
+
+    int step, i;
+
+    for(step = 1; step < count; step *= 2) {
+        for(i = 0; i + step < count; i += 2 * step) {
+            ds_sll_mergeSortedLists(linkedLists[i], linkedLists[i + step], compareFunc);
+        }
+    }
+}
+
+
 /**
  * @brief Executes a function on each element in the linked list in order
  * @param linkedList The singly linked list to map the function to
@@ -594,6 +932,7 @@ ds_sll_error_t ds_sll_insertElementCopyAtIndex(ds_sll_t* linkedList, void* eleme
  */
 int ds_sll_executeFunctionOnElements(ds_sll_t* linkedList, ds_sll_func_return_t (*func)(void*, ds_sll_node_t*, int, void*), void *sharedData)
 {
+    DS_SLL_TRACE(DS_SLL_TRACE_EXECUTE, linkedList, NULL, 0, 0);
     ASSERT((linkedList != NULL) && (linkedList->head != NULL) && (linkedList->tail != NULL));
 
     int index;
@@ -627,6 +966,7 @@ int ds_sll_executeFunctionOnElements(ds_sll_t* linkedList, ds_sll_func_return_t
  */
 int ds_sll_calculateLength(const ds_sll_t* linkedList)
 {
+    DS_SLL_TRACE(DS_SLL_TRACE_LENGTH, linkedList, NULL, 0, 0);
     ASSERT((linkedList != NULL) && (linkedList->head != NULL) && (linkedList->tail != NULL));
 
     int index;
@@ -661,6 +1001,7 @@ int ds_sll_calculateLength(const ds_sll_t* linkedList)
  */
 ds_sll_error_t ds_sll_splitSinglyLinkedListAtIndex(ds_sll_t *firstLinkedList, ds_sll_t* secondLinkedList, int index)
 {
+    DS_SLL_TRACE(DS_SLL_TRACE_SPLIT, firstLinkedList, secondLinkedList, index, 0);
     ASSERT((firstLinkedList != NULL) && (firstLinkedList->head != NULL) && (firstLinkedList->tail != NULL) && (index >= 0));
 
     // check that the linked list is splittable
@@ -704,6 +1045,7 @@ ds_sll_error_t ds_sll_splitSinglyLinkedListAtIndex(ds_sll_t *firstLinkedList, ds
  */
  ds_sll_node_t* ds_sll_findNodeContainingElement(ds_sll_t* linkedList, void* element, int (*equalityFunc)(void*, void*), int *resultIndex)
 {
+    DS_SLL_TRACE(DS_SLL_TRACE_FIND, linkedList, NULL, (element == NULL) ? 1 : 0, 0);
     ASSERT((linkedList != NULL) && (linkedList->head != NULL) && (linkedList->tail != NULL));
 
     static void* searchTerm = NULL;
@@ -736,3 +1078,187 @@ ds_sll_error_t ds_sll_splitSinglyLinkedListAtIndex(ds_sll_t *firstLinkedList, ds
 
 }
 
+
+/**
+ * @brief An index to look up, along with its position in the caller's index array
+ */
+typedef struct ds_sll_lookup_query_t {
+    int index; /**< The index to look up */
+    int position; /**< Where the result goes in the caller's results array */
+} ds_sll_lookup_query_t;
+
+
+/**
+ * @brief Traversal state of one batch of @ref ds_sll_getElementsAtIndicesInterleaved
+ */
+typedef struct ds_sll_lookup_cursor_t {
+    ds_sll_batch_lookup_t* batch; /**< The batch being answered */
+    ds_sll_lookup_query_t* queries; /**< The batch's queries sorted by index */
+    int next_query; /**< First query not answered yet */
+    ds_sll_node_t* curr; /**< Current node of the traversal */
+    int curr_index; /**< Index of `curr` */
+} ds_sll_lookup_cursor_t;
+
+
+/**
+ * @brief qsort comparator ordering queries by index
+ */
+static int ds_sll_compareLookupQueries(const void* a, const void* b)
+{
+    int index_a = ((const ds_sll_lookup_query_t*) a)->index;
+    int index_b = ((const ds_sll_lookup_query_t*) b)->index;
+    return (index_a > index_b) - (index_a < index_b);
+}
+
+
+/**
+ * @brief Answer the queries of a cursor that target its current node, and move it to the next node
+ * @param cursor The cursor to step
+ * @return 1 if the cursor still has queries to answer, 0 if it is done
+ *
+ * The next node is prefetched so that its cache miss overlaps with the steps of the other cursors.
+ */
+static int ds_sll_stepLookupCursor(ds_sll_lookup_cursor_t* cursor)
+{
+    ds_sll_batch_lookup_t* batch = cursor->batch;
+
+    while((cursor->next_query < batch->count) && (cursor->queries[cursor->next_query].index == cursor->curr_index)) {
+        batch->results[cursor->queries[cursor->next_query].position] = ds_sll_extractElementFromNode(cursor->curr);
+        cursor->next_query++;
+    }
+
+    if(cursor->next_query == batch->count) {
+        return 0;
+    }
+
+    if(cursor->curr == batch->linkedList->tail) { // remaining indices are out of bounds
+        cursor->curr = NULL;
+        return 0;
+    }
+
+    cursor->curr = ds_sll_nextNode(cursor->curr);
+    cursor->curr_index++;
+    if(cursor->curr == NULL) { // broken list
+        return 0;
+    }
+
+    DS_SLL_PREFETCH(cursor->curr);
+    return 1;
+}
+
+
+/**
+ * @brief Retrieve the elements at many indices of a list in a single traversal
+ * @param linkedList The singly linked list to get the elements from
+ * @param indices The indices to look up, in any order (duplicates allowed)
+ * @param count The number of indices
+ * @param results Array of `count` pointers. results[i] is set to the element at indices[i],
+ *        or to NULL if that index is out of bounds
+ * @return @ref ds_sll_error_t Error code. DS_SLL_INDEX_OUT_OF_BOUNDS_ERROR if any of the indices was out of bounds
+ *
+ * Equivalent to calling @ref ds_sll_getElementAtIndex for each index, but the indices are sorted
+ * and answered in one forward traversal (O(n + count log count) instead of O(n * count)).
+ */
+ds_sll_error_t ds_sll_getElementsAtIndices(const ds_sll_t* linkedList, const int* indices, int count, void** results)
+{
+    DS_SLL_TRACE(DS_SLL_TRACE_BATCH_GET, linkedList, NULL, count, 0);
+    ds_sll_batch_lookup_t batch;
+
+    batch.linkedList = linkedList;
+    batch.indices = indices;
+    batch.count = count;
+    batch.results = results;
+
+    return ds_sll_getElementsAtIndicesInterleaved(&batch, 1);
+}
+
+
+/**
+ * @brief Answer batches of index lookups on several lists with interleaved traversals
+ * @param batches Array of `batchCount` batches, each naming a list, its indices, and where to store the results
+ * @param batchCount The number of batches
+ * @return @ref ds_sll_error_t Error code. DS_SLL_INDEX_OUT_OF_BOUNDS_ERROR if any of the indices was out of bounds
+ *
+ * Every batch is answered in a single forward traversal of its list (see @ref ds_sll_getElementsAtIndices).
+ * The traversals advance in lock step, one node of each list at a time, with the next node of each list prefetched,
+ * so that the cache misses of the different lists overlap instead of being paid one after the other.
+ */
+ds_sll_error_t ds_sll_getElementsAtIndicesInterleaved(ds_sll_batch_lookup_t* batches, int batchCount)
+{
+    ASSERT((batches != NULL) && (batchCount >= 0));
+
+    ds_sll_error_t status = DS_SLL_NO_ERROR;
+    int total = 0, b, i;
+
+    for(b = 0; b < batchCount; b++) {
+        ASSERT((batches[b].linkedList != NULL) && (batches[b].count >= 0));
+        ASSERT((batches[b].count == 0) || ((batches[b].indices != NULL) && (batches[b].results != NULL)));
+        DS_SLL_TRACE_RECORD(DS_SLL_TRACE_BATCH_GET, batches[b].linkedList, NULL, batches[b].count, 0);
+        total += batches[b].count;
+    }
+    DS_SLL_TRACE(DS_SLL_TRACE_NONE, NULL, NULL, 0, 0);
+
+    ds_sll_lookup_cursor_t* cursors = (ds_sll_lookup_cursor_t*) malloc(batchCount * sizeof(ds_sll_lookup_cursor_t) + total * sizeof(ds_sll_lookup_query_t) + 1);
+    if(cursors == NULL) {
+        return DS_SLL_MEMORY_ALLOCATION_ERROR;
+    }
+    ds_sll_lookup_query_t* queries = (ds_sll_lookup_query_t*) (cursors + batchCount);
+
+    // sort each batch's indices, and start its cursor at the head
+    int active = 0;
+    for(b = 0; b < batchCount; b++) {
+        ds_sll_batch_lookup_t* batch = &batches[b];
+        int sorted = 1;
+
+        for(i = 0; i < batch->count; i++) {
+            queries[i].index = batch->indices[i];
+            queries[i].position = i;
+            batch->results[i] = NULL;
+            if((i > 0) && (queries[i].index < queries[i - 1].index)) {
+                sorted = 0;
+            }
+        }
+        if(!sorted) {
+            qsort(queries, batch->count, sizeof(ds_sll_lookup_query_t), ds_sll_compareLookupQueries);
+        }
+
+        ds_sll_lookup_cursor_t* cursor = &cursors[b];
+        cursor->batch = batch;
+        cursor->queries = queries;
+        cursor->next_query = 0;
+        cursor->curr = batch->linkedList->head;
+        cursor->curr_index = 0;
+        queries += batch->count;
+
+        // negative indices can never match
+        while((cursor->next_query < batch->count) && (cursor->queries[cursor->next_query].index < 0)) {
+            cursor->next_query++;
+        }
+
+        if((cursor->next_query < batch->count) && (cursor->curr != NULL)) {
+            cursors[active++] = *cursor; // keep the active cursors packed at the front
+        } else if(cursor->next_query < batch->count) {
+            status = DS_SLL_INDEX_OUT_OF_BOUNDS_ERROR; // empty list
+        }
+        if(cursor->next_query != 0) {
+            status = DS_SLL_INDEX_OUT_OF_BOUNDS_ERROR;
+        }
+    }
+
+    // advance all the traversals one node at a time
+    while(active > 0) {
+        for(i = 0; i < active; ) {
+            if(ds_sll_stepLookupCursor(&cursors[i])) {
+                i++;
+            } else {
+                if(cursors[i].next_query < cursors[i].batch->count) {
+                    status = DS_SLL_INDEX_OUT_OF_BOUNDS_ERROR;
+                }
+                cursors[i] = cursors[--active];
+            }
+        }
+    }
+
+    free(cursors);
+    return status;
+}
@@ -44,6 +44,11 @@ SOFTWARE.
  * @ref ds_sll_t
  * @ref ds_sll_node_t
  *
+ * Sorted lists: the comparator is passed to every sorted operation instead of being stored in the list,
+ * so that @ref ds_sll_t stays a plain head/tail pair. The list does not remember its order, so every
+ * ds_sll_insert*Sorted and ds_sll_mergeSortedLists* call on a list must use the same comparator:
+ * a call with a different one silently breaks the sorted invariant that the following calls rely on.
+ *
  **/
 
 /* Datatype definitions */
@@ -78,7 +83,11 @@ typedef enum ds_sll_error_t {
     DS_SLL_INDEX_OUT_OF_BOUNDS_ERROR, /**< The index is out of bounds */
     DS_SLL_BROKEN_LIST_ERROR, /**< Error traversing a singly linked list till the end (the list is broken) */
     DS_SLL_LIST_TOO_SMALL_ERROR, /**< The length of given singly linked list is too small */
-    DS_SLL_FUNCTION_EXECUTION_ERROR /**< A function that was being executed on a Singly Linked List returned an Error */
+    DS_SLL_FUNCTION_EXECUTION_ERROR, /**< A function that was being executed on a Singly Linked List returned an Error */
+    DS_SLL_MEMORY_ALLOCATION_ERROR, /**< Error allocating temporary memory needed by an operation */
+    DS_SLL_TRACE_ERROR, /**< Error recording a workload trace (see SinglyLinkedListTrace.h) */
+    DS_SLL_TIMEOUT_ERROR, /**< A blocking operation timed out (see SinglyLinkedListQueue.h) */
+    DS_SLL_QUEUE_CLOSED_ERROR /**< The queue was closed (see SinglyLinkedListQueue.h) */
 } ds_sll_error_t;
 
 /**
@@ -90,6 +99,60 @@ typedef enum ds_sll_func_return_t {
     DS_SLL_STOP_EXECUTION, /**< Function has completed it's goal. Stop execution */
     DS_SLL_EXECUTION_ERROR /**< Function encountered an Error */
 } ds_sll_func_return_t;
+
+/**
+ * One batch of index lookups on one singly linked list.
+ * @see ds_sll_getElementsAtIndicesInterleaved
+ */
+typedef struct ds_sll_batch_lookup_t {
+    const ds_sll_t* linkedList; /**< The list to look the indices up in */
+    const int* indices; /**< The indices to look up, in any order (duplicates allowed) */
+    int count; /**< Number of indices */
+    void** results; /**< Output: results[i] is set to the element at indices[i], or NULL if out of bounds */
+} ds_sll_batch_lookup_t;
+/* ------------------------------------------------------------------ */
+
+
+/* Inline Node Operations */
+/* These are defined in the header so that callers in other translation units can inline them,
+ * they are executed once per node by every traversal. */
+/**
+ * @brief Extract the element contained in the given node
+ * @param node The node that contains the element you wish to extract
+ * @return The element contained within the given node (void *)
+ */
+static inline void* ds_sll_extractElementFromNode(ds_sll_node_t* node)
+{
+    return node->element;
+}
+
+
+/**
+ * @brief Encapsulate an element within a given node
+ * @param node The node to store the element in
+ * @param element The element to store in the node
+ * The reason that I have abstracted this function is to allow the programmer to change the way data is being
+ * stored and extracted within nodes. Note that at the moment of this writing, the nodes store void pointers. Though
+ * you may use those pointers as a gate to more complex operations as you see fit.
+ */
+static inline void ds_sll_storeElementInNode(ds_sll_node_t* node, void* element)
+{
+    node->element = element;
+}
+
+
+/**
+ * @brief Inline function that returns the next node in the given list
+ * @param node The node to extract the 'next node' from
+ * @return The next node located right after the given node
+ *
+ * The point of this function is to abstract the node->next operation
+ * allowing the developer to easily customize the way linked lists are traversed
+ */
+static inline ds_sll_node_t* ds_sll_nextNode(ds_sll_node_t* node)
+{
+    return node->next;
+}
 /* ------------------------------------------------------------------ */
 
 
@@ -101,9 +164,6 @@ ds_sll_error_t ds_sll_destroySinglyLinkedList(ds_sll_t **linkedList_toDelete);
 void ds_sll_deleteNode(ds_sll_node_t** node);
 ds_sll_error_t ds_sll_deleteNodeAtIndex(ds_sll_t* linkedList, int index);
 // Operations on Node
-ds_sll_node_t* ds_sll_nextNode(ds_sll_node_t* node);
-void* ds_sll_extractElementFromNode(ds_sll_node_t* node);
-void ds_sll_storeElementInNode(ds_sll_node_t* node, void* element);
 void ds_sll_deleteElement(void** element);
 void* ds_sll_copyElement(void* element, const size_t element_size);
 // Operations on List
@@ -114,6 +174,8 @@ ds_sll_error_t ds_sll_splitSinglyLinkedListAtIndex(ds_sll_t *firstLinkedList, ds
 ds_sll_node_t* ds_sll_getNodeAtIndex(const ds_sll_t* linkedList, int index);
 void* ds_sll_getElementAtIndex(const ds_sll_t* linkedList, int index);
 ds_sll_node_t* ds_sll_findNodeContainingElement(ds_sll_t* linkedList, void* element, int (*equalityFunc)(void*, void*), int *resultIndex);
+ds_sll_error_t ds_sll_getElementsAtIndices(const ds_sll_t* linkedList, const int* indices, int count, void** results);
+ds_sll_error_t ds_sll_getElementsAtIndicesInterleaved(ds_sll_batch_lookup_t* batches, int batchCount);
 // Append
 void ds_sll_appendNode(ds_sll_t* linkedList, ds_sll_node_t* node);
 ds_sll_error_t ds_sll_appendElement(ds_sll_t* linkedList, void* element);
@@ -122,6 +184,20 @@ ds_sll_error_t ds_sll_appendElementCopy(ds_sll_t* linkedList, void* element, con
 ds_sll_error_t ds_sll_insertNodeAtIndex(ds_sll_t* linkedList, ds_sll_node_t* node, int index);
 ds_sll_error_t ds_sll_insertElementAtIndex(ds_sll_t* linkedList, void* element, int index);
 ds_sll_error_t ds_sll_insertElementCopyAtIndex(ds_sll_t* linkedList, void* element, const size_t element_size, int index);
+// Node Handle Operations (constant time)
+void ds_sll_insertNodeAfter(ds_sll_t* linkedList, ds_sll_node_t* prev, ds_sll_node_t* node);
+ds_sll_error_t ds_sll_insertElementAfter(ds_sll_t* linkedList, ds_sll_node_t* prev, void* element);
+ds_sll_node_t* ds_sll_unlinkNodeAfter(ds_sll_t* linkedList, ds_sll_node_t* prev);
+ds_sll_error_t ds_sll_deleteNodeAfter(ds_sll_t* linkedList, ds_sll_node_t* prev);
+ds_sll_node_t* ds_sll_popHeadNode(ds_sll_t* linkedList);
+void ds_sll_spliceAfter(ds_sll_t* linkedList, ds_sll_node_t* prev, ds_sll_t* source);
+void ds_sll_concatenate(ds_sll_t* firstLinkedList, ds_sll_t* secondLinkedList);
+// Sorted Lists (always use the same comparator on a given list)
+void ds_sll_insertNodeSorted(ds_sll_t* linkedList, ds_sll_node_t* node, int (*compareFunc)(void*, void*));
+ds_sll_error_t ds_sll_insertElementSorted(ds_sll_t* linkedList, void* element, int (*compareFunc)(void*, void*));
+ds_sll_error_t ds_sll_insertElementCopySorted(ds_sll_t* linkedList, void* element, const size_t element_size, int (*compareFunc)(void*, void*));
+void ds_sll_mergeSortedLists(ds_sll_t* firstLinkedList, ds_sll_t* secondLinkedList, int (*compareFunc)(void*, void*));
+void ds_sll_mergeSortedListsK(ds_sll_t** linkedLists, int count, int (*compareFunc)(void*, void*));
 // Helper Functions
 ds_sll_error_t ds_sll_traverseNodeToIndex(const ds_sll_t* linkedList, ds_sll_node_t** node, int index);
 /* ------------------------------------------------------------------ */
@@ -0,0 +1,547 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2017 Ronny Majani
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+/**
+ * @ingroup singlylinkedlist
+ * @file SinglyLinkedListEpoch.c
+ * @brief Read-mostly Singly Linked List with lock-free readers and quiescent-state reclamation (ds_sll)
+ *
+ * Category: Data Structures >> Linked Lists
+ * Codename: ds_sll
+ *
+ * ### Usage:
+ * Every thread that reads the list registers itself once with @ref ds_sll_epochRegisterReader,
+ * traverses the list with @ref ds_sll_epochHead / @ref ds_sll_epochNextNode (or @ref ds_sll_epochExecuteFunctionOnElements),
+ * and calls @ref ds_sll_epochQuiescentState whenever it holds no reference to any node of the list
+ * (eg: between two requests). A reader that is about to block for a long time should go offline with
+ * @ref ds_sll_epochThreadOffline so that it does not hold back reclamation.
+ *
+ * Writers call the ds_sll_epoch* insert and delete functions from any thread, they are serialized by a mutex.
+ *
+ * ### Reclamation:
+ * A deleted node is unlinked immediately but its `next` pointer is left intact, so readers standing on it
+ * can keep traversing. The node is stamped with a new global epoch and freed (along with its element)
+ * once every online reader has reported a quiescent state at that epoch or later.
+ * Read-side critical sections therefore cost nothing: no locks, no atomic read-modify-write, and no fences.
+ *
+ * ###Note:
+ * Readers must never call @ref ds_sll_epochSynchronize while online, it would wait for themselves.
+ **/
+
+#include "SinglyLinkedListEpoch.h"
+#include "SinglyLinkedListTrace.h"
+#include <assert.h>
+#include <sched.h>
+
+/**
+ * @brief Macro definition for ASSERT
+ * Used to enforce Design by Contract coding
+ * Typically disabled on release
+ */
+#define ASSERT assert
+
+
+/**
+ * @brief Create a new read-mostly singly linked list
+ * @return Returns a pointer to a new list, or NULL if an error occurred
+ */
+ds_sll_epoch_list_t* ds_sll_newEpochList()
+{
+    ds_sll_epoch_list_t* new_list = (ds_sll_epoch_list_t*) malloc(sizeof(ds_sll_epoch_list_t));
+
+    if(new_list == NULL) {
+        return NULL;
+    }
+
+    if(pthread_mutex_init(&new_list->writer_lock, NULL) != 0) {
+        free(new_list);
+        return NULL;
+    }
+
+    new_list->list.head = NULL;
+    new_list->list.tail = NULL;
+    new_list->epoch = 1;
+    new_list->readers = NULL;
+    new_list->retired = NULL;
+    new_list->retired_count = 0;
+
+    return new_list;
+}
+
+
+/**
+ * @brief Destroy a read-mostly singly linked list
+ * @param epochList_toDelete A pointer to the list to destroy
+ * @return @ref ds_sll_error_t Error code representing the status of the function
+ *
+ * Deletes all the nodes (including the ones waiting to be reclaimed), frees all resources,
+ * and sets the given pointer to NULL. All readers must have been unregistered.
+ */
+ds_sll_error_t ds_sll_destroyEpochList(ds_sll_epoch_list_t** epochList_toDelete)
+{
+    ds_sll_epoch_list_t* epochList = *epochList_toDelete;
+
+    if(epochList == NULL) {
+        return DS_SLL_NO_ERROR;
+    }
+
+    ASSERT(epochList->readers == NULL);
+
+    while(epochList->retired != NULL) {
+        ds_sll_epoch_retired_t* retired = epochList->retired;
+        epochList->retired = retired->next;
+        ds_sll_deleteNode(&retired->node);
+        free(retired);
+    }
+
+    while(epochList->list.head != NULL) {
+        ds_sll_node_t* todel = epochList->list.head;
+        epochList->list.head = ds_sll_nextNode(todel);
+        ds_sll_deleteNode(&todel);
+    }
+
+    pthread_mutex_destroy(&epochList->writer_lock);
+    free(epochList);
+    *epochList_toDelete = NULL;
+    return DS_SLL_NO_ERROR;
+}
+/* ------------------------------------------------------------------ */
+
+
+/* Readers */
+/**
+ * @brief Register the calling thread as a reader of the list
+ * @param epochList The list to read
+ * @return A reader handle (online), or NULL if an error occurred
+ */
+ds_sll_epoch_reader_t* ds_sll_epochRegisterReader(ds_sll_epoch_list_t* epochList)
+{
+    ASSERT(epochList != NULL);
+    ds_sll_epoch_reader_t* reader = (ds_sll_epoch_reader_t*) malloc(sizeof(ds_sll_epoch_reader_t));
+
+    if(reader == NULL) {
+        return NULL;
+    }
+
+    reader->epoch = 0;
+    pthread_mutex_lock(&epochList->writer_lock);
+    reader->next = epochList->readers;
+    epochList->readers = reader;
+    pthread_mutex_unlock(&epochList->writer_lock);
+
+    ds_sll_epochThreadOnline(epochList, reader);
+    return reader;
+}
+
+
+/**
+ * @brief Unregister a reader, free its resources, and set the reader pointer to NULL
+ * @param epochList The list the reader was registered with
+ * @param reader Pointer to the reader handle to unregister
+ */
+void ds_sll_epochUnregisterReader(ds_sll_epoch_list_t* epochList, ds_sll_epoch_reader_t** reader)
+{
+    ASSERT((epochList != NULL) && (reader != NULL) && (*reader != NULL));
+
+    pthread_mutex_lock(&epochList->writer_lock);
+    ds_sll_epoch_reader_t** link = &epochList->readers;
+    while((*link != NULL) && (*link != *reader)) {
+        link = &(*link)->next;
+    }
+    ASSERT(*link == *reader); // reader was registered with this list
+    *link = (*reader)->next;
+    pthread_mutex_unlock(&epochList->writer_lock);
+
+    free(*reader);
+    *reader = NULL;
+}
+
+
+/**
+ * @brief Report that the calling reader holds no reference to any node of the list
+ * @param epochList The list being read
+ * @param reader The reader handle of the calling thread
+ *
+ * Nodes unlinked before this call can be freed once every other reader has done the same.
+ * Costs one load and one store, call it as often as convenient (eg: after each lookup or request).
+ */
+void ds_sll_epochQuiescentState(ds_sll_epoch_list_t* epochList, ds_sll_epoch_reader_t* reader)
+{
+    unsigned long epoch = __atomic_load_n(&epochList->epoch, __ATOMIC_ACQUIRE);
+    __atomic_store_n(&reader->epoch, epoch, __ATOMIC_RELEASE);
+}
+
+
+/**
+ * @brief Take the calling reader offline, it will not hold back reclamation until it comes back online
+ * @param reader The reader handle of the calling thread
+ *
+ * The reader must not hold any reference to a node of the list while offline.
+ */
+void ds_sll_epochThreadOffline(ds_sll_epoch_reader_t* reader)
+{
+    __atomic_store_n(&reader->epoch, 0, __ATOMIC_RELEASE);
+}
+
+
+/**
+ * @brief Bring the calling reader back online before it reads the list again
+ * @param epochList The list being read
+ * @param reader The reader handle of the calling thread
+ */
+void ds_sll_epochThreadOnline(ds_sll_epoch_list_t* epochList, ds_sll_epoch_reader_t* reader)
+{
+    // a full barrier (exchange): the writer must either see this reader online, or this reader must see the writer's unlinks
+    __atomic_exchange_n(&reader->epoch, __atomic_load_n(&epochList->epoch, __ATOMIC_ACQUIRE), __ATOMIC_SEQ_CST);
+}
+
+
+/**
+ * @brief Executes a function on each element of the list in order, from a reader thread
+ * @param epochList The list to map the function to
+ * @param func A function to execute on each element (see @ref ds_sll_executeFunctionOnElements)
+ * @param sharedData A pointer that is passed to your function
+ * @return -1 if no error occurred; the index of the node where the error occurred at otherwise.
+ *
+ * The calling thread must be a registered reader that is online.
+ * Nodes inserted or deleted by writers during the traversal may or may not be visited.
+ */
+int ds_sll_epochExecuteFunctionOnElements(ds_sll_epoch_list_t* epochList, ds_sll_func_return_t (*func)(void*, ds_sll_node_t*, int, void*), void *sharedData)
+{
+    ASSERT((epochList != NULL) && (func != NULL));
+
+    int index = 0;
+    ds_sll_node_t* curr;
+
+    for(curr = ds_sll_epochHead(epochList); curr != NULL; curr = ds_sll_epochNextNode(curr), index++) {
+        ds_sll_func_return_t returncode = func(ds_sll_extractElementFromNode(curr), curr, index, sharedData);
+        if(returncode == DS_SLL_EXECUTION_ERROR) {
+            return index;
+        } else if(returncode == DS_SLL_STOP_EXECUTION) {
+            return -1;
+        }
+    }
+
+    return -1;
+}
+/* ------------------------------------------------------------------ */
+
+
+/* Reclamation */
+/**
+ * @brief Get the oldest epoch observed by the online readers (writer_lock must be held)
+ * @param epochList The list being read
+ * @return The smallest epoch reported by an online reader, or ULONG_MAX if no reader is online
+ */
+static unsigned long ds_sll_epochOldestReader(ds_sll_epoch_list_t* epochList)
+{
+    unsigned long oldest = (unsigned long) -1;
+    ds_sll_epoch_reader_t* reader;
+
+    for(reader = epochList->readers; reader != NULL; reader = reader->next) {
+        unsigned long epoch = __atomic_load_n(&reader->epoch, __ATOMIC_SEQ_CST);
+        if((epoch != 0) && (epoch < oldest)) {
+            oldest = epoch;
+        }
+    }
+
+    return oldest;
+}
+
+
+/**
+ * @brief Free the retired nodes that no reader can reach anymore (writer_lock must be held)
+ * @param epochList The list to reclaim nodes of
+ * @return The number of nodes freed
+ */
+static int ds_sll_epochReclaimLocked(ds_sll_epoch_list_t* epochList)
+{
+    unsigned long oldest = ds_sll_epochOldestReader(epochList);
+    ds_sll_epoch_retired_t** link = &epochList->retired;
+    int freed = 0;
+
+    while(*link != NULL) {
+        ds_sll_epoch_retired_t* retired = *link;
+        if(retired->epoch <= oldest) {
+            *link = retired->next;
+            ds_sll_deleteNode(&retired->node);
+            free(retired);
+            freed++;
+        } else {
+            link = &retired->next;
+        }
+    }
+
+    epochList->retired_count -= freed;
+    return freed;
+}
+
+
+/**
+ * @brief Hand an unlinked node over to the reclamation scheme (writer_lock must be held)
+ * @param epochList The list the node was unlinked from
+ * @param node The unlinked node. Its next pointer must still point into the list
+ * @param retired A record allocated before taking writer_lock, so that retiring a node never fails or waits
+ */
+static void ds_sll_epochRetireNode(ds_sll_epoch_list_t* epochList, ds_sll_node_t* node, ds_sll_epoch_retired_t* retired)
+{
+    retired->node = node;
+    retired->epoch = __atomic_add_fetch(&epochList->epoch, 1, __ATOMIC_SEQ_CST);
+    retired->next = epochList->retired;
+    epochList->retired = retired;
+    epochList->retired_count++;
+
+    ds_sll_epochReclaimLocked(epochList);
+}
+
+
+/**
+ * @brief Free the retired nodes that no reader can reach anymore
+ * @param epochList The list to reclaim nodes of
+ * @return The number of nodes freed
+ *
+ * Writers already reclaim after every delete, this is useful to release memory once the readers
+ * have caught up without waiting for the next delete.
+ */
+int ds_sll_epochReclaim(ds_sll_epoch_list_t* epochList)
+{
+    ASSERT(epochList != NULL);
+    pthread_mutex_lock(&epochList->writer_lock);
+    int freed = ds_sll_epochReclaimLocked(epochList);
+    pthread_mutex_unlock(&epochList->writer_lock);
+    return freed;
+}
+
+
+/**
+ * @brief Wait until every node retired so far has been freed
+ * @param epochList The list to reclaim nodes of
+ *
+ * Blocks until every online reader has reported a quiescent state. Must not be called by an online reader.
+ */
+void ds_sll_epochSynchronize(ds_sll_epoch_list_t* epochList)
+{
+    ASSERT(epochList != NULL);
+
+    for(;;) {
+        pthread_mutex_lock(&epochList->writer_lock);
+        ds_sll_epochReclaimLocked(epochList);
+        int remaining = epochList->retired_count;
+        pthread_mutex_unlock(&epochList->writer_lock);
+
+        if(remaining == 0) {
+            return;
+        }
+        sched_yield();
+    }
+}
+/* ------------------------------------------------------------------ */
+
+
+/* Writers */
+/**
+ * @brief Publish a new node right after `prev` (writer_lock must be held)
+ * @param epochList The list to insert into
+ * @param prev The node to insert after, or NULL to insert at the head
+ * @param node The new node
+ *
+ * The node is fully initialized before the release store that makes it reachable.
+ */
+static void ds_sll_epochPublishNodeAfter(ds_sll_epoch_list_t* epochList, ds_sll_node_t* prev, ds_sll_node_t* node)
+{
+    if(prev == NULL) {
+        node->next = epochList->list.head;
+        __atomic_store_n(&epochList->list.head, node, __ATOMIC_RELEASE);
+        if(epochList->list.tail == NULL) {
+            epochList->list.tail = node;
+        }
+    } else {
+        node->next = ds_sll_nextNode(prev);
+        __atomic_store_n(&prev->next, node, __ATOMIC_RELEASE);
+        if(prev == epochList->list.tail) {
+            epochList->list.tail = node;
+        }
+    }
+}
+
+
+/**
+ * @brief Unlink the node right after `prev` and retire it (writer_lock must be held)
+ * @param epochList The list to delete from
+ * @param prev The node before the node to delete, or NULL to delete the head
+ * @param retired A preallocated record for @ref ds_sll_epochRetireNode
+ */
+static void ds_sll_epochUnlinkNodeAfter(ds_sll_epoch_list_t* epochList, ds_sll_node_t* prev, ds_sll_epoch_retired_t* retired)
+{
+    ds_sll_node_t* todel = (prev == NULL) ? epochList->list.head : ds_sll_nextNode(prev);
+
+    // todel->next is left untouched so that readers standing on it can keep going
+    if(prev == NULL) {
+        __atomic_store_n(&epochList->list.head, ds_sll_nextNode(todel), __ATOMIC_RELEASE);
+    } else {
+        __atomic_store_n(&prev->next, ds_sll_nextNode(todel), __ATOMIC_RELEASE);
+    }
+
+    if(todel == epochList->list.tail) {
+        epochList->list.tail = prev;
+    }
+
+    ds_sll_epochRetireNode(epochList, todel, retired);
+}
+
+
+/**
+ * @brief Create a new node with the given element and append it to the end of the list
+ * @param epochList The list to append to
+ * @param element The element to store in the new node
+ * @return @ref ds_sll_error_t Error code representing the status of the function
+ */
+ds_sll_error_t ds_sll_epochAppendElement(ds_sll_epoch_list_t* epochList, void* element)
+{
+    ASSERT(epochList != NULL);
+    ds_sll_node_t* new_node = ds_sll_createNode(element);
+
+    if(new_node == NULL) {
+        return DS_SLL_NODE_CREATION_ERROR;
+    }
+
+    pthread_mutex_lock(&epochList->writer_lock);
+    ds_sll_epochPublishNodeAfter(epochList, epochList->list.tail, new_node);
+    pthread_mutex_unlock(&epochList->writer_lock);
+    return DS_SLL_NO_ERROR;
+}
+
+
+/**
+ * @brief Create a new node with the given element and insert it at the chosen index
+ * @param epochList The list to insert into
+ * @param element The element to store in the new node
+ * @param index The index where the node should be inserted (0 up to the length of the list)
+ * @return @ref ds_sll_error_t Error code representing the status of the function
+ */
+ds_sll_error_t ds_sll_epochInsertElementAtIndex(ds_sll_epoch_list_t* epochList, void* element, int index)
+{
+    ASSERT((epochList != NULL) && (index >= 0));
+    // the embedded list is an implementation detail, keep the core calls on it out of the trace
+    DS_SLL_TRACE(DS_SLL_TRACE_NONE, NULL, NULL, 0, 0);
+    ds_sll_node_t* new_node = ds_sll_createNode(element);
+
+    if(new_node == NULL) {
+        return DS_SLL_NODE_CREATION_ERROR;
+    }
+
+    pthread_mutex_lock(&epochList->writer_lock);
+    ds_sll_node_t* prev = NULL;
+
+    if(index > 0) {
+        ds_sll_error_t traverseStatus = (epochList->list.head == NULL) ? DS_SLL_INDEX_OUT_OF_BOUNDS_ERROR
+                                        : ds_sll_traverseNodeToIndex(&epochList->list, &prev, index - 1);
+        if(traverseStatus != DS_SLL_NO_ERROR) {
+            pthread_mutex_unlock(&epochList->writer_lock);
+            ds_sll_deleteNode(&new_node);
+            return traverseStatus;
+        }
+    }
+
+    ds_sll_epochPublishNodeAfter(epochList, prev, new_node);
+    pthread_mutex_unlock(&epochList->writer_lock);
+    return DS_SLL_NO_ERROR;
+}
+
+
+/**
+ * @brief Delete the node at the given index. The node and its element are freed once no reader can reach them
+ * @param epochList The list to delete the node from
+ * @param index The index of the node to delete
+ * @return @ref ds_sll_error_t Error code representing the status of the function.
+ *         DS_SLL_MEMORY_ALLOCATION_ERROR if the node could not be queued for reclamation (the list is left untouched)
+ */
+ds_sll_error_t ds_sll_epochDeleteNodeAtIndex(ds_sll_epoch_list_t* epochList, int index)
+{
+    ASSERT((epochList != NULL) && (index >= 0));
+    DS_SLL_TRACE(DS_SLL_TRACE_NONE, NULL, NULL, 0, 0);
+    ds_sll_epoch_retired_t* retired = (ds_sll_epoch_retired_t*) malloc(sizeof(ds_sll_epoch_retired_t));
+
+    if(retired == NULL) {
+        return DS_SLL_MEMORY_ALLOCATION_ERROR;
+    }
+
+    pthread_mutex_lock(&epochList->writer_lock);
+    ds_sll_node_t* prev = NULL;
+    ds_sll_error_t status = DS_SLL_NO_ERROR;
+
+    if(epochList->list.head == NULL) {
+        status = DS_SLL_INDEX_OUT_OF_BOUNDS_ERROR;
+    }
+    else if(index > 0) {
+        status = ds_sll_traverseNodeToIndex(&epochList->list, &prev, index - 1);
+        if((status == DS_SLL_NO_ERROR) && (prev == epochList->list.tail)) {
+            status = DS_SLL_INDEX_OUT_OF_BOUNDS_ERROR;
+        }
+    }
+
+    if(status == DS_SLL_NO_ERROR) {
+        ds_sll_epochUnlinkNodeAfter(epochList, prev, retired);
+        retired = NULL;
+    }
+
+    pthread_mutex_unlock(&epochList->writer_lock);
+    free(retired);
+    return status;
+}
+
+
+/**
+ * @brief Delete the first node containing the given element. The node is freed once no reader can reach it
+ * @param epochList The list to delete the node from
+ * @param element The element to search for
+ * @param equalityFunc A function that compares two elements and returns 1 if equal and 0 if not equal.
+ * @return @ref ds_sll_error_t Error code. DS_SLL_INDEX_OUT_OF_BOUNDS_ERROR if no node contains the element,
+ *         DS_SLL_MEMORY_ALLOCATION_ERROR if the node could not be queued for reclamation (the list is left untouched)
+ */
+ds_sll_error_t ds_sll_epochDeleteNodeContainingElement(ds_sll_epoch_list_t* epochList, void* element, int (*equalityFunc)(void*, void*))
+{
+    ASSERT((epochList != NULL) && (equalityFunc != NULL));
+    ds_sll_epoch_retired_t* retired = (ds_sll_epoch_retired_t*) malloc(sizeof(ds_sll_epoch_retired_t));
+
+    if(retired == NULL) {
+        return DS_SLL_MEMORY_ALLOCATION_ERROR;
+    }
+
+    pthread_mutex_lock(&epochList->writer_lock);
+    ds_sll_node_t* prev = NULL;
+    ds_sll_node_t* curr;
+
+    for(curr = epochList->list.head; curr != NULL; prev = curr, curr = ds_sll_nextNode(curr)) {
+        if(equalityFunc(ds_sll_extractElementFromNode(curr), element) == 1) {
+            ds_sll_epochUnlinkNodeAfter(epochList, prev, retired);
+            pthread_mutex_unlock(&epochList->writer_lock);
+            return DS_SLL_NO_ERROR;
+        }
+    }
+
+    pthread_mutex_unlock(&epochList->writer_lock);
+    free(retired);
+    return DS_SLL_INDEX_OUT_OF_BOUNDS_ERROR;
+}
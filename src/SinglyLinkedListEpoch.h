@@ -0,0 +1,132 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2017 Ronny Majani
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#ifndef RM_DS_SLL_SINGLYLINKEDLISTEPOCH_H
+#define RM_DS_SLL_SINGLYLINKEDLISTEPOCH_H
+
+#include "SinglyLinkedList.h"
+#include <pthread.h>
+
+/**
+ * @ingroup singlylinkedlist
+ * @{
+ */
+
+/**
+ * @file SinglyLinkedListEpoch.h
+ * @brief Read-mostly Singly Linked List with lock-free readers and quiescent-state reclamation (Header) (ds_sll)
+ *
+ * Readers traverse the list without taking locks and without atomic read-modify-write operations.
+ * Writers are serialized by a mutex, publish their changes with release stores,
+ * and hand unlinked nodes to a quiescent-state based reclamation scheme that frees them
+ * once every registered reader has passed a quiescent state.
+ **/
+
+/* Datatype definitions */
+/**
+ * A registered reader thread.
+ * Each reader thread registers itself once and periodically reports quiescent states
+ */
+typedef struct ds_sll_epoch_reader_t {
+    unsigned long epoch; /**< Last epoch observed by the reader at a quiescent state, 0 while offline. Accessed atomically */
+    struct ds_sll_epoch_reader_t* next; /**< Next registered reader */
+} ds_sll_epoch_reader_t;
+
+/**
+ * A node that was unlinked by a writer and is waiting to be freed
+ */
+typedef struct ds_sll_epoch_retired_t {
+    ds_sll_node_t* node; /**< The unlinked node (and its element) */
+    unsigned long epoch; /**< The epoch every reader has to reach before the node can be freed */
+    struct ds_sll_epoch_retired_t* next; /**< Next retired node */
+} ds_sll_epoch_retired_t;
+
+/**
+ * Read-mostly Singly Linked List datatype
+ */
+typedef struct ds_sll_epoch_list_t {
+    ds_sll_t list; /**< The underlying list. `head` and every `next` are published with release stores */
+    pthread_mutex_t writer_lock; /**< Serializes writers, reader registration, and reclamation */
+    unsigned long epoch; /**< Global epoch, advanced every time a node is retired. Accessed atomically */
+    ds_sll_epoch_reader_t* readers; /**< Registered readers */
+    ds_sll_epoch_retired_t* retired; /**< Nodes waiting to be freed */
+    int retired_count; /**< Number of nodes waiting to be freed */
+} ds_sll_epoch_list_t;
+/* ------------------------------------------------------------------ */
+
+
+/* Inline Reader Operations */
+/**
+ * @brief Get the first node of the list from a reader thread
+ * @param epochList The list to read
+ * @return The head of the list, or NULL if it is empty
+ */
+static inline ds_sll_node_t* ds_sll_epochHead(ds_sll_epoch_list_t* epochList)
+{
+    return __atomic_load_n(&epochList->list.head, __ATOMIC_ACQUIRE);
+}
+
+
+/**
+ * @brief Get the node following the given node from a reader thread
+ * @param node The current node
+ * @return The next node, or NULL at the end of the list
+ *
+ * The acquire load pairs with the release store of the writer that published the next node,
+ * on x86 it compiles down to a plain load.
+ */
+static inline ds_sll_node_t* ds_sll_epochNextNode(ds_sll_node_t* node)
+{
+    return __atomic_load_n(&node->next, __ATOMIC_ACQUIRE);
+}
+/* ------------------------------------------------------------------ */
+
+
+/* Functions */
+// Create/Delete
+ds_sll_epoch_list_t* ds_sll_newEpochList();
+ds_sll_error_t ds_sll_destroyEpochList(ds_sll_epoch_list_t** epochList_toDelete);
+// Readers
+ds_sll_epoch_reader_t* ds_sll_epochRegisterReader(ds_sll_epoch_list_t* epochList);
+void ds_sll_epochUnregisterReader(ds_sll_epoch_list_t* epochList, ds_sll_epoch_reader_t** reader);
+void ds_sll_epochQuiescentState(ds_sll_epoch_list_t* epochList, ds_sll_epoch_reader_t* reader);
+void ds_sll_epochThreadOffline(ds_sll_epoch_reader_t* reader);
+void ds_sll_epochThreadOnline(ds_sll_epoch_list_t* epochList, ds_sll_epoch_reader_t* reader);
+int ds_sll_epochExecuteFunctionOnElements(ds_sll_epoch_list_t* epochList, ds_sll_func_return_t (*func)(void*, ds_sll_node_t*, int, void*), void *sharedData);
+// Writers
+ds_sll_error_t ds_sll_epochAppendElement(ds_sll_epoch_list_t* epochList, void* element);
+ds_sll_error_t ds_sll_epochInsertElementAtIndex(ds_sll_epoch_list_t* epochList, void* element, int index);
+ds_sll_error_t ds_sll_epochDeleteNodeAtIndex(ds_sll_epoch_list_t* epochList, int index);
+ds_sll_error_t ds_sll_epochDeleteNodeContainingElement(ds_sll_epoch_list_t* epochList, void* element, int (*equalityFunc)(void*, void*));
+// Reclamation
+int ds_sll_epochReclaim(ds_sll_epoch_list_t* epochList);
+void ds_sll_epochSynchronize(ds_sll_epoch_list_t* epochList);
+/* ------------------------------------------------------------------ */
+
+
+/**
+ * @}
+ */
+
+#endif //RM_DS_SLL_SINGLYLINKEDLISTEPOCH_H
@@ -0,0 +1,375 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2017 Ronny Majani
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+/**
+ * @ingroup singlylinkedlist
+ * @file SinglyLinkedListLazy.c
+ * @brief Singly Linked List with lazy deletion (tombstones) and batched compaction (ds_sll)
+ *
+ * Category: Data Structures >> Linked Lists
+ * Codename: ds_sll
+ *
+ * ### Usage:
+ * + Delete: mark the node as dead, its element is kept until the node is compacted away
+ * + Indices passed to and given by the operations count live nodes only
+ * + Compact: unlink and free every dead node (and its element) in a single pass
+ *
+ * ### Compaction:
+ * After every delete, the list is compacted if at least @ref DS_SLL_LAZY_MIN_COMPACTION nodes are dead
+ * and they make up the configured fraction of all the nodes. A compaction is never run while a traversal
+ * is in progress; the threshold is checked again when the outermost traversal completes.
+ **/
+
+#include "SinglyLinkedListLazy.h"
+#include "SinglyLinkedListTrace.h"
+#include <assert.h>
+
+/**
+ * @brief Macro definition for ASSERT
+ * Used to enforce Design by Contract coding
+ * Typically disabled on release
+ */
+#define ASSERT assert
+
+/**
+ * @brief Fraction of dead nodes that triggers a compaction when none is given
+ */
+#define DS_SLL_LAZY_DEFAULT_DEAD_FRACTION 0.25
+
+/**
+ * @brief Minimum number of dead nodes freed by an automatic compaction, so small lists are not compacted on every delete
+ */
+#define DS_SLL_LAZY_MIN_COMPACTION 64
+
+
+/**
+ * @brief Check whether a node of a lazy list was deleted
+ */
+static inline int ds_sll_lazyIsDead(ds_sll_node_t* node)
+{
+    return ((ds_sll_lazy_node_t*) node)->dead;
+}
+
+
+/**
+ * @brief Find the live node at the given index
+ * @param lazyList The lazy list to search
+ * @param index The index of the node among the live nodes
+ * @param prev Set to the node (live or dead) right before the found node, NULL if it is the head
+ * @return The node, or NULL if the index is out of bounds
+ */
+static ds_sll_node_t* ds_sll_lazyFindLiveNode(ds_sll_lazy_t* lazyList, int index, ds_sll_node_t** prev)
+{
+    ds_sll_node_t* node;
+
+    if((index < 0) || (index >= lazyList->live_count)) {
+        return NULL;
+    }
+
+    *prev = NULL;
+    for(node = lazyList->list.head; node != NULL; node = ds_sll_nextNode(node)) {
+        if(!ds_sll_lazyIsDead(node)) {
+            if(index == 0) {
+                return node;
+            }
+            index--;
+        }
+        *prev = node;
+    }
+
+    return NULL;
+}
+
+
+/**
+ * @brief Compact the list if enough of its nodes are dead and no traversal is in progress
+ */
+static void ds_sll_lazyMaybeCompact(ds_sll_lazy_t* lazyList)
+{
+    if((lazyList->traversals == 0) && (lazyList->dead_fraction < 1) && (lazyList->dead_count >= DS_SLL_LAZY_MIN_COMPACTION)
+       && (lazyList->dead_count >= lazyList->dead_fraction * (lazyList->live_count + lazyList->dead_count))) {
+        ds_sll_lazyCompact(lazyList);
+    }
+}
+
+
+/**
+ * @brief Create a new empty lazy list
+ * @param dead_fraction The fraction of dead nodes (between 0 and 1) that triggers a compaction,
+ *        0 for the default (0.25), 1 or more to only compact on request
+ * @return A pointer to the new lazy list, or NULL if an error occurred
+ */
+ds_sll_lazy_t* ds_sll_newLazyList(double dead_fraction)
+{
+    ASSERT(dead_fraction >= 0);
+    ds_sll_lazy_t* lazyList = (ds_sll_lazy_t*) malloc(sizeof(ds_sll_lazy_t));
+
+    if(lazyList == NULL) {
+        return NULL;
+    }
+
+    lazyList->list.head = NULL;
+    lazyList->list.tail = NULL;
+    lazyList->live_count = 0;
+    lazyList->dead_count = 0;
+    lazyList->dead_fraction = (dead_fraction == 0) ? DS_SLL_LAZY_DEFAULT_DEAD_FRACTION : dead_fraction;
+    lazyList->traversals = 0;
+    return lazyList;
+}
+
+
+/**
+ * @brief Destroy a lazy list
+ * @param lazyList_toDelete The lazy list to destroy
+ *
+ * Deletes all the nodes (live and dead) along with their elements, frees all resources,
+ * and sets the given pointer to NULL.
+ */
+void ds_sll_destroyLazyList(ds_sll_lazy_t** lazyList_toDelete)
+{
+    ASSERT(lazyList_toDelete != NULL);
+    ds_sll_lazy_t* lazyList = *lazyList_toDelete;
+
+    if(lazyList == NULL) {
+        return;
+    }
+
+    while(lazyList->list.head != NULL) {
+        ds_sll_node_t* todel = lazyList->list.head;
+        lazyList->list.head = ds_sll_nextNode(todel);
+        ds_sll_deleteNode(&todel);
+    }
+
+    free(lazyList);
+    *lazyList_toDelete = NULL;
+}
+
+
+/**
+ * @brief Append an element to the end of a lazy list
+ * @param lazyList The lazy list to append to
+ * @param element The element to append. It is owned by the list from now on
+ * @return @ref ds_sll_error_t Error Code.
+ */
+ds_sll_error_t ds_sll_lazyAppendElement(ds_sll_lazy_t* lazyList, void* element)
+{
+    ASSERT(lazyList != NULL);
+    // the embedded list is an implementation detail, keep the core calls on it out of the trace
+    DS_SLL_TRACE(DS_SLL_TRACE_NONE, NULL, NULL, 0, 0);
+    ds_sll_lazy_node_t* new_node = (ds_sll_lazy_node_t*) malloc(sizeof(ds_sll_lazy_node_t));
+
+    if(new_node == NULL) {
+        return DS_SLL_NODE_CREATION_ERROR;
+    }
+
+    ds_sll_storeElementInNode(&new_node->node, element);
+    new_node->node.next = NULL;
+    new_node->dead = 0;
+    ds_sll_appendNode(&lazyList->list, &new_node->node);
+    lazyList->live_count++;
+    return DS_SLL_NO_ERROR;
+}
+
+
+/**
+ * @brief Insert an element at the given index of a lazy list
+ * @param lazyList The lazy list to insert into
+ * @param element The element to insert. It is owned by the list from now on
+ * @param index The index among the live nodes where the element should be inserted (0 up to the length of the list)
+ * @return @ref ds_sll_error_t Error Code.
+ */
+ds_sll_error_t ds_sll_lazyInsertElementAtIndex(ds_sll_lazy_t* lazyList, void* element, int index)
+{
+    ASSERT(lazyList != NULL);
+    DS_SLL_TRACE(DS_SLL_TRACE_NONE, NULL, NULL, 0, 0);
+    ds_sll_lazy_node_t* new_node;
+    ds_sll_node_t* prev;
+
+    if(index == lazyList->live_count) {
+        return ds_sll_lazyAppendElement(lazyList, element);
+    }
+    if(ds_sll_lazyFindLiveNode(lazyList, index, &prev) == NULL) {
+        return DS_SLL_INDEX_OUT_OF_BOUNDS_ERROR;
+    }
+
+    new_node = (ds_sll_lazy_node_t*) malloc(sizeof(ds_sll_lazy_node_t));
+    if(new_node == NULL) {
+        return DS_SLL_NODE_CREATION_ERROR;
+    }
+
+    ds_sll_storeElementInNode(&new_node->node, element);
+    new_node->node.next = NULL;
+    new_node->dead = 0;
+    ds_sll_insertNodeAfter(&lazyList->list, prev, &new_node->node);
+    lazyList->live_count++;
+    return DS_SLL_NO_ERROR;
+}
+
+
+/**
+ * @brief Delete the live node at the given index by marking it as dead
+ * @param lazyList The lazy list to delete from
+ * @param index The index of the node among the live nodes
+ * @return @ref ds_sll_error_t Error Code.
+ *
+ * The node and its element are freed by a later compaction, which this call may trigger.
+ */
+ds_sll_error_t ds_sll_lazyDeleteNodeAtIndex(ds_sll_lazy_t* lazyList, int index)
+{
+    ASSERT(lazyList != NULL);
+    ds_sll_node_t* prev;
+    ds_sll_node_t* node = ds_sll_lazyFindLiveNode(lazyList, index, &prev);
+
+    if(node == NULL) {
+        return DS_SLL_INDEX_OUT_OF_BOUNDS_ERROR;
+    }
+
+    return ds_sll_lazyDeleteNode(lazyList, node);
+}
+
+
+/**
+ * @brief Delete a node of a lazy list by marking it as dead
+ * @param lazyList The lazy list the node belongs to
+ * @param node The node to delete (eg: the node given to the function run by @ref ds_sll_lazyExecuteFunctionOnElements)
+ * @return @ref ds_sll_error_t Error Code.
+ *
+ * Deleting a node that is already dead does nothing.
+ * The node and its element are freed by a later compaction, which this call may trigger (unless a traversal is in progress).
+ */
+ds_sll_error_t ds_sll_lazyDeleteNode(ds_sll_lazy_t* lazyList, ds_sll_node_t* node)
+{
+    ASSERT((lazyList != NULL) && (node != NULL));
+    ds_sll_lazy_node_t* lazy_node = (ds_sll_lazy_node_t*) node;
+
+    if(lazy_node->dead) {
+        return DS_SLL_NO_ERROR;
+    }
+
+    lazy_node->dead = 1;
+    lazyList->live_count--;
+    lazyList->dead_count++;
+    ds_sll_lazyMaybeCompact(lazyList);
+    return DS_SLL_NO_ERROR;
+}
+
+
+/**
+ * @brief Unlink and free every dead node (and its element) in a single pass
+ * @param lazyList The lazy list to compact
+ * @return The number of nodes freed (0 if a traversal is in progress, in which case nothing is freed)
+ */
+int ds_sll_lazyCompact(ds_sll_lazy_t* lazyList)
+{
+    ASSERT(lazyList != NULL);
+    DS_SLL_TRACE(DS_SLL_TRACE_NONE, NULL, NULL, 0, 0);
+    ds_sll_node_t* prev = NULL;
+    ds_sll_node_t* node = lazyList->list.head;
+    int freed = 0;
+
+    if((lazyList->traversals > 0) || (lazyList->dead_count == 0)) {
+        return 0;
+    }
+
+    while(node != NULL) {
+        ds_sll_node_t* next = ds_sll_nextNode(node);
+        if(ds_sll_lazyIsDead(node)) {
+            ds_sll_deleteNodeAfter(&lazyList->list, prev);
+            freed++;
+        } else {
+            prev = node;
+        }
+        node = next;
+    }
+
+    lazyList->dead_count = 0;
+    return freed;
+}
+
+
+/**
+ * @brief Get the element of the live node at the given index
+ * @param lazyList The lazy list
+ * @param index The index of the node among the live nodes
+ * @return The element, or NULL if the index is out of bounds
+ */
+void* ds_sll_lazyGetElementAtIndex(ds_sll_lazy_t* lazyList, int index)
+{
+    ASSERT(lazyList != NULL);
+    ds_sll_node_t* prev;
+    ds_sll_node_t* node = ds_sll_lazyFindLiveNode(lazyList, index, &prev);
+
+    return (node == NULL) ? NULL : ds_sll_extractElementFromNode(node);
+}
+
+
+/**
+ * @brief Execute a given function on every live element of a lazy list
+ * @param lazyList The lazy list
+ * @param func The function to execute (see @ref ds_sll_executeFunctionOnElements). It receives the index among the live nodes
+ *        and may delete nodes with @ref ds_sll_lazyDeleteNode or @ref ds_sll_lazyDeleteNodeAtIndex
+ * @param sharedData A pointer that is passed to your function
+ * @return -1 if no error occurred; the index of the node where the error occurred at otherwise.
+ *
+ * Dead nodes are skipped, including the ones deleted by the function itself.
+ * Compactions are postponed until the traversal completes.
+ */
+int ds_sll_lazyExecuteFunctionOnElements(ds_sll_lazy_t* lazyList, ds_sll_func_return_t (*func)(void*, ds_sll_node_t*, int, void*), void *sharedData)
+{
+    ASSERT((lazyList != NULL) && (func != NULL));
+    ds_sll_node_t* node;
+    int index = 0, result = -1;
+
+    lazyList->traversals++;
+    for(node = lazyList->list.head; node != NULL; node = ds_sll_nextNode(node)) {
+        if(ds_sll_lazyIsDead(node)) {
+            continue;
+        }
+
+        ds_sll_func_return_t returncode = func(ds_sll_extractElementFromNode(node), node, index, sharedData);
+        if(returncode == DS_SLL_EXECUTION_ERROR) {
+            result = index;
+            break;
+        } else if(returncode == DS_SLL_STOP_EXECUTION) {
+            break;
+        }
+        index++;
+    }
+    lazyList->traversals--;
+
+    ds_sll_lazyMaybeCompact(lazyList);
+    return result;
+}
+
+
+/**
+ * @brief Get the number of live nodes of a lazy list, in constant time
+ * @param lazyList The lazy list
+ * @return The number of live nodes
+ */
+int ds_sll_lazyCalculateLength(const ds_sll_lazy_t* lazyList)
+{
+    ASSERT(lazyList != NULL);
+    return lazyList->live_count;
+}
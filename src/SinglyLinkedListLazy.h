@@ -0,0 +1,92 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2017 Ronny Majani
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#ifndef RM_DS_SLL_SINGLYLINKEDLISTLAZY_H
+#define RM_DS_SLL_SINGLYLINKEDLISTLAZY_H
+
+#include "SinglyLinkedList.h"
+
+/**
+ * @ingroup singlylinkedlist
+ * @{
+ */
+
+/**
+ * @file SinglyLinkedListLazy.h
+ * @brief Singly Linked List with lazy deletion (tombstones) and batched compaction (Header) (ds_sll)
+ *
+ * Deleting from a lazy list only marks the node as dead (a tombstone). Traversals, the length, and indexed
+ * accesses skip dead nodes, and a compaction pass unlinks and frees them in bulk, either once the fraction of
+ * dead nodes reaches a configurable threshold or when requested explicitly. Nodes can therefore be deleted
+ * in the middle of a traversal (eg: from the function run by @ref ds_sll_lazyExecuteFunctionOnElements)
+ * without invalidating it. Like @ref ds_sll_t, a lazy list is not thread-safe.
+ **/
+
+/* Datatype definitions */
+/**
+ * Node of a lazy list.
+ * The embedded @ref ds_sll_node_t comes first, so nodes can be traversed with @ref ds_sll_nextNode
+ * and read with @ref ds_sll_extractElementFromNode like any other node.
+ */
+typedef struct ds_sll_lazy_node_t {
+    ds_sll_node_t node; /**< The element and the link to the next node */
+    int dead; /**< 1 once the node was deleted, until it is compacted away */
+} ds_sll_lazy_node_t;
+
+/**
+ * Lazy deletion Singly Linked List datatype
+ */
+typedef struct ds_sll_lazy_t {
+    ds_sll_t list; /**< The underlying list, holding both live and dead nodes */
+    int live_count; /**< Number of live nodes */
+    int dead_count; /**< Number of dead nodes waiting to be compacted */
+    double dead_fraction; /**< Fraction of dead nodes that triggers a compaction, >= 1 to only compact on request */
+    int traversals; /**< Number of traversals in progress, compactions are postponed until they complete */
+} ds_sll_lazy_t;
+/* ------------------------------------------------------------------ */
+
+
+/* Functions */
+// Create/Delete
+ds_sll_lazy_t* ds_sll_newLazyList(double dead_fraction);
+void ds_sll_destroyLazyList(ds_sll_lazy_t** lazyList_toDelete);
+// Append/Insert
+ds_sll_error_t ds_sll_lazyAppendElement(ds_sll_lazy_t* lazyList, void* element);
+ds_sll_error_t ds_sll_lazyInsertElementAtIndex(ds_sll_lazy_t* lazyList, void* element, int index);
+// Delete
+ds_sll_error_t ds_sll_lazyDeleteNodeAtIndex(ds_sll_lazy_t* lazyList, int index);
+ds_sll_error_t ds_sll_lazyDeleteNode(ds_sll_lazy_t* lazyList, ds_sll_node_t* node);
+int ds_sll_lazyCompact(ds_sll_lazy_t* lazyList);
+// Retrieval
+void* ds_sll_lazyGetElementAtIndex(ds_sll_lazy_t* lazyList, int index);
+int ds_sll_lazyExecuteFunctionOnElements(ds_sll_lazy_t* lazyList, ds_sll_func_return_t (*func)(void*, ds_sll_node_t*, int, void*), void *sharedData);
+int ds_sll_lazyCalculateLength(const ds_sll_lazy_t* lazyList);
+/* ------------------------------------------------------------------ */
+
+
+/**
+ * @}
+ */
+
+#endif //RM_DS_SLL_SINGLYLINKEDLISTLAZY_H
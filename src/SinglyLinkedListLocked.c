@@ -0,0 +1,405 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2017 Ronny Majani
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+/**
+ * @ingroup singlylinkedlist
+ * @file SinglyLinkedListLocked.c
+ * @brief Thread-safe Singly Linked List with per node locks (ds_sll)
+ *
+ * Category: Data Structures >> Linked Lists
+ * Codename: ds_sll
+ *
+ * ### Locking:
+ * Operations traverse the list with hand-over-hand locking: the lock of the next node is taken
+ * before the lock of the current node is released. Since every thread acquires locks in list order,
+ * no deadlock is possible, and a thread only ever blocks the one or two nodes it is standing on.
+ * Two writers inserting or deleting at different positions therefore only contend while one of
+ * them walks past the other.
+ *
+ * A node is unlinked while holding the locks of both the node and its predecessor.
+ * Any other thread can only reach a node through its predecessor, so once unlinked the node
+ * can be freed right away.
+ *
+ * Each operation is linearizable: it takes effect at the moment the relevant `next` pointer is read
+ * or written while holding the predecessor's lock.
+ **/
+
+#include "SinglyLinkedListLocked.h"
+#include <assert.h>
+
+/**
+ * @brief Macro definition for ASSERT
+ * Used to enforce Design by Contract coding
+ * Typically disabled on release
+ */
+#define ASSERT assert
+
+
+/**
+ * @brief Create a new thread-safe node
+ * @param element The element to store in the new node
+ * @return A new node containing the given element, or NULL if error occurred
+ */
+static ds_sll_locked_node_t* ds_sll_lockedCreateNode(void* element)
+{
+    ds_sll_locked_node_t* new_node = (ds_sll_locked_node_t*) malloc(sizeof(ds_sll_locked_node_t));
+
+    if(new_node == NULL) {
+        return NULL;
+    }
+
+    if(pthread_mutex_init(&new_node->lock, NULL) != 0) {
+        free(new_node);
+        return NULL;
+    }
+
+    new_node->element = element;
+    new_node->next = NULL;
+    return new_node;
+}
+
+
+/**
+ * @brief Delete a node that is no longer reachable, free its element and its resources, and set the Node pointer to NULL
+ * @param node Pointer to the node to delete
+ */
+static void ds_sll_lockedDeleteNode(ds_sll_locked_node_t** node)
+{
+    if(*node != NULL) {
+        ds_sll_deleteElement(&((*node)->element));
+        pthread_mutex_destroy(&(*node)->lock);
+        free(*node);
+        *node = NULL;
+    }
+}
+
+
+/**
+ * @brief Walk hand-over-hand to the node right before the given index
+ * @param lockedList The list to traverse
+ * @param index The index of the node whose predecessor is wanted
+ * @return The (locked) predecessor of the node at `index` (the sentinel for index 0),
+ *         or NULL (with no lock held) if the list has less than `index` nodes
+ */
+static ds_sll_locked_node_t* ds_sll_lockedLockPredecessor(ds_sll_locked_t* lockedList, int index)
+{
+    ds_sll_locked_node_t* prev = &lockedList->sentinel;
+    pthread_mutex_lock(&prev->lock);
+
+    while(index-- > 0) {
+        ds_sll_locked_node_t* curr = prev->next;
+        if(curr == NULL) {
+            pthread_mutex_unlock(&prev->lock);
+            return NULL;
+        }
+        pthread_mutex_lock(&curr->lock);
+        pthread_mutex_unlock(&prev->lock);
+        prev = curr;
+    }
+
+    return prev;
+}
+
+
+/**
+ * @brief Unlink and delete the node right after `prev`
+ * @param prev The locked predecessor of the node to delete (stays locked)
+ *
+ * The node's own lock is taken first, so a thread still standing on it gets to move on before it is freed.
+ */
+static void ds_sll_lockedUnlinkAfter(ds_sll_locked_node_t* prev)
+{
+    ds_sll_locked_node_t* todel = prev->next;
+
+    pthread_mutex_lock(&todel->lock);
+    prev->next = todel->next;
+    pthread_mutex_unlock(&todel->lock);
+    ds_sll_lockedDeleteNode(&todel);
+}
+
+
+/**
+ * @brief Create a new thread-safe singly linked list
+ * @return Returns a pointer to a new list, or NULL if an error occurred
+ */
+ds_sll_locked_t* ds_sll_newLockedList()
+{
+    ds_sll_locked_t* new_list = (ds_sll_locked_t*) malloc(sizeof(ds_sll_locked_t));
+
+    if(new_list == NULL) {
+        return NULL;
+    }
+
+    if(pthread_mutex_init(&new_list->sentinel.lock, NULL) != 0) {
+        free(new_list);
+        return NULL;
+    }
+
+    new_list->sentinel.element = NULL;
+    new_list->sentinel.next = NULL;
+    return new_list;
+}
+
+
+/**
+ * @brief Destroy a thread-safe singly linked list
+ * @param lockedList_toDelete A pointer to the list to destroy
+ * @return @ref ds_sll_error_t Error code representing the status of the function
+ *
+ * Deletes all the nodes, frees all resources, and sets the given pointer to NULL.
+ * No other thread may be using the list.
+ */
+ds_sll_error_t ds_sll_destroyLockedList(ds_sll_locked_t** lockedList_toDelete)
+{
+    ds_sll_locked_t* lockedList = *lockedList_toDelete;
+
+    if(lockedList == NULL) {
+        return DS_SLL_NO_ERROR;
+    }
+
+    while(lockedList->sentinel.next != NULL) {
+        ds_sll_locked_node_t* todel = lockedList->sentinel.next;
+        lockedList->sentinel.next = todel->next;
+        ds_sll_lockedDeleteNode(&todel);
+    }
+
+    pthread_mutex_destroy(&lockedList->sentinel.lock);
+    free(lockedList);
+    *lockedList_toDelete = NULL;
+    return DS_SLL_NO_ERROR;
+}
+
+
+/**
+ * @brief Create a new node with the given element and insert it at the chosen index
+ * @param lockedList The list to insert into
+ * @param element The element to store in the new node
+ * @param index The index where the node should be inserted (0 up to the length of the list)
+ * @return @ref ds_sll_error_t Error code representing the status of the function
+ */
+ds_sll_error_t ds_sll_lockedInsertElementAtIndex(ds_sll_locked_t* lockedList, void* element, int index)
+{
+    ASSERT((lockedList != NULL) && (index >= 0));
+    ds_sll_locked_node_t* new_node = ds_sll_lockedCreateNode(element);
+
+    if(new_node == NULL) {
+        return DS_SLL_NODE_CREATION_ERROR;
+    }
+
+    ds_sll_locked_node_t* prev = ds_sll_lockedLockPredecessor(lockedList, index);
+
+    if(prev == NULL) {
+        new_node->element = NULL; // the element still belongs to the caller
+        ds_sll_lockedDeleteNode(&new_node);
+        return DS_SLL_INDEX_OUT_OF_BOUNDS_ERROR;
+    }
+
+    new_node->next = prev->next;
+    prev->next = new_node;
+    pthread_mutex_unlock(&prev->lock);
+    return DS_SLL_NO_ERROR;
+}
+
+
+/**
+ * @brief Create a new node with the given element and insert it before the first larger element
+ * @param lockedList The list to insert into. Should be kept sorted by only inserting through this function
+ * @param element The element to store in the new node
+ * @param compareFunc A function returning a negative, zero, or positive value if its first argument is
+ *        smaller than, equal to, or larger than its second argument
+ * @return @ref ds_sll_error_t Error code representing the status of the function
+ */
+ds_sll_error_t ds_sll_lockedInsertElementSorted(ds_sll_locked_t* lockedList, void* element, int (*compareFunc)(void*, void*))
+{
+    ASSERT((lockedList != NULL) && (compareFunc != NULL));
+    ds_sll_locked_node_t* new_node = ds_sll_lockedCreateNode(element);
+
+    if(new_node == NULL) {
+        return DS_SLL_NODE_CREATION_ERROR;
+    }
+
+    ds_sll_locked_node_t* prev = &lockedList->sentinel;
+    ds_sll_locked_node_t* curr;
+    pthread_mutex_lock(&prev->lock);
+
+    while(((curr = prev->next) != NULL) && (compareFunc(curr->element, element) <= 0)) {
+        pthread_mutex_lock(&curr->lock);
+        pthread_mutex_unlock(&prev->lock);
+        prev = curr;
+    }
+
+    new_node->next = curr;
+    prev->next = new_node;
+    pthread_mutex_unlock(&prev->lock);
+    return DS_SLL_NO_ERROR;
+}
+
+
+/**
+ * @brief Delete the node at the given index, and free allocated resources
+ * @param lockedList The list to delete the node from
+ * @param index The index of the node to delete
+ * @return @ref ds_sll_error_t Error code representing the status of the function
+ */
+ds_sll_error_t ds_sll_lockedDeleteNodeAtIndex(ds_sll_locked_t* lockedList, int index)
+{
+    ASSERT((lockedList != NULL) && (index >= 0));
+    ds_sll_locked_node_t* prev = ds_sll_lockedLockPredecessor(lockedList, index);
+
+    if(prev == NULL) {
+        return DS_SLL_INDEX_OUT_OF_BOUNDS_ERROR;
+    }
+    else if(prev->next == NULL) {
+        pthread_mutex_unlock(&prev->lock);
+        return DS_SLL_INDEX_OUT_OF_BOUNDS_ERROR;
+    }
+
+    ds_sll_lockedUnlinkAfter(prev);
+    pthread_mutex_unlock(&prev->lock);
+    return DS_SLL_NO_ERROR;
+}
+
+
+/**
+ * @brief Delete the first node containing the given element, and free allocated resources
+ * @param lockedList The list to delete the node from
+ * @param element The element to search for
+ * @param equalityFunc A function that compares two elements and returns 1 if equal and 0 if not equal.
+ * @return @ref ds_sll_error_t Error code. DS_SLL_INDEX_OUT_OF_BOUNDS_ERROR if no node contains the element
+ */
+ds_sll_error_t ds_sll_lockedDeleteNodeContainingElement(ds_sll_locked_t* lockedList, void* element, int (*equalityFunc)(void*, void*))
+{
+    ASSERT((lockedList != NULL) && (equalityFunc != NULL));
+
+    ds_sll_locked_node_t* prev = &lockedList->sentinel;
+    ds_sll_locked_node_t* curr;
+    pthread_mutex_lock(&prev->lock);
+
+    while((curr = prev->next) != NULL) {
+        pthread_mutex_lock(&curr->lock);
+        if(equalityFunc(curr->element, element) == 1) {
+            pthread_mutex_unlock(&curr->lock);
+            ds_sll_lockedUnlinkAfter(prev);
+            pthread_mutex_unlock(&prev->lock);
+            return DS_SLL_NO_ERROR;
+        }
+        pthread_mutex_unlock(&prev->lock);
+        prev = curr;
+    }
+
+    pthread_mutex_unlock(&prev->lock);
+    return DS_SLL_INDEX_OUT_OF_BOUNDS_ERROR;
+}
+
+
+/**
+ * @brief Check whether the list contains the given element
+ * @param lockedList The list to search
+ * @param element The element to search for
+ * @param equalityFunc A function that compares two elements and returns 1 if equal and 0 if not equal.
+ * @return 1 if a node containing the element was found, 0 otherwise
+ */
+int ds_sll_lockedContainsElement(ds_sll_locked_t* lockedList, void* element, int (*equalityFunc)(void*, void*))
+{
+    ASSERT((lockedList != NULL) && (equalityFunc != NULL));
+
+    ds_sll_locked_node_t* prev = &lockedList->sentinel;
+    ds_sll_locked_node_t* curr;
+    pthread_mutex_lock(&prev->lock);
+
+    while((curr = prev->next) != NULL) {
+        pthread_mutex_lock(&curr->lock);
+        pthread_mutex_unlock(&prev->lock);
+        if(equalityFunc(curr->element, element) == 1) {
+            pthread_mutex_unlock(&curr->lock);
+            return 1;
+        }
+        prev = curr;
+    }
+
+    pthread_mutex_unlock(&prev->lock);
+    return 0;
+}
+
+
+/**
+ * @brief Executes a function on each element in the list in order
+ * @param lockedList The list to map the function to
+ * @param func A function to execute on each element (see @ref ds_sll_executeFunctionOnElements).
+ *        It is called while holding the lock of the node it is given
+ * @param sharedData A pointer that is passed to your function
+ * @return -1 if no error occurred; the index of the node where the error occurred at otherwise.
+ */
+int ds_sll_lockedExecuteFunctionOnElements(ds_sll_locked_t* lockedList, ds_sll_func_return_t (*func)(void*, ds_sll_locked_node_t*, int, void*), void *sharedData)
+{
+    ASSERT((lockedList != NULL) && (func != NULL));
+
+    ds_sll_locked_node_t* prev = &lockedList->sentinel;
+    ds_sll_locked_node_t* curr;
+    int index = 0;
+    pthread_mutex_lock(&prev->lock);
+
+    while((curr = prev->next) != NULL) {
+        pthread_mutex_lock(&curr->lock);
+        pthread_mutex_unlock(&prev->lock);
+
+        ds_sll_func_return_t returncode = func(curr->element, curr, index, sharedData);
+        if(returncode != DS_SLL_CONTINUE_EXECUTION) {
+            pthread_mutex_unlock(&curr->lock);
+            return (returncode == DS_SLL_EXECUTION_ERROR) ? index : -1;
+        }
+
+        prev = curr;
+        index++;
+    }
+
+    pthread_mutex_unlock(&prev->lock);
+    return -1;
+}
+
+
+/**
+ * @brief Calculates the length of the list (by traversing it)
+ * @param lockedList The list that's length you seek
+ * @return The number of nodes in the list at the time each of them was visited
+ */
+int ds_sll_lockedCalculateLength(ds_sll_locked_t* lockedList)
+{
+    ASSERT(lockedList != NULL);
+
+    ds_sll_locked_node_t* prev = &lockedList->sentinel;
+    ds_sll_locked_node_t* curr;
+    int length = 0;
+    pthread_mutex_lock(&prev->lock);
+
+    while((curr = prev->next) != NULL) {
+        pthread_mutex_lock(&curr->lock);
+        pthread_mutex_unlock(&prev->lock);
+        prev = curr;
+        length++;
+    }
+
+    pthread_mutex_unlock(&prev->lock);
+    return length;
+}
@@ -0,0 +1,87 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2017 Ronny Majani
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#ifndef RM_DS_SLL_SINGLYLINKEDLISTLOCKED_H
+#define RM_DS_SLL_SINGLYLINKEDLISTLOCKED_H
+
+#include "SinglyLinkedList.h"
+#include <pthread.h>
+
+/**
+ * @ingroup singlylinkedlist
+ * @{
+ */
+
+/**
+ * @file SinglyLinkedListLocked.h
+ * @brief Thread-safe Singly Linked List with per node locks (Header) (ds_sll)
+ *
+ * Every node carries its own mutex and every operation walks the list with hand-over-hand
+ * (lock coupling) locking, so writers working on different regions of the list proceed in parallel.
+ **/
+
+/* Datatype definitions */
+/**
+ * Thread-safe Singly Linked List Node datatype
+ */
+typedef struct ds_sll_locked_node_t {
+    /** Pointer to the data being stored in the node.
+     * User is responsible for typecasting this pointer appropriately */
+    void* element;
+    struct ds_sll_locked_node_t* next; /**< pointer to the next node in the list, guarded by `lock` */
+    pthread_mutex_t lock; /**< Guards `next` and `element` */
+} ds_sll_locked_node_t;
+
+/**
+ * Thread-safe Singly Linked List datatype.
+ * The list starts with a sentinel node that holds no element, so that the head can be locked like any other node
+ */
+typedef struct ds_sll_locked_t {
+    ds_sll_locked_node_t sentinel; /**< sentinel.next points to the first node of the list */
+} ds_sll_locked_t;
+/* ------------------------------------------------------------------ */
+
+
+/* Functions */
+// Create/Delete
+ds_sll_locked_t* ds_sll_newLockedList();
+ds_sll_error_t ds_sll_destroyLockedList(ds_sll_locked_t** lockedList_toDelete);
+// Insert
+ds_sll_error_t ds_sll_lockedInsertElementAtIndex(ds_sll_locked_t* lockedList, void* element, int index);
+ds_sll_error_t ds_sll_lockedInsertElementSorted(ds_sll_locked_t* lockedList, void* element, int (*compareFunc)(void*, void*));
+// Delete
+ds_sll_error_t ds_sll_lockedDeleteNodeAtIndex(ds_sll_locked_t* lockedList, int index);
+ds_sll_error_t ds_sll_lockedDeleteNodeContainingElement(ds_sll_locked_t* lockedList, void* element, int (*equalityFunc)(void*, void*));
+// Retrieval and Search
+int ds_sll_lockedContainsElement(ds_sll_locked_t* lockedList, void* element, int (*equalityFunc)(void*, void*));
+int ds_sll_lockedExecuteFunctionOnElements(ds_sll_locked_t* lockedList, ds_sll_func_return_t (*func)(void*, ds_sll_locked_node_t*, int, void*), void *sharedData);
+int ds_sll_lockedCalculateLength(ds_sll_locked_t* lockedList);
+/* ------------------------------------------------------------------ */
+
+
+/**
+ * @}
+ */
+
+#endif //RM_DS_SLL_SINGLYLINKEDLISTLOCKED_H
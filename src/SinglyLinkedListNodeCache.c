@@ -0,0 +1,488 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2017 Ronny Majani
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+/**
+ * @ingroup singlylinkedlist
+ * @file SinglyLinkedListNodeCache.c
+ * @brief Thread-local caches of free Singly Linked List nodes (ds_sll)
+ *
+ * Category: Data Structures >> Linked Lists
+ * Codename: ds_sll
+ *
+ * ### Usage:
+ * + Create a cache, choosing the magazine size and how many magazines the depot keeps
+ * + Create and delete nodes through it from any number of threads
+ * + A thread's magazines are handed back to the depot when the thread exits, or earlier with @ref ds_sll_nodeCacheReleaseThread
+ * + Destroy the cache once every other thread using it exited or released its magazines
+ *
+ * ### Magazines:
+ * Each thread owns a loaded and a previous magazine, the previous one being always full or empty.
+ * Creating a node pops from the loaded magazine; when it is empty it is swapped with the previous one,
+ * and when both are empty the empty one is exchanged for a full magazine of the depot.
+ * Deleting a node pushes onto the loaded magazine; when both magazines are full the previous one is
+ * handed to the depot in exchange for an empty one. Only then (and when the depot has nothing to give
+ * or no room left) does a thread take the depot lock or call malloc and free, so a thread only touches
+ * shared state once every magazine_size operations.
+ **/
+
+#include "SinglyLinkedListNodeCache.h"
+#include <assert.h>
+
+/**
+ * @brief Macro definition for ASSERT
+ * Used to enforce Design by Contract coding
+ * Typically disabled on release
+ */
+#define ASSERT assert
+
+/**
+ * @brief Magazine size used when none is given
+ */
+#define DS_SLL_NODE_CACHE_DEFAULT_MAGAZINE_SIZE 64
+
+/**
+ * @brief Depot size used when none is given
+ */
+#define DS_SLL_NODE_CACHE_DEFAULT_DEPOT_SIZE 16
+
+
+/**
+ * @brief Increment a counter of the calling thread's cache (which other threads may read)
+ */
+static inline void ds_sll_nodeCacheCount(long* counter)
+{
+    __atomic_store_n(counter, *counter + 1, __ATOMIC_RELAXED);
+}
+
+
+/**
+ * @brief Allocate an empty magazine
+ * @return The magazine, or NULL if an error occurred
+ */
+static ds_sll_node_magazine_t* ds_sll_nodeCacheNewMagazine(int magazine_size)
+{
+    ds_sll_node_magazine_t* magazine = (ds_sll_node_magazine_t*) malloc(sizeof(ds_sll_node_magazine_t)
+                                                                        + magazine_size * sizeof(ds_sll_node_t*));
+
+    if(magazine != NULL) {
+        magazine->next = NULL;
+        magazine->count = 0;
+    }
+    return magazine;
+}
+
+
+/**
+ * @brief Free a magazine along with the nodes it holds
+ */
+static void ds_sll_nodeCacheFreeMagazine(ds_sll_node_magazine_t* magazine)
+{
+    int i;
+
+    if(magazine == NULL) {
+        return;
+    }
+    for(i = 0; i < magazine->count; i++) {
+        free(magazine->nodes[i]);
+    }
+    free(magazine);
+}
+
+
+/**
+ * @brief Add the counters of a thread cache to the counters of another one (with the cache locked)
+ */
+static void ds_sll_nodeCacheAddCounters(ds_sll_node_cache_thread_t* total, const ds_sll_node_cache_thread_t* thread)
+{
+    total->allocations += __atomic_load_n(&thread->allocations, __ATOMIC_RELAXED);
+    total->hits += __atomic_load_n(&thread->hits, __ATOMIC_RELAXED);
+    total->frees += __atomic_load_n(&thread->frees, __ATOMIC_RELAXED);
+    total->cached_frees += __atomic_load_n(&thread->cached_frees, __ATOMIC_RELAXED);
+    total->depot_gets += __atomic_load_n(&thread->depot_gets, __ATOMIC_RELAXED);
+    total->depot_puts += __atomic_load_n(&thread->depot_puts, __ATOMIC_RELAXED);
+}
+
+
+/**
+ * @brief Hand the magazines of a thread cache to the depot (or free them), unregister it, and free it
+ * @param thread The thread cache to release
+ */
+static void ds_sll_nodeCacheRelease(ds_sll_node_cache_thread_t* thread)
+{
+    ds_sll_node_cache_t* cache = thread->cache;
+    ds_sll_node_magazine_t* magazines[2] = { thread->loaded, thread->previous };
+    int i;
+
+    pthread_mutex_lock(&cache->lock);
+    for(i = 0; i < 2; i++) {
+        ds_sll_node_magazine_t* magazine = magazines[i];
+        if((magazine->count == cache->magazine_size) && (cache->full_count < cache->depot_size)) {
+            magazine->next = cache->full;
+            cache->full = magazine;
+            cache->full_count++;
+            magazines[i] = NULL;
+        } else if((magazine->count == 0) && (cache->empty_count < cache->depot_size)) {
+            magazine->next = cache->empty;
+            cache->empty = magazine;
+            cache->empty_count++;
+            magazines[i] = NULL;
+        }
+    }
+
+    ds_sll_nodeCacheAddCounters(&cache->retired, thread);
+    if(thread->prev != NULL) {
+        thread->prev->next = thread->next;
+    } else {
+        cache->threads = thread->next;
+    }
+    if(thread->next != NULL) {
+        thread->next->prev = thread->prev;
+    }
+    pthread_mutex_unlock(&cache->lock);
+
+    // partially filled magazines (and the ones the depot has no room for) are freed
+    ds_sll_nodeCacheFreeMagazine(magazines[0]);
+    ds_sll_nodeCacheFreeMagazine(magazines[1]);
+    free(thread);
+}
+
+
+/**
+ * @brief Destructor of the thread specific data, called when a thread that used the cache exits
+ */
+static void ds_sll_nodeCacheThreadExit(void* thread)
+{
+    ds_sll_nodeCacheRelease((ds_sll_node_cache_thread_t*) thread);
+}
+
+
+/**
+ * @brief Get the calling thread's cache, creating and registering it on first use
+ * @return The thread cache, or NULL if an error occurred
+ */
+static ds_sll_node_cache_thread_t* ds_sll_nodeCacheThread(ds_sll_node_cache_t* cache)
+{
+    ds_sll_node_cache_thread_t* thread = (ds_sll_node_cache_thread_t*) pthread_getspecific(cache->thread_key);
+
+    if(thread != NULL) {
+        return thread;
+    }
+
+    thread = (ds_sll_node_cache_thread_t*) calloc(1, sizeof(ds_sll_node_cache_thread_t));
+    if(thread == NULL) {
+        return NULL;
+    }
+    thread->cache = cache;
+    thread->loaded = ds_sll_nodeCacheNewMagazine(cache->magazine_size);
+    thread->previous = ds_sll_nodeCacheNewMagazine(cache->magazine_size);
+    if((thread->loaded == NULL) || (thread->previous == NULL) || (pthread_setspecific(cache->thread_key, thread) != 0)) {
+        free(thread->loaded);
+        free(thread->previous);
+        free(thread);
+        return NULL;
+    }
+
+    pthread_mutex_lock(&cache->lock);
+    thread->next = cache->threads;
+    if(cache->threads != NULL) {
+        cache->threads->prev = thread;
+    }
+    cache->threads = thread;
+    pthread_mutex_unlock(&cache->lock);
+    return thread;
+}
+
+
+/**
+ * @brief Exchange the (empty) loaded magazine of a thread for a full magazine of the depot
+ * @return 1 if a full magazine was loaded, 0 if the depot has none
+ */
+static int ds_sll_nodeCacheRefill(ds_sll_node_cache_thread_t* thread)
+{
+    ds_sll_node_cache_t* cache = thread->cache;
+    ds_sll_node_magazine_t* unkept = NULL;
+    ds_sll_node_magazine_t* full;
+
+    pthread_mutex_lock(&cache->lock);
+    full = cache->full;
+    if(full == NULL) {
+        pthread_mutex_unlock(&cache->lock);
+        return 0;
+    }
+    cache->full = full->next;
+    cache->full_count--;
+
+    if(cache->empty_count < cache->depot_size) {
+        thread->loaded->next = cache->empty;
+        cache->empty = thread->loaded;
+        cache->empty_count++;
+    } else {
+        unkept = thread->loaded;
+    }
+    pthread_mutex_unlock(&cache->lock);
+
+    free(unkept);
+    thread->loaded = full;
+    ds_sll_nodeCacheCount(&thread->depot_gets);
+    return 1;
+}
+
+
+/**
+ * @brief Hand the (full) previous magazine of a thread to the depot, and load an empty magazine in place of the (full) loaded one
+ * @return 1 if the loaded magazine has room again, 0 if the depot is full
+ */
+static int ds_sll_nodeCacheSpill(ds_sll_node_cache_thread_t* thread)
+{
+    ds_sll_node_cache_t* cache = thread->cache;
+    ds_sll_node_magazine_t* empty;
+
+    pthread_mutex_lock(&cache->lock);
+    if(cache->full_count >= cache->depot_size) {
+        pthread_mutex_unlock(&cache->lock);
+        return 0;
+    }
+
+    empty = cache->empty;
+    if(empty != NULL) {
+        cache->empty = empty->next;
+        cache->empty_count--;
+    } else { // allocate a new magazine without holding the lock
+        pthread_mutex_unlock(&cache->lock);
+        if((empty = ds_sll_nodeCacheNewMagazine(cache->magazine_size)) == NULL) {
+            return 0;
+        }
+        pthread_mutex_lock(&cache->lock);
+        if(cache->full_count >= cache->depot_size) {
+            pthread_mutex_unlock(&cache->lock);
+            free(empty);
+            return 0;
+        }
+    }
+
+    thread->previous->next = cache->full;
+    cache->full = thread->previous;
+    cache->full_count++;
+    pthread_mutex_unlock(&cache->lock);
+
+    empty->count = 0;
+    thread->previous = thread->loaded;
+    thread->loaded = empty;
+    ds_sll_nodeCacheCount(&thread->depot_puts);
+    return 1;
+}
+
+
+/**
+ * @brief Create a new node cache
+ * @param magazine_size The number of nodes a magazine holds, 0 for the default (64).
+ *        Each thread caches up to twice as many nodes
+ * @param depot_size The maximum number of full magazines kept in the depot, 0 for the default (16)
+ * @return A pointer to the new node cache, or NULL if an error occurred
+ */
+ds_sll_node_cache_t* ds_sll_newNodeCache(int magazine_size, int depot_size)
+{
+    ASSERT((magazine_size >= 0) && (depot_size >= 0));
+    ds_sll_node_cache_t* cache = (ds_sll_node_cache_t*) calloc(1, sizeof(ds_sll_node_cache_t));
+
+    if(cache == NULL) {
+        return NULL;
+    }
+
+    cache->magazine_size = (magazine_size == 0) ? DS_SLL_NODE_CACHE_DEFAULT_MAGAZINE_SIZE : magazine_size;
+    cache->depot_size = (depot_size == 0) ? DS_SLL_NODE_CACHE_DEFAULT_DEPOT_SIZE : depot_size;
+
+    if(pthread_mutex_init(&cache->lock, NULL) != 0) {
+        free(cache);
+        return NULL;
+    }
+    if(pthread_key_create(&cache->thread_key, ds_sll_nodeCacheThreadExit) != 0) {
+        pthread_mutex_destroy(&cache->lock);
+        free(cache);
+        return NULL;
+    }
+
+    return cache;
+}
+
+
+/**
+ * @brief Destroy a node cache, free every cached node and all resources, and set the given pointer to NULL
+ * @param cache_toDelete The node cache to destroy
+ *
+ * The calling thread's magazines are released first. Every other thread that used the cache
+ * must have exited or called @ref ds_sll_nodeCacheReleaseThread.
+ */
+void ds_sll_destroyNodeCache(ds_sll_node_cache_t** cache_toDelete)
+{
+    ASSERT(cache_toDelete != NULL);
+    ds_sll_node_cache_t* cache = *cache_toDelete;
+    ds_sll_node_magazine_t* magazine;
+
+    if(cache == NULL) {
+        return;
+    }
+
+    ds_sll_nodeCacheReleaseThread(cache);
+    ASSERT(cache->threads == NULL);
+
+    while((magazine = cache->full) != NULL) {
+        cache->full = magazine->next;
+        ds_sll_nodeCacheFreeMagazine(magazine);
+    }
+    while((magazine = cache->empty) != NULL) {
+        cache->empty = magazine->next;
+        free(magazine);
+    }
+
+    pthread_key_delete(cache->thread_key);
+    pthread_mutex_destroy(&cache->lock);
+    free(cache);
+    *cache_toDelete = NULL;
+}
+
+
+/**
+ * @brief Hand the calling thread's magazines back to the depot
+ * @param cache The node cache
+ *
+ * Called automatically when a thread exits. Call it explicitly on threads that stop using the cache
+ * for good, or that have to release it before the cache is destroyed.
+ */
+void ds_sll_nodeCacheReleaseThread(ds_sll_node_cache_t* cache)
+{
+    ASSERT(cache != NULL);
+    ds_sll_node_cache_thread_t* thread = (ds_sll_node_cache_thread_t*) pthread_getspecific(cache->thread_key);
+
+    if(thread != NULL) {
+        pthread_setspecific(cache->thread_key, NULL);
+        ds_sll_nodeCacheRelease(thread);
+    }
+}
+
+
+/**
+ * @brief Create a new node, taking it from the calling thread's cache when possible
+ * @param cache The node cache
+ * @param element The element to store in the node
+ * @return The new node, or NULL if an error occurred
+ */
+ds_sll_node_t* ds_sll_nodeCacheCreateNode(ds_sll_node_cache_t* cache, void* element)
+{
+    ASSERT(cache != NULL);
+    ds_sll_node_cache_thread_t* thread = ds_sll_nodeCacheThread(cache);
+    ds_sll_node_t* new_node = NULL;
+
+    if(thread != NULL) {
+        ds_sll_nodeCacheCount(&thread->allocations);
+
+        if((thread->loaded->count == 0) && (thread->previous->count > 0)) {
+            ds_sll_node_magazine_t* full = thread->previous;
+            thread->previous = thread->loaded;
+            thread->loaded = full;
+        }
+        if((thread->loaded->count > 0) || ds_sll_nodeCacheRefill(thread)) {
+            new_node = thread->loaded->nodes[--thread->loaded->count];
+            ds_sll_nodeCacheCount(&thread->hits);
+        }
+    }
+
+    if(new_node == NULL) {
+        new_node = (ds_sll_node_t*) malloc(sizeof(ds_sll_node_t));
+        if(new_node == NULL) {
+            return NULL;
+        }
+    }
+
+    ds_sll_storeElementInNode(new_node, element);
+    new_node->next = NULL;
+    return new_node;
+}
+
+
+/**
+ * @brief Delete a node, free its element, keep the node in the calling thread's cache when possible, and set the Node pointer to NULL
+ * @param cache The node cache
+ * @param node The node to delete (created by any thread, with a node cache or with @ref ds_sll_createNode)
+ */
+void ds_sll_nodeCacheDeleteNode(ds_sll_node_cache_t* cache, ds_sll_node_t** node)
+{
+    ASSERT((cache != NULL) && (node != NULL));
+    ds_sll_node_cache_thread_t* thread;
+
+    if(*node == NULL) {
+        return;
+    }
+
+    ds_sll_deleteElement(&(*node)->element);
+    thread = ds_sll_nodeCacheThread(cache);
+
+    if(thread != NULL) {
+        ds_sll_nodeCacheCount(&thread->frees);
+
+        if((thread->loaded->count == cache->magazine_size) && (thread->previous->count == 0)) {
+            ds_sll_node_magazine_t* empty = thread->previous;
+            thread->previous = thread->loaded;
+            thread->loaded = empty;
+        }
+        if((thread->loaded->count < cache->magazine_size) || ds_sll_nodeCacheSpill(thread)) {
+            thread->loaded->nodes[thread->loaded->count++] = *node;
+            ds_sll_nodeCacheCount(&thread->cached_frees);
+            *node = NULL;
+            return;
+        }
+    }
+
+    free(*node);
+    *node = NULL;
+}
+
+
+/**
+ * @brief Read the counters of a node cache
+ * @param cache The node cache
+ * @param stats Set to the sums of the counters of every thread that used the cache so far
+ */
+void ds_sll_nodeCacheStats(ds_sll_node_cache_t* cache, ds_sll_node_cache_stats_t* stats)
+{
+    ASSERT((cache != NULL) && (stats != NULL));
+    ds_sll_node_cache_thread_t total = { 0 };
+    ds_sll_node_cache_thread_t* thread;
+
+    pthread_mutex_lock(&cache->lock);
+    ds_sll_nodeCacheAddCounters(&total, &cache->retired);
+    for(thread = cache->threads; thread != NULL; thread = thread->next) {
+        ds_sll_nodeCacheAddCounters(&total, thread);
+    }
+    stats->depot_full = cache->full_count;
+    pthread_mutex_unlock(&cache->lock);
+
+    stats->allocations = total.allocations;
+    stats->hits = total.hits;
+    stats->hit_rate = (total.allocations > 0) ? (double) total.hits / total.allocations : 0;
+    stats->frees = total.frees;
+    stats->cached_frees = total.cached_frees;
+    stats->depot_gets = total.depot_gets;
+    stats->depot_puts = total.depot_puts;
+}
@@ -0,0 +1,126 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2017 Ronny Majani
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#ifndef RM_DS_SLL_SINGLYLINKEDLISTNODECACHE_H
+#define RM_DS_SLL_SINGLYLINKEDLISTNODECACHE_H
+
+#include "SinglyLinkedList.h"
+#include <pthread.h>
+
+/**
+ * @ingroup singlylinkedlist
+ * @{
+ */
+
+/**
+ * @file SinglyLinkedListNodeCache.h
+ * @brief Thread-local caches of free Singly Linked List nodes (Header) (ds_sll)
+ *
+ * Every thread using a node cache keeps two magazines (small stacks) of free nodes, so creating and deleting
+ * nodes is a thread-local pointer pop or push in the common case. Full and empty magazines are exchanged
+ * through a global depot, which balances nodes between threads that mostly delete (consumers)
+ * and threads that mostly create (producers) without going through malloc and free.
+ *
+ * Cached nodes are regular `malloc` allocations of a @ref ds_sll_node_t, so nodes created by a cache can be
+ * deleted with @ref ds_sll_deleteNode and nodes created by @ref ds_sll_createNode can be given to a cache.
+ **/
+
+/* Datatype definitions */
+/**
+ * A magazine: a fixed size stack of free nodes
+ */
+typedef struct ds_sll_node_magazine_t {
+    struct ds_sll_node_magazine_t* next; /**< Next magazine in the depot */
+    int count; /**< Number of nodes in the magazine */
+    ds_sll_node_t* nodes[]; /**< The free nodes (magazine_size of them) */
+} ds_sll_node_magazine_t;
+
+/**
+ * The cache of one thread.
+ * Counters are only written by the owning thread, and read atomically by @ref ds_sll_nodeCacheStats
+ */
+typedef struct ds_sll_node_cache_thread_t {
+    struct ds_sll_node_cache_t* cache; /**< The node cache this thread cache belongs to */
+    ds_sll_node_magazine_t* loaded; /**< The magazine nodes are taken from and returned to */
+    ds_sll_node_magazine_t* previous; /**< The other magazine, always either full or empty */
+    long allocations; /**< Number of nodes created */
+    long hits; /**< Number of nodes created from a magazine (not allocated) */
+    long frees; /**< Number of nodes deleted */
+    long cached_frees; /**< Number of deleted nodes kept in a magazine (not freed) */
+    long depot_gets; /**< Number of full magazines taken from the depot */
+    long depot_puts; /**< Number of full magazines handed to the depot */
+    struct ds_sll_node_cache_thread_t* next; /**< Next registered thread cache */
+    struct ds_sll_node_cache_thread_t* prev; /**< Previous registered thread cache */
+} ds_sll_node_cache_thread_t;
+
+/**
+ * Node cache datatype
+ */
+typedef struct ds_sll_node_cache_t {
+    int magazine_size; /**< Number of nodes held by a magazine */
+    int depot_size; /**< Maximum number of full magazines (and of empty magazines) kept in the depot */
+    pthread_key_t thread_key; /**< Key of the calling thread's @ref ds_sll_node_cache_thread_t */
+    pthread_mutex_t lock; /**< Guards every field below */
+    ds_sll_node_magazine_t* full; /**< Full magazines in the depot */
+    int full_count; /**< Number of full magazines in the depot */
+    ds_sll_node_magazine_t* empty; /**< Empty magazines in the depot */
+    int empty_count; /**< Number of empty magazines in the depot */
+    ds_sll_node_cache_thread_t* threads; /**< Registered thread caches */
+    ds_sll_node_cache_thread_t retired; /**< Counters of the thread caches that were released */
+} ds_sll_node_cache_t;
+
+/**
+ * Snapshot of the counters of a node cache
+ */
+typedef struct ds_sll_node_cache_stats_t {
+    long allocations; /**< Nodes created */
+    long hits; /**< Nodes created from a magazine instead of being allocated */
+    double hit_rate; /**< hits / allocations (0 if no node was created) */
+    long frees; /**< Nodes deleted */
+    long cached_frees; /**< Deleted nodes kept in a magazine instead of being freed */
+    long depot_gets; /**< Full magazines taken from the depot */
+    long depot_puts; /**< Full magazines handed to the depot */
+    int depot_full; /**< Full magazines currently in the depot */
+} ds_sll_node_cache_stats_t;
+/* ------------------------------------------------------------------ */
+
+
+/* Functions */
+// Create/Delete
+ds_sll_node_cache_t* ds_sll_newNodeCache(int magazine_size, int depot_size);
+void ds_sll_destroyNodeCache(ds_sll_node_cache_t** cache_toDelete);
+void ds_sll_nodeCacheReleaseThread(ds_sll_node_cache_t* cache);
+// Nodes
+ds_sll_node_t* ds_sll_nodeCacheCreateNode(ds_sll_node_cache_t* cache, void* element);
+void ds_sll_nodeCacheDeleteNode(ds_sll_node_cache_t* cache, ds_sll_node_t** node);
+// Statistics
+void ds_sll_nodeCacheStats(ds_sll_node_cache_t* cache, ds_sll_node_cache_stats_t* stats);
+/* ------------------------------------------------------------------ */
+
+
+/**
+ * @}
+ */
+
+#endif //RM_DS_SLL_SINGLYLINKEDLISTNODECACHE_H
@@ -0,0 +1,216 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2017 Ronny Majani
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+/**
+ * @ingroup singlylinkedlist
+ * @file SinglyLinkedListPartition.c
+ * @brief Partitioning of Singly Linked Lists into k segments (ds_sll)
+ *
+ * Category: Data Structures >> Linked Lists
+ * Codename: ds_sll
+ *
+ * ### Usage:
+ * + Into Segments: k runs of consecutive nodes whose lengths differ by at most one
+ * + By Selector: every node goes to the segment chosen by a function of its element (eg: a predicate for k = 2)
+ * + By Hash: every node goes to the segment given by the hash of its element modulo k
+ * + Concatenate Segments: link the segments back together, in order, in O(k)
+ * Nodes are appended to the given segments (which may already hold nodes) keeping their relative order,
+ * and the partitioned list is left empty.
+ **/
+
+#include "SinglyLinkedListPartition.h"
+#include "SinglyLinkedListTrace.h"
+#include <assert.h>
+
+/**
+ * @brief Macro definition for ASSERT
+ * Used to enforce Design by Contract coding
+ * Typically disabled on release
+ */
+#define ASSERT assert
+
+
+/**
+ * The hash function and number of segments of @ref ds_sll_partitionByHash
+ */
+typedef struct ds_sll_partition_hash_t {
+    size_t (*hashFunc)(void*); /**< The hash function of the elements */
+    int k; /**< The number of segments */
+} ds_sll_partition_hash_t;
+
+
+/**
+ * @brief Append a chain of nodes to the end of a segment
+ * @param segment The segment to append to
+ * @param first The first node of the chain
+ * @param last The last node of the chain, its `next` pointer is reset to NULL
+ *
+ * Wraps the chain in a temporary list and moves it with @ref ds_sll_concatenate, in constant time.
+ */
+static inline void ds_sll_partitionAppendChain(ds_sll_t* segment, ds_sll_node_t* first, ds_sll_node_t* last)
+{
+    ds_sll_t chain = { first, last };
+    ds_sll_concatenate(segment, &chain);
+}
+
+
+/**
+ * @brief Selector of @ref ds_sll_partitionByHash
+ */
+static int ds_sll_partitionSelectByHash(void* element, void* sharedData)
+{
+    ds_sll_partition_hash_t* hash = (ds_sll_partition_hash_t*) sharedData;
+    return (int) (hash->hashFunc(element) % (size_t) hash->k);
+}
+
+
+/**
+ * @brief Split a list into k runs of consecutive nodes whose lengths differ by at most one, in a single traversal
+ * @param linkedList The singly linked list to partition. It is left empty (head and tail set to NULL)
+ * @param segments The k singly linked lists receiving the runs, in order (the first nodes go to segments[0])
+ * @param k The number of segments (> 0)
+ * @param length The length of the list if known, or a negative value to have it counted (which costs one more traversal)
+ * @return @ref ds_sll_error_t Error Code.
+ *
+ * The first `length % k` segments receive `length / k + 1` nodes, the others `length / k` nodes
+ * (if the given length is too small, the last segment receives the remaining nodes).
+ * Each traversal stops at the last cut point, so the nodes of the last segment are never visited.
+ */
+ds_sll_error_t ds_sll_partitionIntoSegments(ds_sll_t* linkedList, ds_sll_t** segments, int k, int length)
+{
+    ASSERT((linkedList != NULL) && (segments != NULL) && (k > 0));
+    // the chains are temporary lists unknown to the trace, keep their concatenations out of it
+    DS_SLL_TRACE(DS_SLL_TRACE_NONE, NULL, NULL, 0, 0);
+    ds_sll_node_t* node = linkedList->head;
+    int i;
+
+    if(length < 0) {
+        for(length = 0; node != NULL; node = ds_sll_nextNode(node)) {
+            length++;
+        }
+        node = linkedList->head;
+    }
+
+    for(i = 0; (i < k) && (node != NULL); i++) {
+        int size = length / k + ((i < length % k) ? 1 : 0);
+        ds_sll_node_t* first = node;
+        ds_sll_node_t* last;
+
+        if(i == k - 1) { // the last segment takes whatever is left, no need to walk it
+            ds_sll_partitionAppendChain(segments[i], first, linkedList->tail);
+            break;
+        }
+        if(size == 0) {
+            continue;
+        }
+
+        while((--size > 0) && (node != linkedList->tail)) {
+            node = ds_sll_nextNode(node);
+        }
+        last = node;
+        node = (last == linkedList->tail) ? NULL : ds_sll_nextNode(last);
+        ds_sll_partitionAppendChain(segments[i], first, last);
+    }
+
+    linkedList->head = NULL;
+    linkedList->tail = NULL;
+    return DS_SLL_NO_ERROR;
+}
+
+
+/**
+ * @brief Distribute the nodes of a list over k segments according to a selector function, in a single traversal
+ * @param linkedList The singly linked list to partition. It is left empty (head and tail set to NULL) on success
+ * @param segments The k singly linked lists receiving the nodes
+ * @param k The number of segments (> 0)
+ * @param selectFunc A function returning the index of the segment (0 to k - 1) an element belongs to.
+ *        It receives the element and `sharedData`
+ * @param sharedData A pointer that is passed to the selector function
+ * @return @ref ds_sll_error_t Error Code.
+ *
+ * Nodes keep their relative order within each segment. If the selector returns an index out of bounds,
+ * DS_SLL_INDEX_OUT_OF_BOUNDS_ERROR is returned and the list keeps the nodes that were not distributed yet
+ * (starting with the offending one).
+ */
+ds_sll_error_t ds_sll_partitionBySelector(ds_sll_t* linkedList, ds_sll_t** segments, int k, int (*selectFunc)(void*, void*), void* sharedData)
+{
+    ASSERT((linkedList != NULL) && (segments != NULL) && (k > 0) && (selectFunc != NULL));
+    DS_SLL_TRACE(DS_SLL_TRACE_NONE, NULL, NULL, 0, 0);
+    ds_sll_node_t* node = linkedList->head;
+
+    while(node != NULL) {
+        ds_sll_node_t* next = (node == linkedList->tail) ? NULL : ds_sll_nextNode(node);
+        int segment = selectFunc(ds_sll_extractElementFromNode(node), sharedData);
+
+        if((segment < 0) || (segment >= k)) {
+            linkedList->head = node;
+            return DS_SLL_INDEX_OUT_OF_BOUNDS_ERROR;
+        }
+
+        ds_sll_partitionAppendChain(segments[segment], node, node);
+        node = next;
+    }
+
+    linkedList->head = NULL;
+    linkedList->tail = NULL;
+    return DS_SLL_NO_ERROR;
+}
+
+
+/**
+ * @brief Distribute the nodes of a list over k segments by the hash of their elements, in a single traversal
+ * @param linkedList The singly linked list to partition. It is left empty (head and tail set to NULL)
+ * @param segments The k singly linked lists receiving the nodes
+ * @param k The number of segments (> 0)
+ * @param hashFunc A function returning the hash of an element. A node goes to segment `hash % k`
+ * @return @ref ds_sll_error_t Error Code.
+ *
+ * Equal elements (with equal hashes) always end up in the same segment, keeping their relative order.
+ */
+ds_sll_error_t ds_sll_partitionByHash(ds_sll_t* linkedList, ds_sll_t** segments, int k, size_t (*hashFunc)(void*))
+{
+    ASSERT(hashFunc != NULL);
+    ds_sll_partition_hash_t hash = { hashFunc, k };
+
+    return ds_sll_partitionBySelector(linkedList, segments, k, ds_sll_partitionSelectByHash, &hash);
+}
+
+
+/**
+ * @brief Concatenate k segments, in order, to the end of a list, in O(k)
+ * @param linkedList The singly linked list receiving the nodes of all the segments (eg: the list that was partitioned)
+ * @param segments The k singly linked lists to concatenate. They are left empty (head and tail set to NULL)
+ * @param k The number of segments
+ *
+ * Each segment is moved with @ref ds_sll_concatenate (and recorded as such when tracing).
+ */
+void ds_sll_concatenateSegments(ds_sll_t* linkedList, ds_sll_t** segments, int k)
+{
+    ASSERT((linkedList != NULL) && ((segments != NULL) || (k == 0)));
+    int i;
+
+    for(i = 0; i < k; i++) {
+        ds_sll_concatenate(linkedList, segments[i]);
+    }
+}
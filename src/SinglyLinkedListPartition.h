@@ -0,0 +1,58 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2017 Ronny Majani
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#ifndef RM_DS_SLL_SINGLYLINKEDLISTPARTITION_H
+#define RM_DS_SLL_SINGLYLINKEDLISTPARTITION_H
+
+#include "SinglyLinkedList.h"
+
+/**
+ * @ingroup singlylinkedlist
+ * @{
+ */
+
+/**
+ * @file SinglyLinkedListPartition.h
+ * @brief Partitioning of Singly Linked Lists into k segments (Header) (ds_sll)
+ *
+ * Distributes the nodes of a list over k segments (eg: one per worker thread) in a single traversal,
+ * either into nearly equal runs of consecutive nodes, or by a selector or hash function of the elements.
+ * No node is copied or reallocated, and the segments can be concatenated back in O(k).
+ **/
+
+/* Functions */
+// Partition
+ds_sll_error_t ds_sll_partitionIntoSegments(ds_sll_t* linkedList, ds_sll_t** segments, int k, int length);
+ds_sll_error_t ds_sll_partitionBySelector(ds_sll_t* linkedList, ds_sll_t** segments, int k, int (*selectFunc)(void*, void*), void* sharedData);
+ds_sll_error_t ds_sll_partitionByHash(ds_sll_t* linkedList, ds_sll_t** segments, int k, size_t (*hashFunc)(void*));
+// Re-concatenate
+void ds_sll_concatenateSegments(ds_sll_t* linkedList, ds_sll_t** segments, int k);
+/* ------------------------------------------------------------------ */
+
+
+/**
+ * @}
+ */
+
+#endif //RM_DS_SLL_SINGLYLINKEDLISTPARTITION_H
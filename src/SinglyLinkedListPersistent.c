@@ -0,0 +1,289 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2017 Ronny Majani
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+/**
+ * @ingroup singlylinkedlist
+ * @file SinglyLinkedListPersistent.c
+ * @brief Persistent (immutable) Singly Linked Lists with structural sharing (ds_sll)
+ *
+ * Category: Data Structures >> Linked Lists
+ * Codename: ds_sll
+ *
+ * ### Usage:
+ * The classic persistent cons-list:
+ * + Snapshot: a new handle on the same nodes, constant time and memory
+ * + Prepend: a new version whose head is a new node pointing at the old head
+ * + Pop Head: a new version starting at the second node of the old version
+ * All versions are immutable, so a snapshot can be read (from any thread) while other versions are derived from it.
+ *
+ * ### Reference Counting:
+ * Each node counts the versions and nodes pointing at it. Releasing a version decrements the count of its head,
+ * and every node whose count drops to zero is freed along with its element, which in turn releases the next node.
+ * Counts are updated atomically, so versions sharing nodes can be released from different threads.
+ **/
+
+#include "SinglyLinkedListPersistent.h"
+#include <assert.h>
+
+/**
+ * @brief Macro definition for ASSERT
+ * Used to enforce Design by Contract coding
+ * Typically disabled on release
+ */
+#define ASSERT assert
+
+
+/**
+ * @brief Add a reference to a node
+ * @param node The node (may be NULL)
+ */
+static inline void ds_sll_persistentRetainNode(ds_sll_node_t* node)
+{
+    if(node != NULL) {
+        __atomic_add_fetch(&((ds_sll_persistent_node_t*) node)->refcount, 1, __ATOMIC_RELAXED);
+    }
+}
+
+
+/**
+ * @brief Drop a reference to a node, freeing it and any following node that is no longer referenced
+ * @param node The node (may be NULL)
+ */
+static void ds_sll_persistentReleaseNode(ds_sll_node_t* node)
+{
+    while(node != NULL) {
+        ds_sll_persistent_node_t* shared = (ds_sll_persistent_node_t*) node;
+
+        if(__atomic_sub_fetch(&shared->refcount, 1, __ATOMIC_ACQ_REL) != 0) {
+            return;
+        }
+
+        // last reference: free the node and drop its reference to the next one
+        node = ds_sll_nextNode(node);
+        ds_sll_deleteElement(&shared->node.element);
+        free(shared);
+    }
+}
+
+
+/**
+ * @brief Allocate a new version handle
+ * @param head The first node of the version (its reference is transferred to the version)
+ * @param length The number of nodes in the version
+ * @return The new version, or NULL if an error occurred
+ */
+static ds_sll_persistent_t* ds_sll_persistentNewVersion(ds_sll_node_t* head, int length)
+{
+    ds_sll_persistent_t* version = (ds_sll_persistent_t*) malloc(sizeof(ds_sll_persistent_t));
+
+    if(version == NULL) {
+        return NULL;
+    }
+
+    version->head = head;
+    version->length = length;
+    return version;
+}
+
+
+/**
+ * @brief Create a new empty persistent list
+ * @return Returns a pointer to a new empty version, or NULL if an error occurred
+ */
+ds_sll_persistent_t* ds_sll_newPersistentList()
+{
+    return ds_sll_persistentNewVersion(NULL, 0);
+}
+
+
+/**
+ * @brief Take a snapshot of a version, in constant time
+ * @param version The version to snapshot
+ * @return A new handle sharing all the nodes of the given version, or NULL if an error occurred
+ */
+ds_sll_persistent_t* ds_sll_persistentSnapshot(const ds_sll_persistent_t* version)
+{
+    ASSERT(version != NULL);
+    ds_sll_persistent_t* snapshot = ds_sll_persistentNewVersion(version->head, version->length);
+
+    if(snapshot == NULL) {
+        return NULL;
+    }
+
+    ds_sll_persistentRetainNode(version->head);
+    return snapshot;
+}
+
+
+/**
+ * @brief Release a version, free the nodes only it was referencing, and set the version pointer to NULL
+ * @param version Pointer to the version to release
+ */
+void ds_sll_persistentRelease(ds_sll_persistent_t** version)
+{
+    ASSERT(version != NULL);
+
+    if(*version != NULL) {
+        ds_sll_persistentReleaseNode((*version)->head);
+        free(*version);
+        *version = NULL;
+    }
+}
+
+
+/**
+ * @brief Create a new version with the given element in front of the given version
+ * @param version The version to prepend to (left unchanged)
+ * @param element The element to store in the new head. It is owned by the new node from now on
+ * @return The new version (sharing all the nodes of the given version), or NULL if an error occurred
+ */
+ds_sll_persistent_t* ds_sll_persistentPrependElement(const ds_sll_persistent_t* version, void* element)
+{
+    ASSERT(version != NULL);
+    ds_sll_persistent_node_t* new_node = (ds_sll_persistent_node_t*) malloc(sizeof(ds_sll_persistent_node_t));
+
+    if(new_node == NULL) {
+        return NULL;
+    }
+
+    ds_sll_persistent_t* new_version = ds_sll_persistentNewVersion(&new_node->node, version->length + 1);
+
+    if(new_version == NULL) {
+        free(new_node);
+        return NULL;
+    }
+
+    ds_sll_storeElementInNode(&new_node->node, element);
+    new_node->node.next = version->head;
+    new_node->refcount = 1; // referenced by the new version
+    ds_sll_persistentRetainNode(version->head); // now also referenced by the new node
+    return new_version;
+}
+
+
+/**
+ * @brief Create a new version with a copy of the given element in front of the given version
+ * @param version The version to prepend to (left unchanged)
+ * @param element The element to copy into the new head
+ * @param element_size The size (in bytes) of the given element
+ * @return The new version (sharing all the nodes of the given version), or NULL if an error occurred
+ */
+ds_sll_persistent_t* ds_sll_persistentPrependElementCopy(const ds_sll_persistent_t* version, void* element, const size_t element_size)
+{
+    ASSERT(version != NULL);
+    void* copy = ds_sll_copyElement(element, element_size);
+
+    if(copy == NULL) {
+        return NULL;
+    }
+
+    ds_sll_persistent_t* new_version = ds_sll_persistentPrependElement(version, copy);
+
+    if(new_version == NULL) {
+        ds_sll_deleteElement(&copy);
+    }
+    return new_version;
+}
+
+
+/**
+ * @brief Create a new version without the head of the given version, in constant time
+ * @param version The version to pop the head of (left unchanged, must not be empty)
+ * @return The new version (sharing all but the first node of the given version), or NULL if an error occurred
+ */
+ds_sll_persistent_t* ds_sll_persistentPopHead(const ds_sll_persistent_t* version)
+{
+    ASSERT((version != NULL) && (version->head != NULL));
+    ds_sll_node_t* second = ds_sll_nextNode(version->head);
+    ds_sll_persistent_t* new_version = ds_sll_persistentNewVersion(second, version->length - 1);
+
+    if(new_version == NULL) {
+        return NULL;
+    }
+
+    ds_sll_persistentRetainNode(second);
+    return new_version;
+}
+
+
+/**
+ * @brief Get the element stored in the head of a version
+ * @param version The version to read
+ * @return The element of the first node, or NULL if the version is empty
+ */
+void* ds_sll_persistentHeadElement(const ds_sll_persistent_t* version)
+{
+    ASSERT(version != NULL);
+    return (version->head == NULL) ? NULL : ds_sll_extractElementFromNode(version->head);
+}
+
+
+/**
+ * @brief Get the element contained in the node at the given index of a version
+ * @param version The version to read
+ * @param index The index of the node you want to get (starting with 0)
+ * @return The element contained by the node at the given index, or NULL if the index is out of bounds
+ */
+void* ds_sll_persistentGetElementAtIndex(const ds_sll_persistent_t* version, int index)
+{
+    ASSERT((version != NULL) && (index >= 0));
+
+    if(index >= version->length) {
+        return NULL;
+    }
+
+    ds_sll_node_t* curr = version->head;
+    while(index-- != 0) {
+        curr = ds_sll_nextNode(curr);
+    }
+    return ds_sll_extractElementFromNode(curr);
+}
+
+
+/**
+ * @brief Executes a function on each element of a version in order
+ * @param version The version to map the function to
+ * @param func A function to execute on each element (see @ref ds_sll_executeFunctionOnElements).
+ *        It must not modify the nodes or the elements, they may be shared with other versions
+ * @param sharedData A pointer that is passed to your function
+ * @return -1 if no error occurred; the index of the node where the error occurred at otherwise.
+ */
+int ds_sll_persistentExecuteFunctionOnElements(const ds_sll_persistent_t* version, ds_sll_func_return_t (*func)(void*, ds_sll_node_t*, int, void*), void *sharedData)
+{
+    ASSERT((version != NULL) && (func != NULL));
+
+    int index = 0;
+    ds_sll_node_t* curr;
+
+    for(curr = version->head; curr != NULL; curr = ds_sll_nextNode(curr), index++) {
+        ds_sll_func_return_t returncode = func(ds_sll_extractElementFromNode(curr), curr, index, sharedData);
+        if(returncode == DS_SLL_EXECUTION_ERROR) {
+            return index;
+        } else if(returncode == DS_SLL_STOP_EXECUTION) {
+            return -1;
+        }
+    }
+
+    return -1;
+}
@@ -0,0 +1,87 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2017 Ronny Majani
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#ifndef RM_DS_SLL_SINGLYLINKEDLISTPERSISTENT_H
+#define RM_DS_SLL_SINGLYLINKEDLISTPERSISTENT_H
+
+#include "SinglyLinkedList.h"
+
+/**
+ * @ingroup singlylinkedlist
+ * @{
+ */
+
+/**
+ * @file SinglyLinkedListPersistent.h
+ * @brief Persistent (immutable) Singly Linked Lists with structural sharing (Header) (ds_sll)
+ *
+ * A persistent list is never modified in place. Prepending to or popping the head of a version
+ * produces a new version that shares all the remaining nodes with the old one, and taking a snapshot
+ * of a version is a constant time operation. Nodes are reference counted and freed (along with their
+ * element) once the last version or node referencing them is released.
+ **/
+
+/* Datatype definitions */
+/**
+ * Reference counted node of a persistent list.
+ * The embedded @ref ds_sll_node_t comes first, so nodes can be traversed with @ref ds_sll_nextNode
+ * and read with @ref ds_sll_extractElementFromNode like any other node. They must never be modified.
+ */
+typedef struct ds_sll_persistent_node_t {
+    ds_sll_node_t node; /**< The element and the link to the next (shared) node */
+    int refcount; /**< Number of versions and nodes pointing to this node. Accessed atomically */
+} ds_sll_persistent_node_t;
+
+/**
+ * A version of a persistent list.
+ * Versions are independent handles: releasing one never affects the others.
+ */
+typedef struct ds_sll_persistent_t {
+    ds_sll_node_t* head; /**< pointer to the first node of this version, NULL if empty */
+    int length; /**< number of nodes in this version */
+} ds_sll_persistent_t;
+/* ------------------------------------------------------------------ */
+
+
+/* Functions */
+// Create/Delete
+ds_sll_persistent_t* ds_sll_newPersistentList();
+ds_sll_persistent_t* ds_sll_persistentSnapshot(const ds_sll_persistent_t* version);
+void ds_sll_persistentRelease(ds_sll_persistent_t** version);
+// New Versions
+ds_sll_persistent_t* ds_sll_persistentPrependElement(const ds_sll_persistent_t* version, void* element);
+ds_sll_persistent_t* ds_sll_persistentPrependElementCopy(const ds_sll_persistent_t* version, void* element, const size_t element_size);
+ds_sll_persistent_t* ds_sll_persistentPopHead(const ds_sll_persistent_t* version);
+// Retrieval
+void* ds_sll_persistentHeadElement(const ds_sll_persistent_t* version);
+void* ds_sll_persistentGetElementAtIndex(const ds_sll_persistent_t* version, int index);
+int ds_sll_persistentExecuteFunctionOnElements(const ds_sll_persistent_t* version, ds_sll_func_return_t (*func)(void*, ds_sll_node_t*, int, void*), void *sharedData);
+/* ------------------------------------------------------------------ */
+
+
+/**
+ * @}
+ */
+
+#endif //RM_DS_SLL_SINGLYLINKEDLISTPERSISTENT_H
@@ -0,0 +1,515 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2017 Ronny Majani
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+/**
+ * @ingroup singlylinkedlist
+ * @file SinglyLinkedListQueue.c
+ * @brief Bounded blocking multi-producer multi-consumer queue on a Singly Linked List (ds_sll)
+ *
+ * Category: Data Structures >> Linked Lists
+ * Codename: ds_sll
+ *
+ * ### Usage:
+ * + Push/Pop: enqueue at the tail / dequeue from the head, blocking while the queue is full / empty
+ * + Timed variants take a timeout in milliseconds: negative to wait forever, 0 to never wait
+ * + Push Batch: move all the nodes of a list into the queue, waiting for room as needed
+ * + Pop Batch: detach up to k nodes with one lock acquisition, then hand them back with @ref ds_sll_queueRecycleNodes
+ * + Close: wake every waiting thread; pushes fail from now on, pops fail once the queue is drained
+ *
+ * ### Node Recycling:
+ * Dequeued nodes are kept (up to `capacity` of them) and reused by the next pushes, so once a pipeline
+ * reaches its steady state neither side calls malloc or free per item.
+ * Timed waits use the monotonic clock, so they are not affected by changes of the system time.
+ **/
+
+#include "SinglyLinkedListQueue.h"
+#include <assert.h>
+#include <errno.h>
+#include <time.h>
+
+/**
+ * @brief Macro definition for ASSERT
+ * Used to enforce Design by Contract coding
+ * Typically disabled on release
+ */
+#define ASSERT assert
+
+
+/**
+ * @brief Compute the absolute deadline of a timed operation
+ * @param timeout_ms The timeout in milliseconds (only meaningful if positive)
+ * @param deadline Set to the monotonic time at which the operation times out
+ */
+static void ds_sll_queueDeadline(long timeout_ms, struct timespec* deadline)
+{
+    if(timeout_ms <= 0) {
+        return;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, deadline);
+    deadline->tv_sec += timeout_ms / 1000;
+    deadline->tv_nsec += (timeout_ms % 1000) * 1000000L;
+    if(deadline->tv_nsec >= 1000000000L) {
+        deadline->tv_sec++;
+        deadline->tv_nsec -= 1000000000L;
+    }
+}
+
+
+/**
+ * @brief Wait on one of the conditions of the queue (with the queue locked)
+ * @return 0 if woken up, ETIMEDOUT if the operation timed out
+ */
+static int ds_sll_queueWait(ds_sll_queue_t* queue, pthread_cond_t* cond, long timeout_ms, const struct timespec* deadline)
+{
+    if(timeout_ms < 0) {
+        pthread_cond_wait(cond, &queue->lock);
+        return 0;
+    }
+    if(timeout_ms == 0) {
+        return ETIMEDOUT;
+    }
+    return (pthread_cond_timedwait(cond, &queue->lock, deadline) == ETIMEDOUT) ? ETIMEDOUT : 0;
+}
+
+
+/**
+ * @brief Detach up to `max_count` nodes from the front of a list
+ * @param linkedList The list to detach the nodes from
+ * @param max_count The maximum number of nodes to detach (> 0)
+ * @param first Set to the first detached node (NULL if the list is empty)
+ * @param last Set to the last detached node (NULL if the list is empty)
+ * @return The number of detached nodes
+ */
+static int ds_sll_queueCutChain(ds_sll_t* linkedList, int max_count, ds_sll_node_t** first, ds_sll_node_t** last)
+{
+    ds_sll_node_t* node = linkedList->head;
+    int count = 1;
+
+    if(node == NULL) {
+        *first = NULL;
+        *last = NULL;
+        return 0;
+    }
+
+    while((count < max_count) && (node != linkedList->tail)) {
+        node = ds_sll_nextNode(node);
+        count++;
+    }
+
+    *first = linkedList->head;
+    *last = node;
+    if(node == linkedList->tail) {
+        linkedList->head = NULL;
+        linkedList->tail = NULL;
+    } else {
+        linkedList->head = ds_sll_nextNode(node);
+    }
+    node->next = NULL;
+    return count;
+}
+
+
+/**
+ * @brief Append a chain of nodes (see @ref ds_sll_queueCutChain) to the end of a list
+ */
+static void ds_sll_queueAppendChain(ds_sll_t* linkedList, ds_sll_node_t* first, ds_sll_node_t* last)
+{
+    if(linkedList->head == NULL) {
+        linkedList->head = first;
+    } else {
+        linkedList->tail->next = first;
+    }
+    linkedList->tail = last;
+}
+
+
+/**
+ * @brief Keep a dequeued node for reuse (with the queue locked). The node's element is detached, not freed
+ * @return The node if there is no room left to keep it (the caller deletes it), NULL otherwise
+ */
+static ds_sll_node_t* ds_sll_queueKeepNode(ds_sll_queue_t* queue, ds_sll_node_t* node)
+{
+    ds_sll_storeElementInNode(node, NULL);
+    if(queue->free_count >= queue->capacity) {
+        return node;
+    }
+
+    node->next = queue->free_nodes;
+    queue->free_nodes = node;
+    queue->free_count++;
+    return NULL;
+}
+
+
+/**
+ * @brief Create a new empty queue
+ * @param capacity The maximum number of queued elements (> 0)
+ * @return A pointer to the new queue, or NULL if an error occurred
+ */
+ds_sll_queue_t* ds_sll_newQueue(int capacity)
+{
+    ASSERT(capacity > 0);
+    ds_sll_queue_t* queue = (ds_sll_queue_t*) malloc(sizeof(ds_sll_queue_t));
+    pthread_condattr_t attr;
+
+    if(queue == NULL) {
+        return NULL;
+    }
+
+    queue->list.head = NULL;
+    queue->list.tail = NULL;
+    queue->length = 0;
+    queue->capacity = capacity;
+    queue->free_nodes = NULL;
+    queue->free_count = 0;
+    queue->closed = 0;
+
+    if(pthread_mutex_init(&queue->lock, NULL) != 0) {
+        free(queue);
+        return NULL;
+    }
+    if(pthread_condattr_init(&attr) != 0) {
+        pthread_mutex_destroy(&queue->lock);
+        free(queue);
+        return NULL;
+    }
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    if(pthread_cond_init(&queue->not_empty, &attr) != 0) {
+        pthread_condattr_destroy(&attr);
+        pthread_mutex_destroy(&queue->lock);
+        free(queue);
+        return NULL;
+    }
+    if(pthread_cond_init(&queue->not_full, &attr) != 0) {
+        pthread_cond_destroy(&queue->not_empty);
+        pthread_condattr_destroy(&attr);
+        pthread_mutex_destroy(&queue->lock);
+        free(queue);
+        return NULL;
+    }
+
+    pthread_condattr_destroy(&attr);
+    return queue;
+}
+
+
+/**
+ * @brief Destroy a queue, delete the queued nodes (and their elements), free all resources, and set the given pointer to NULL
+ * @param queue_toDelete The queue to destroy. No thread may be using it anymore
+ */
+void ds_sll_destroyQueue(ds_sll_queue_t** queue_toDelete)
+{
+    ASSERT(queue_toDelete != NULL);
+    ds_sll_queue_t* queue = *queue_toDelete;
+    ds_sll_node_t* node;
+
+    if(queue == NULL) {
+        return;
+    }
+
+    while((node = queue->list.head) != NULL) {
+        queue->list.head = ds_sll_nextNode(node);
+        ds_sll_deleteNode(&node);
+    }
+    while((node = queue->free_nodes) != NULL) {
+        queue->free_nodes = ds_sll_nextNode(node);
+        ds_sll_deleteNode(&node);
+    }
+
+    pthread_cond_destroy(&queue->not_full);
+    pthread_cond_destroy(&queue->not_empty);
+    pthread_mutex_destroy(&queue->lock);
+    free(queue);
+    *queue_toDelete = NULL;
+}
+
+
+/**
+ * @brief Close a queue and wake up every waiting thread
+ * @param queue The queue to close
+ *
+ * Pushes fail with DS_SLL_QUEUE_CLOSED_ERROR from now on. Pops keep returning the queued elements,
+ * and fail with DS_SLL_QUEUE_CLOSED_ERROR once the queue is empty.
+ */
+void ds_sll_queueClose(ds_sll_queue_t* queue)
+{
+    ASSERT(queue != NULL);
+
+    pthread_mutex_lock(&queue->lock);
+    queue->closed = 1;
+    pthread_cond_broadcast(&queue->not_empty);
+    pthread_cond_broadcast(&queue->not_full);
+    pthread_mutex_unlock(&queue->lock);
+}
+
+
+/**
+ * @brief Enqueue an element, waiting as long as the queue is full
+ * @param queue The queue
+ * @param element The element to enqueue. It is owned by the queue until it is dequeued
+ * @return @ref ds_sll_error_t Error Code.
+ */
+ds_sll_error_t ds_sll_queuePush(ds_sll_queue_t* queue, void* element)
+{
+    return ds_sll_queuePushTimed(queue, element, -1);
+}
+
+
+/**
+ * @brief Enqueue an element, waiting at most the given time for the queue to have room
+ * @param queue The queue
+ * @param element The element to enqueue. It is owned by the queue until it is dequeued
+ * @param timeout_ms The maximum time to wait in milliseconds: negative to wait forever, 0 to never wait
+ * @return @ref ds_sll_error_t Error Code. DS_SLL_TIMEOUT_ERROR if the queue stayed full
+ */
+ds_sll_error_t ds_sll_queuePushTimed(ds_sll_queue_t* queue, void* element, long timeout_ms)
+{
+    ASSERT(queue != NULL);
+    struct timespec deadline;
+    ds_sll_node_t* node;
+    int timed_out = 0;
+
+    ds_sll_queueDeadline(timeout_ms, &deadline);
+    pthread_mutex_lock(&queue->lock);
+
+    while(!queue->closed && (queue->length >= queue->capacity) && !timed_out) {
+        timed_out = ds_sll_queueWait(queue, &queue->not_full, timeout_ms, &deadline);
+    }
+    if(queue->closed || (queue->length >= queue->capacity)) {
+        pthread_mutex_unlock(&queue->lock);
+        return queue->closed ? DS_SLL_QUEUE_CLOSED_ERROR : DS_SLL_TIMEOUT_ERROR;
+    }
+
+    if(queue->free_nodes != NULL) {
+        node = queue->free_nodes;
+        queue->free_nodes = ds_sll_nextNode(node);
+        queue->free_count--;
+    } else if((node = (ds_sll_node_t*) malloc(sizeof(ds_sll_node_t))) == NULL) {
+        pthread_mutex_unlock(&queue->lock);
+        return DS_SLL_NODE_CREATION_ERROR;
+    }
+
+    ds_sll_storeElementInNode(node, element);
+    node->next = NULL;
+    ds_sll_queueAppendChain(&queue->list, node, node);
+    queue->length++;
+
+    pthread_cond_signal(&queue->not_empty);
+    pthread_mutex_unlock(&queue->lock);
+    return DS_SLL_NO_ERROR;
+}
+
+
+/**
+ * @brief Move all the nodes of a list to the end of the queue, in order, waiting for room as needed
+ * @param queue The queue
+ * @param batch The list of nodes to enqueue (eg: built with @ref ds_sll_appendElement). It is left empty on success
+ * @param timeout_ms The maximum time to wait in milliseconds: negative to wait forever, 0 to never wait
+ * @return @ref ds_sll_error_t Error Code.
+ *
+ * Each time the queue has room, as many nodes as fit are moved with a single lock acquisition.
+ * If the operation times out or the queue is closed, the nodes that were not enqueued are left in `batch`.
+ */
+ds_sll_error_t ds_sll_queuePushBatch(ds_sll_queue_t* queue, ds_sll_t* batch, long timeout_ms)
+{
+    ASSERT((queue != NULL) && (batch != NULL));
+    ds_sll_error_t status = DS_SLL_NO_ERROR;
+    struct timespec deadline;
+    ds_sll_node_t *first, *last;
+    int timed_out = 0, count;
+
+    ds_sll_queueDeadline(timeout_ms, &deadline);
+    pthread_mutex_lock(&queue->lock);
+
+    while(batch->head != NULL) {
+        while(!queue->closed && (queue->length >= queue->capacity) && !timed_out) {
+            timed_out = ds_sll_queueWait(queue, &queue->not_full, timeout_ms, &deadline);
+        }
+        if(queue->closed || (queue->length >= queue->capacity)) {
+            status = queue->closed ? DS_SLL_QUEUE_CLOSED_ERROR : DS_SLL_TIMEOUT_ERROR;
+            break;
+        }
+
+        count = ds_sll_queueCutChain(batch, queue->capacity - queue->length, &first, &last);
+        ds_sll_queueAppendChain(&queue->list, first, last);
+        queue->length += count;
+
+        if(count > 1) {
+            pthread_cond_broadcast(&queue->not_empty);
+        } else {
+            pthread_cond_signal(&queue->not_empty);
+        }
+    }
+
+    pthread_mutex_unlock(&queue->lock);
+    return status;
+}
+
+
+/**
+ * @brief Dequeue an element, waiting as long as the queue is empty
+ * @param queue The queue
+ * @param element Set to the dequeued element, which is owned by the caller from now on
+ * @return @ref ds_sll_error_t Error Code.
+ */
+ds_sll_error_t ds_sll_queuePop(ds_sll_queue_t* queue, void** element)
+{
+    return ds_sll_queuePopTimed(queue, element, -1);
+}
+
+
+/**
+ * @brief Dequeue an element, waiting at most the given time for the queue to have one
+ * @param queue The queue
+ * @param element Set to the dequeued element, which is owned by the caller from now on
+ * @param timeout_ms The maximum time to wait in milliseconds: negative to wait forever, 0 to never wait
+ * @return @ref ds_sll_error_t Error Code. DS_SLL_TIMEOUT_ERROR if the queue stayed empty
+ */
+ds_sll_error_t ds_sll_queuePopTimed(ds_sll_queue_t* queue, void** element, long timeout_ms)
+{
+    ASSERT((queue != NULL) && (element != NULL));
+    struct timespec deadline;
+    ds_sll_node_t *node, *unkept;
+    int timed_out = 0;
+
+    ds_sll_queueDeadline(timeout_ms, &deadline);
+    pthread_mutex_lock(&queue->lock);
+
+    while(!queue->closed && (queue->length == 0) && !timed_out) {
+        timed_out = ds_sll_queueWait(queue, &queue->not_empty, timeout_ms, &deadline);
+    }
+    if(queue->length == 0) {
+        pthread_mutex_unlock(&queue->lock);
+        return queue->closed ? DS_SLL_QUEUE_CLOSED_ERROR : DS_SLL_TIMEOUT_ERROR;
+    }
+
+    ds_sll_queueCutChain(&queue->list, 1, &node, &node);
+    queue->length--;
+    *element = ds_sll_extractElementFromNode(node);
+    unkept = ds_sll_queueKeepNode(queue, node);
+
+    pthread_cond_signal(&queue->not_full);
+    pthread_mutex_unlock(&queue->lock);
+
+    ds_sll_deleteNode(&unkept);
+    return DS_SLL_NO_ERROR;
+}
+
+
+/**
+ * @brief Detach up to `max_count` nodes from the front of the queue with a single lock acquisition
+ * @param queue The queue
+ * @param batch The list to append the detached nodes to, in queue order. Their elements are owned by the caller
+ * @param max_count The maximum number of nodes to detach (> 0)
+ * @param timeout_ms The maximum time to wait for the queue to have an element in milliseconds: negative to wait forever, 0 to never wait
+ * @return The number of detached nodes, 0 if the operation timed out or the queue is closed and empty
+ *
+ * Once their elements were taken out, hand the nodes back with @ref ds_sll_queueRecycleNodes
+ * so the producers can reuse them.
+ */
+int ds_sll_queuePopBatch(ds_sll_queue_t* queue, ds_sll_t* batch, int max_count, long timeout_ms)
+{
+    ASSERT((queue != NULL) && (batch != NULL) && (max_count > 0));
+    struct timespec deadline;
+    ds_sll_node_t *first, *last;
+    int timed_out = 0, count;
+
+    ds_sll_queueDeadline(timeout_ms, &deadline);
+    pthread_mutex_lock(&queue->lock);
+
+    while(!queue->closed && (queue->length == 0) && !timed_out) {
+        timed_out = ds_sll_queueWait(queue, &queue->not_empty, timeout_ms, &deadline);
+    }
+    if(queue->length == 0) {
+        pthread_mutex_unlock(&queue->lock);
+        return 0;
+    }
+
+    count = ds_sll_queueCutChain(&queue->list, max_count, &first, &last);
+    queue->length -= count;
+
+    if(count > 1) {
+        pthread_cond_broadcast(&queue->not_full);
+    } else {
+        pthread_cond_signal(&queue->not_full);
+    }
+    pthread_mutex_unlock(&queue->lock);
+
+    ds_sll_queueAppendChain(batch, first, last);
+    return count;
+}
+
+
+/**
+ * @brief Hand nodes back to the queue for reuse by later pushes, leaving the given list empty
+ * @param queue The queue
+ * @param nodes A list of nodes (eg: filled by @ref ds_sll_queuePopBatch) whose elements were already taken out.
+ * The elements are not freed
+ *
+ * The queue keeps at most `capacity` spare nodes, the others are freed.
+ */
+void ds_sll_queueRecycleNodes(ds_sll_queue_t* queue, ds_sll_t* nodes)
+{
+    ASSERT((queue != NULL) && (nodes != NULL));
+    ds_sll_node_t* node = nodes->head;
+    ds_sll_node_t* unkept = NULL;
+
+    nodes->head = NULL;
+    nodes->tail = NULL;
+
+    pthread_mutex_lock(&queue->lock);
+    while(node != NULL) {
+        ds_sll_node_t* next = ds_sll_nextNode(node);
+        if(ds_sll_queueKeepNode(queue, node) != NULL) {
+            node->next = unkept;
+            unkept = node;
+        }
+        node = next;
+    }
+    pthread_mutex_unlock(&queue->lock);
+
+    while(unkept != NULL) {
+        node = unkept;
+        unkept = ds_sll_nextNode(node);
+        ds_sll_deleteNode(&node);
+    }
+}
+
+
+/**
+ * @brief Get the number of queued elements
+ * @param queue The queue
+ * @return The number of queued elements (which may change as soon as the function returns)
+ */
+int ds_sll_queueLength(ds_sll_queue_t* queue)
+{
+    ASSERT(queue != NULL);
+    int length;
+
+    pthread_mutex_lock(&queue->lock);
+    length = queue->length;
+    pthread_mutex_unlock(&queue->lock);
+    return length;
+}
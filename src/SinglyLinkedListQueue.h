@@ -0,0 +1,88 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2017 Ronny Majani
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#ifndef RM_DS_SLL_SINGLYLINKEDLISTQUEUE_H
+#define RM_DS_SLL_SINGLYLINKEDLISTQUEUE_H
+
+#include "SinglyLinkedList.h"
+#include <pthread.h>
+
+/**
+ * @ingroup singlylinkedlist
+ * @{
+ */
+
+/**
+ * @file SinglyLinkedListQueue.h
+ * @brief Bounded blocking multi-producer multi-consumer queue on a Singly Linked List (Header) (ds_sll)
+ *
+ * Producers append at the tail and consumers remove from the head of a list guarded by one mutex.
+ * Pushes block while the queue is full and pops block while it is empty, optionally with a timeout.
+ * Batched operations move whole chains of nodes with a single lock acquisition, and the nodes freed by
+ * consumers are kept for the producers to reuse, so a steady pipeline does not allocate per item.
+ **/
+
+/* Datatype definitions */
+/**
+ * Bounded blocking queue datatype
+ */
+typedef struct ds_sll_queue_t {
+    ds_sll_t list; /**< The queued elements, the front of the queue is the head */
+    int length; /**< Number of queued elements */
+    int capacity; /**< Maximum number of queued elements */
+    ds_sll_node_t* free_nodes; /**< Recycled nodes (holding no element), linked through their `next` pointer */
+    int free_count; /**< Number of recycled nodes, at most `capacity` */
+    int closed; /**< Set once the queue is closed */
+    pthread_mutex_t lock; /**< Guards every field above */
+    pthread_cond_t not_empty; /**< Signaled when elements are queued or the queue is closed */
+    pthread_cond_t not_full; /**< Signaled when elements are dequeued or the queue is closed */
+} ds_sll_queue_t;
+/* ------------------------------------------------------------------ */
+
+
+/* Functions */
+// Create/Delete
+ds_sll_queue_t* ds_sll_newQueue(int capacity);
+void ds_sll_destroyQueue(ds_sll_queue_t** queue_toDelete);
+void ds_sll_queueClose(ds_sll_queue_t* queue);
+// Enqueue
+ds_sll_error_t ds_sll_queuePush(ds_sll_queue_t* queue, void* element);
+ds_sll_error_t ds_sll_queuePushTimed(ds_sll_queue_t* queue, void* element, long timeout_ms);
+ds_sll_error_t ds_sll_queuePushBatch(ds_sll_queue_t* queue, ds_sll_t* batch, long timeout_ms);
+// Dequeue
+ds_sll_error_t ds_sll_queuePop(ds_sll_queue_t* queue, void** element);
+ds_sll_error_t ds_sll_queuePopTimed(ds_sll_queue_t* queue, void** element, long timeout_ms);
+int ds_sll_queuePopBatch(ds_sll_queue_t* queue, ds_sll_t* batch, int max_count, long timeout_ms);
+// Node Recycling
+void ds_sll_queueRecycleNodes(ds_sll_queue_t* queue, ds_sll_t* nodes);
+// Retrieval
+int ds_sll_queueLength(ds_sll_queue_t* queue);
+/* ------------------------------------------------------------------ */
+
+
+/**
+ * @}
+ */
+
+#endif //RM_DS_SLL_SINGLYLINKEDLISTQUEUE_H
@@ -0,0 +1,275 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2017 Ronny Majani
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+/**
+ * @ingroup singlylinkedlist
+ * @file SinglyLinkedListReclaimer.c
+ * @brief Background destruction of Singly Linked Lists (ds_sll)
+ *
+ * Category: Data Structures >> Linked Lists
+ * Codename: ds_sll
+ *
+ * ### Usage:
+ * Create one reclaimer with @ref ds_sll_newReclaimer and destroy large lists with
+ * @ref ds_sll_destroySinglyLinkedListAsync instead of @ref ds_sll_destroySinglyLinkedList.
+ * The list's chain of nodes is detached in constant time and appended to the reclaimer's pending chain,
+ * the background thread then frees the nodes (and their elements) `batch_size` at a time, yielding the CPU
+ * between batches. Call @ref ds_sll_reclaimerDrain to wait for the backlog to be freed (eg: before exiting),
+ * and @ref ds_sll_destroyReclaimer to drain and stop the background thread.
+ **/
+
+#include "SinglyLinkedListReclaimer.h"
+#include "SinglyLinkedListTrace.h"
+#include <assert.h>
+#include <sched.h>
+
+/**
+ * @brief Macro definition for ASSERT
+ * Used to enforce Design by Contract coding
+ * Typically disabled on release
+ */
+#define ASSERT assert
+
+/**
+ * @brief Batch size used when 0 is passed to @ref ds_sll_newReclaimer
+ */
+#define DS_SLL_RECLAIMER_DEFAULT_BATCH_SIZE 4096
+
+
+/**
+ * @brief Main loop of the background thread
+ * @param arg The reclaimer
+ * @return NULL
+ *
+ * Takes the whole pending chain at once, then frees it in batches without holding the lock,
+ * publishing the progress after every batch.
+ */
+static void* ds_sll_reclaimerThread(void* arg)
+{
+    ds_sll_reclaimer_t* reclaimer = (ds_sll_reclaimer_t*) arg;
+
+    pthread_mutex_lock(&reclaimer->lock);
+    for(;;) {
+        while((reclaimer->pending_head == NULL) && !reclaimer->stop) {
+            pthread_cond_broadcast(&reclaimer->idle);
+            pthread_cond_wait(&reclaimer->work_available, &reclaimer->lock);
+        }
+
+        if(reclaimer->pending_head == NULL) { // stopped with no work left
+            break;
+        }
+
+        ds_sll_node_t* chain = reclaimer->pending_head;
+        reclaimer->in_progress_lists = reclaimer->pending_lists;
+        reclaimer->pending_head = NULL;
+        reclaimer->pending_tail = NULL;
+        reclaimer->pending_lists = 0;
+
+        while(chain != NULL) {
+            pthread_mutex_unlock(&reclaimer->lock);
+
+            int freed;
+            for(freed = 0; (chain != NULL) && (freed < reclaimer->batch_size); freed++) {
+                ds_sll_node_t* todel = chain;
+                chain = ds_sll_nextNode(chain);
+                ds_sll_deleteNode(&todel);
+            }
+
+            pthread_mutex_lock(&reclaimer->lock);
+            reclaimer->reclaimed_nodes += freed;
+
+            if(chain != NULL) {
+                pthread_mutex_unlock(&reclaimer->lock);
+                sched_yield(); // let the request threads run between batches
+                pthread_mutex_lock(&reclaimer->lock);
+            }
+        }
+
+        reclaimer->reclaimed_lists += reclaimer->in_progress_lists;
+        reclaimer->in_progress_lists = 0;
+    }
+
+    pthread_cond_broadcast(&reclaimer->idle);
+    pthread_mutex_unlock(&reclaimer->lock);
+    return NULL;
+}
+
+
+/**
+ * @brief Create a new reclaimer and start its background thread
+ * @param batch_size The maximum number of nodes freed before the background thread yields the CPU,
+ *        0 for the default (@ref DS_SLL_RECLAIMER_DEFAULT_BATCH_SIZE)
+ * @return A pointer to the new reclaimer, or NULL if an error occurred
+ */
+ds_sll_reclaimer_t* ds_sll_newReclaimer(int batch_size)
+{
+    ASSERT(batch_size >= 0);
+    ds_sll_reclaimer_t* reclaimer = (ds_sll_reclaimer_t*) malloc(sizeof(ds_sll_reclaimer_t));
+
+    if(reclaimer == NULL) {
+        return NULL;
+    }
+
+    reclaimer->pending_head = NULL;
+    reclaimer->pending_tail = NULL;
+    reclaimer->pending_lists = 0;
+    reclaimer->in_progress_lists = 0;
+    reclaimer->reclaimed_lists = 0;
+    reclaimer->reclaimed_nodes = 0;
+    reclaimer->batch_size = (batch_size == 0) ? DS_SLL_RECLAIMER_DEFAULT_BATCH_SIZE : batch_size;
+    reclaimer->stop = 0;
+
+    if(pthread_mutex_init(&reclaimer->lock, NULL) != 0) {
+        free(reclaimer);
+        return NULL;
+    }
+    if(pthread_cond_init(&reclaimer->work_available, NULL) != 0) {
+        pthread_mutex_destroy(&reclaimer->lock);
+        free(reclaimer);
+        return NULL;
+    }
+    if(pthread_cond_init(&reclaimer->idle, NULL) != 0) {
+        pthread_cond_destroy(&reclaimer->work_available);
+        pthread_mutex_destroy(&reclaimer->lock);
+        free(reclaimer);
+        return NULL;
+    }
+    if(pthread_create(&reclaimer->thread, NULL, ds_sll_reclaimerThread, reclaimer) != 0) {
+        pthread_cond_destroy(&reclaimer->idle);
+        pthread_cond_destroy(&reclaimer->work_available);
+        pthread_mutex_destroy(&reclaimer->lock);
+        free(reclaimer);
+        return NULL;
+    }
+
+    return reclaimer;
+}
+
+
+/**
+ * @brief Free everything that is pending, stop the background thread, free the reclaimer, and set the pointer to NULL
+ * @param reclaimer_toDelete Pointer to the reclaimer to destroy
+ */
+void ds_sll_destroyReclaimer(ds_sll_reclaimer_t** reclaimer_toDelete)
+{
+    ds_sll_reclaimer_t* reclaimer = *reclaimer_toDelete;
+
+    if(reclaimer == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&reclaimer->lock);
+    reclaimer->stop = 1;
+    pthread_cond_signal(&reclaimer->work_available);
+    pthread_mutex_unlock(&reclaimer->lock);
+
+    pthread_join(reclaimer->thread, NULL); // the thread frees the remaining backlog before exiting
+
+    pthread_cond_destroy(&reclaimer->idle);
+    pthread_cond_destroy(&reclaimer->work_available);
+    pthread_mutex_destroy(&reclaimer->lock);
+    free(reclaimer);
+    *reclaimer_toDelete = NULL;
+}
+
+
+/**
+ * @brief Destroy a Singly Linked List in the background
+ * @param reclaimer The reclaimer that will free the nodes
+ * @param linkedList_toDelete A pointer to the singly linked list to destroy
+ * @return @ref ds_sll_error_t Error code representing the status of the function
+ *
+ * Detaches the list's chain of nodes and hands it to the reclaimer in constant time,
+ * frees the list header, and sets the given pointer to NULL.
+ * The nodes and their elements are freed later by the reclaimer's background thread.
+ * Warning, do not use this function if you are sharing any nodes with another list
+ * that is currently in use
+ */
+ds_sll_error_t ds_sll_destroySinglyLinkedListAsync(ds_sll_reclaimer_t* reclaimer, ds_sll_t** linkedList_toDelete)
+{
+    ASSERT((reclaimer != NULL) && (linkedList_toDelete != NULL));
+    // recorded like ds_sll_destroySinglyLinkedList, which also forgets the list's trace id before the header is freed
+    DS_SLL_TRACE(DS_SLL_TRACE_DESTROY_LIST, *linkedList_toDelete, NULL, 0, 0);
+    ds_sll_t* linkedList = *linkedList_toDelete;
+
+    if(linkedList == NULL) {
+        return DS_SLL_NO_ERROR;
+    }
+
+    if(linkedList->head != NULL) {
+        ASSERT(linkedList->tail != NULL);
+        linkedList->tail->next = NULL;
+
+        pthread_mutex_lock(&reclaimer->lock);
+        if(reclaimer->pending_head == NULL) {
+            reclaimer->pending_head = linkedList->head;
+        } else {
+            reclaimer->pending_tail->next = linkedList->head;
+        }
+        reclaimer->pending_tail = linkedList->tail;
+        reclaimer->pending_lists++;
+        pthread_cond_signal(&reclaimer->work_available);
+        pthread_mutex_unlock(&reclaimer->lock);
+    }
+
+    free(linkedList);
+    *linkedList_toDelete = NULL;
+    return DS_SLL_NO_ERROR;
+}
+
+
+/**
+ * @brief Wait until every list handed to the reclaimer so far has been freed
+ * @param reclaimer The reclaimer to drain
+ */
+void ds_sll_reclaimerDrain(ds_sll_reclaimer_t* reclaimer)
+{
+    ASSERT(reclaimer != NULL);
+
+    pthread_mutex_lock(&reclaimer->lock);
+    while((reclaimer->pending_lists != 0) || (reclaimer->in_progress_lists != 0)) {
+        pthread_cond_wait(&reclaimer->idle, &reclaimer->lock);
+    }
+    pthread_mutex_unlock(&reclaimer->lock);
+}
+
+
+/**
+ * @brief Read the counters of a reclaimer
+ * @param reclaimer The reclaimer to inspect
+ * @return A consistent snapshot of the reclaimer's counters
+ */
+ds_sll_reclaimer_stats_t ds_sll_reclaimerStats(ds_sll_reclaimer_t* reclaimer)
+{
+    ASSERT(reclaimer != NULL);
+    ds_sll_reclaimer_stats_t stats;
+
+    pthread_mutex_lock(&reclaimer->lock);
+    stats.pending_lists = reclaimer->pending_lists + reclaimer->in_progress_lists;
+    stats.reclaimed_lists = reclaimer->reclaimed_lists;
+    stats.reclaimed_nodes = reclaimer->reclaimed_nodes;
+    pthread_mutex_unlock(&reclaimer->lock);
+
+    return stats;
+}
@@ -0,0 +1,91 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2017 Ronny Majani
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#ifndef RM_DS_SLL_SINGLYLINKEDLISTRECLAIMER_H
+#define RM_DS_SLL_SINGLYLINKEDLISTRECLAIMER_H
+
+#include "SinglyLinkedList.h"
+#include <pthread.h>
+
+/**
+ * @ingroup singlylinkedlist
+ * @{
+ */
+
+/**
+ * @file SinglyLinkedListReclaimer.h
+ * @brief Background destruction of Singly Linked Lists (Header) (ds_sll)
+ *
+ * A reclaimer owns a background thread that frees the nodes of destroyed lists in bounded batches,
+ * so destroying a list of millions of nodes costs the calling thread a constant amount of work.
+ **/
+
+/* Datatype definitions */
+/**
+ * Background reclaimer datatype.
+ * Destroyed lists are chained together (tail to head) into a single pending chain, so handing a list
+ * over to the reclaimer does not allocate anything.
+ */
+typedef struct ds_sll_reclaimer_t {
+    pthread_t thread; /**< The background thread freeing the nodes */
+    pthread_mutex_t lock; /**< Guards every field below */
+    pthread_cond_t work_available; /**< Signaled when a list is handed over or the reclaimer is stopped */
+    pthread_cond_t idle; /**< Signaled when the background thread ran out of work */
+    ds_sll_node_t* pending_head; /**< First node of the chain of destroyed lists waiting to be freed */
+    ds_sll_node_t* pending_tail; /**< Last node of the chain of destroyed lists waiting to be freed */
+    long pending_lists; /**< Number of lists in the pending chain */
+    long in_progress_lists; /**< Number of lists the background thread is currently freeing */
+    long reclaimed_lists; /**< Number of lists completely freed so far */
+    long reclaimed_nodes; /**< Number of nodes freed so far */
+    int batch_size; /**< Maximum number of nodes freed before the background thread yields */
+    int stop; /**< Set to ask the background thread to exit */
+} ds_sll_reclaimer_t;
+
+/**
+ * Snapshot of the counters of a reclaimer
+ */
+typedef struct ds_sll_reclaimer_stats_t {
+    long pending_lists; /**< Lists handed over and not completely freed yet (the backlog) */
+    long reclaimed_lists; /**< Lists completely freed */
+    long reclaimed_nodes; /**< Nodes freed */
+} ds_sll_reclaimer_stats_t;
+/* ------------------------------------------------------------------ */
+
+
+/* Functions */
+// Create/Delete
+ds_sll_reclaimer_t* ds_sll_newReclaimer(int batch_size);
+void ds_sll_destroyReclaimer(ds_sll_reclaimer_t** reclaimer_toDelete);
+// Operations
+ds_sll_error_t ds_sll_destroySinglyLinkedListAsync(ds_sll_reclaimer_t* reclaimer, ds_sll_t** linkedList_toDelete);
+void ds_sll_reclaimerDrain(ds_sll_reclaimer_t* reclaimer);
+ds_sll_reclaimer_stats_t ds_sll_reclaimerStats(ds_sll_reclaimer_t* reclaimer);
+/* ------------------------------------------------------------------ */
+
+
+/**
+ * @}
+ */
+
+#endif //RM_DS_SLL_SINGLYLINKEDLISTRECLAIMER_H
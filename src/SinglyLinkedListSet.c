@@ -0,0 +1,351 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2017 Ronny Majani
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+/**
+ * @ingroup singlylinkedlist
+ * @file SinglyLinkedListSet.c
+ * @brief Hash based deduplication and set operations on Singly Linked Lists (ds_sll)
+ *
+ * Category: Data Structures >> Linked Lists
+ * Codename: ds_sll
+ *
+ * ### Usage:
+ * + Dedupe: drop every element equal to an earlier one
+ * + Union: dedupe the first list, then move over the elements of the second list it does not contain yet
+ * + Intersection: dedupe the first list, keeping only the elements the second list contains
+ * + Difference: dedupe the first list, keeping only the elements the second list does not contain
+ * The result is always left in the first list. Dropped nodes are freed along with their elements.
+ *
+ * ### Implementation:
+ * Every operation allocates an open addressing hash table (linear probing, at most half full) sized
+ * for all the elements involved before touching any list, so a failed allocation leaves the lists unchanged.
+ * Each slot caches the element's hash, so the equality function is only called on hash matches.
+ **/
+
+#include "SinglyLinkedListSet.h"
+#include "SinglyLinkedListTrace.h"
+#include <assert.h>
+#include <stdint.h>
+
+/**
+ * @brief Macro definition for ASSERT
+ * Used to enforce Design by Contract coding
+ * Typically disabled on release
+ */
+#define ASSERT assert
+
+
+/**
+ * A slot of the hash table
+ */
+typedef struct ds_sll_set_slot_t {
+    void* element; /**< The element stored in this slot */
+    size_t hash; /**< The (mixed) hash of the element */
+    int used; /**< 1 if the slot holds an element */
+} ds_sll_set_slot_t;
+
+/**
+ * Hash table of elements used by the set operations
+ */
+typedef struct ds_sll_set_t {
+    ds_sll_set_slot_t* slots; /**< The slots, a power of two of them */
+    size_t mask; /**< Number of slots - 1 */
+} ds_sll_set_t;
+
+
+/**
+ * @brief Allocate an empty hash table
+ * @param set The table to initialize
+ * @param count The number of elements that will be added to the table
+ * @return @ref ds_sll_error_t Error Code.
+ */
+static ds_sll_error_t ds_sll_setInit(ds_sll_set_t* set, size_t count)
+{
+    size_t capacity = 16;
+
+    while(capacity < 2 * count) {
+        capacity <<= 1;
+    }
+
+    set->slots = (ds_sll_set_slot_t*) calloc(capacity, sizeof(ds_sll_set_slot_t));
+    set->mask = capacity - 1;
+    return (set->slots == NULL) ? DS_SLL_MEMORY_ALLOCATION_ERROR : DS_SLL_NO_ERROR;
+}
+
+
+/**
+ * @brief Count the nodes of a list (which may be empty)
+ */
+static size_t ds_sll_setCountNodes(const ds_sll_t* linkedList)
+{
+    size_t count = 0;
+    ds_sll_node_t* node;
+
+    for(node = linkedList->head; node != NULL; node = ds_sll_nextNode(node)) {
+        count++;
+    }
+    return count;
+}
+
+
+/**
+ * @brief Hash an element and spread the bits of the result, so weak user hashes (eg: the identity) probe well
+ */
+static inline size_t ds_sll_setHash(void* element, size_t (*hashFunc)(void*))
+{
+    size_t hash = hashFunc(element);
+
+    hash ^= hash >> 16;
+    hash *= 0x45d9f3bu;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+
+/**
+ * @brief Add an element to a table unless an equal element is already in it
+ * @return 1 if the element was added, 0 if an equal element was found
+ */
+static int ds_sll_setAdd(ds_sll_set_t* set, void* element, size_t hash, int (*equalityFunc)(void*, void*))
+{
+    size_t i = hash & set->mask;
+
+    while(set->slots[i].used) {
+        if((set->slots[i].hash == hash) && equalityFunc(set->slots[i].element, element)) {
+            return 0;
+        }
+        i = (i + 1) & set->mask;
+    }
+
+    set->slots[i].element = element;
+    set->slots[i].hash = hash;
+    set->slots[i].used = 1;
+    return 1;
+}
+
+
+/**
+ * @brief Check whether a table contains an element equal to the given one
+ * @return 1 if an equal element was found, 0 otherwise
+ */
+static int ds_sll_setContains(const ds_sll_set_t* set, void* element, size_t hash, int (*equalityFunc)(void*, void*))
+{
+    size_t i = hash & set->mask;
+
+    while(set->slots[i].used) {
+        if((set->slots[i].hash == hash) && equalityFunc(set->slots[i].element, element)) {
+            return 1;
+        }
+        i = (i + 1) & set->mask;
+    }
+
+    return 0;
+}
+
+
+/**
+ * @brief Drop the duplicates of a list and, optionally, the elements that are (not) in another table
+ * @param linkedList The list to filter
+ * @param seen An empty table, receives the first occurrence of every kept element
+ * @param other A table to look the elements up in, or NULL to only drop duplicates
+ * @param keepIfInOther 1 to keep only the elements found in `other`, 0 to keep only the ones missing from it
+ */
+static void ds_sll_setFilter(ds_sll_t* linkedList, ds_sll_set_t* seen, const ds_sll_set_t* other, int keepIfInOther,
+                             size_t (*hashFunc)(void*), int (*equalityFunc)(void*, void*))
+{
+    // the deletes are part of the set operation, not calls of their own: keep them out of the trace
+    DS_SLL_TRACE(DS_SLL_TRACE_NONE, NULL, NULL, 0, 0);
+    ds_sll_node_t* prev = NULL;
+    ds_sll_node_t* node = linkedList->head;
+
+    while(node != NULL) {
+        ds_sll_node_t* next = ds_sll_nextNode(node);
+        void* element = ds_sll_extractElementFromNode(node);
+        size_t hash = ds_sll_setHash(element, hashFunc);
+
+        // only kept elements go into `seen`, the others are freed right away
+        if(((other == NULL) || (ds_sll_setContains(other, element, hash, equalityFunc) == keepIfInOther))
+           && ds_sll_setAdd(seen, element, hash, equalityFunc)) {
+            prev = node;
+        } else {
+            ds_sll_deleteNodeAfter(linkedList, prev);
+        }
+        node = next;
+    }
+}
+
+
+/**
+ * @brief Shared implementation of the intersection and the difference
+ */
+static ds_sll_error_t ds_sll_setFilterByList(ds_sll_t* firstLinkedList, const ds_sll_t* secondLinkedList, int keepIfInSecond,
+                                             size_t (*hashFunc)(void*), int (*equalityFunc)(void*, void*))
+{
+    ASSERT((firstLinkedList != NULL) && (secondLinkedList != NULL) && (hashFunc != NULL) && (equalityFunc != NULL));
+    ds_sll_set_t seen, other;
+    ds_sll_node_t* node;
+
+    if(ds_sll_setInit(&seen, ds_sll_setCountNodes(firstLinkedList)) != DS_SLL_NO_ERROR) {
+        return DS_SLL_MEMORY_ALLOCATION_ERROR;
+    }
+    if(ds_sll_setInit(&other, ds_sll_setCountNodes(secondLinkedList)) != DS_SLL_NO_ERROR) {
+        free(seen.slots);
+        return DS_SLL_MEMORY_ALLOCATION_ERROR;
+    }
+
+    for(node = secondLinkedList->head; node != NULL; node = ds_sll_nextNode(node)) {
+        void* element = ds_sll_extractElementFromNode(node);
+        ds_sll_setAdd(&other, element, ds_sll_setHash(element, hashFunc), equalityFunc);
+    }
+
+    ds_sll_setFilter(firstLinkedList, &seen, &other, keepIfInSecond, hashFunc, equalityFunc);
+
+    free(other.slots);
+    free(seen.slots);
+    return DS_SLL_NO_ERROR;
+}
+
+
+/**
+ * @brief Remove every element that is equal to an earlier element of the list, in expected linear time
+ * @param linkedList The singly linked list to deduplicate
+ * @param hashFunc A function returning the hash of an element. Equal elements must have equal hashes
+ * @param equalityFunc A function that returns 1 if two elements are equal, 0 otherwise
+ * @return @ref ds_sll_error_t Error Code.
+ *
+ * The first occurrence of every element is kept in its original position, the other nodes are deleted
+ * (along with their elements). On error the list is left unchanged.
+ */
+ds_sll_error_t ds_sll_setDedupe(ds_sll_t* linkedList, size_t (*hashFunc)(void*), int (*equalityFunc)(void*, void*))
+{
+    ASSERT((linkedList != NULL) && (hashFunc != NULL) && (equalityFunc != NULL));
+    ds_sll_set_t seen;
+
+    if(ds_sll_setInit(&seen, ds_sll_setCountNodes(linkedList)) != DS_SLL_NO_ERROR) {
+        return DS_SLL_MEMORY_ALLOCATION_ERROR;
+    }
+
+    ds_sll_setFilter(linkedList, &seen, NULL, 0, hashFunc, equalityFunc);
+
+    free(seen.slots);
+    return DS_SLL_NO_ERROR;
+}
+
+
+/**
+ * @brief Store the union of two lists in the first one, in expected linear time
+ * @param firstLinkedList A singly linked list, receives the distinct elements of both lists
+ * @param secondLinkedList A singly linked list. It is left empty (head and tail set to NULL)
+ * @param hashFunc A function returning the hash of an element. Equal elements must have equal hashes
+ * @param equalityFunc A function that returns 1 if two elements are equal, 0 otherwise
+ * @return @ref ds_sll_error_t Error Code.
+ *
+ * The result holds the first occurrence of every element of the first list, followed by the first occurrence
+ * of every element of the second list that is not in the first one, all in their original order.
+ * The kept nodes of the second list are moved (not copied), the other nodes of both lists are deleted.
+ * On error both lists are left unchanged.
+ */
+ds_sll_error_t ds_sll_setUnion(ds_sll_t* firstLinkedList, ds_sll_t* secondLinkedList, size_t (*hashFunc)(void*), int (*equalityFunc)(void*, void*))
+{
+    ASSERT((firstLinkedList != NULL) && (secondLinkedList != NULL) && (firstLinkedList != secondLinkedList));
+    ASSERT((hashFunc != NULL) && (equalityFunc != NULL));
+    DS_SLL_TRACE(DS_SLL_TRACE_NONE, NULL, NULL, 0, 0);
+    ds_sll_set_t seen;
+    ds_sll_node_t* node;
+
+    if(ds_sll_setInit(&seen, ds_sll_setCountNodes(firstLinkedList) + ds_sll_setCountNodes(secondLinkedList)) != DS_SLL_NO_ERROR) {
+        return DS_SLL_MEMORY_ALLOCATION_ERROR;
+    }
+
+    ds_sll_setFilter(firstLinkedList, &seen, NULL, 0, hashFunc, equalityFunc);
+
+    while((node = ds_sll_popHeadNode(secondLinkedList)) != NULL) {
+        void* element = ds_sll_extractElementFromNode(node);
+
+        if(ds_sll_setAdd(&seen, element, ds_sll_setHash(element, hashFunc), equalityFunc)) {
+            ds_sll_appendNode(firstLinkedList, node);
+        } else {
+            ds_sll_deleteNode(&node);
+        }
+    }
+
+    free(seen.slots);
+    return DS_SLL_NO_ERROR;
+}
+
+
+/**
+ * @brief Keep only the distinct elements of the first list that are also in the second list, in expected linear time
+ * @param firstLinkedList A singly linked list, receives the intersection of both lists
+ * @param secondLinkedList A singly linked list (left unchanged)
+ * @param hashFunc A function returning the hash of an element. Equal elements must have equal hashes
+ * @param equalityFunc A function that returns 1 if two elements are equal, 0 otherwise
+ * @return @ref ds_sll_error_t Error Code.
+ *
+ * The first occurrence of every kept element stays in its original position, the other nodes of the
+ * first list are deleted (along with their elements). On error the list is left unchanged.
+ */
+ds_sll_error_t ds_sll_setIntersection(ds_sll_t* firstLinkedList, const ds_sll_t* secondLinkedList, size_t (*hashFunc)(void*), int (*equalityFunc)(void*, void*))
+{
+    return ds_sll_setFilterByList(firstLinkedList, secondLinkedList, 1, hashFunc, equalityFunc);
+}
+
+
+/**
+ * @brief Keep only the distinct elements of the first list that are not in the second list, in expected linear time
+ * @param firstLinkedList A singly linked list, receives the difference of both lists
+ * @param secondLinkedList A singly linked list (left unchanged)
+ * @param hashFunc A function returning the hash of an element. Equal elements must have equal hashes
+ * @param equalityFunc A function that returns 1 if two elements are equal, 0 otherwise
+ * @return @ref ds_sll_error_t Error Code.
+ *
+ * The first occurrence of every kept element stays in its original position, the other nodes of the
+ * first list are deleted (along with their elements). On error the list is left unchanged.
+ */
+ds_sll_error_t ds_sll_setDifference(ds_sll_t* firstLinkedList, const ds_sll_t* secondLinkedList, size_t (*hashFunc)(void*), int (*equalityFunc)(void*, void*))
+{
+    return ds_sll_setFilterByList(firstLinkedList, secondLinkedList, 0, hashFunc, equalityFunc);
+}
+
+
+/**
+ * @brief Hash a block of memory (FNV-1a), eg: to write the hash function of fixed size elements
+ * @param data The bytes to hash
+ * @param size The number of bytes
+ * @return The hash of the bytes
+ */
+size_t ds_sll_hashBytes(const void* data, size_t size)
+{
+    ASSERT((data != NULL) || (size == 0));
+    const unsigned char* bytes = (const unsigned char*) data;
+    uint64_t hash = 14695981039346656037ull;
+    size_t i;
+
+    for(i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+
+    return (size_t) (hash ^ (hash >> 32));
+}
@@ -0,0 +1,60 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2017 Ronny Majani
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#ifndef RM_DS_SLL_SINGLYLINKEDLISTSET_H
+#define RM_DS_SLL_SINGLYLINKEDLISTSET_H
+
+#include "SinglyLinkedList.h"
+
+/**
+ * @ingroup singlylinkedlist
+ * @{
+ */
+
+/**
+ * @file SinglyLinkedListSet.h
+ * @brief Hash based deduplication and set operations on Singly Linked Lists (Header) (ds_sll)
+ *
+ * The operations treat lists as sets of elements, compared with a user given equality function
+ * and hashed with a user given hash function (equal elements must have equal hashes).
+ * They run in expected linear time, keep the first occurrence of every element in its original order,
+ * and free the dropped nodes (along with their elements) while traversing the list.
+ **/
+
+/* Functions */
+// Set Operations
+ds_sll_error_t ds_sll_setDedupe(ds_sll_t* linkedList, size_t (*hashFunc)(void*), int (*equalityFunc)(void*, void*));
+ds_sll_error_t ds_sll_setUnion(ds_sll_t* firstLinkedList, ds_sll_t* secondLinkedList, size_t (*hashFunc)(void*), int (*equalityFunc)(void*, void*));
+ds_sll_error_t ds_sll_setIntersection(ds_sll_t* firstLinkedList, const ds_sll_t* secondLinkedList, size_t (*hashFunc)(void*), int (*equalityFunc)(void*, void*));
+ds_sll_error_t ds_sll_setDifference(ds_sll_t* firstLinkedList, const ds_sll_t* secondLinkedList, size_t (*hashFunc)(void*), int (*equalityFunc)(void*, void*));
+// Helper Functions
+size_t ds_sll_hashBytes(const void* data, size_t size);
+/* ------------------------------------------------------------------ */
+
+
+/**
+ * @}
+ */
+
+#endif //RM_DS_SLL_SINGLYLINKEDLISTSET_H
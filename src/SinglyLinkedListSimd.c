@@ -0,0 +1,960 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2017 Ronny Majani
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+/**
+ * @ingroup singlylinkedlist
+ * @file SinglyLinkedListSimd.c
+ * @brief Vectorized search and reduction kernels for Singly Linked Lists of fixed-width keys (ds_sll)
+ *
+ * Category: Data Structures >> Linked Lists
+ * Codename: ds_sll
+ *
+ * ### Usage:
+ * The kernels come in two flavors:
+ * + Block kernels (ds_sll_simd*): operate on `count` values stored contiguously in memory
+ * + List kernels: traverse a @ref ds_sll_t whose elements point to values of the given @ref ds_sll_simd_type_t,
+ * gather them into blocks of @ref DS_SLL_SIMD_BLOCK_LENGTH values, and run the scalar block kernels on each block.
+ * These replace a per node call through an `equalityFunc` function pointer with a typed comparison.
+ *
+ * ### Dispatch:
+ * The first call to a block kernel selects the best kernel set supported by the running CPU.
+ * The list kernels always use the scalar kernels: their cost is the pointer chasing of the traversal, and
+ * bench_simd measured no consistent gain of the vectorized kernels over @ref ds_sll_findNodeContainingElement
+ * with an equality callback (between 0.7x and 2x depending on the type and kernel).
+ * @ref ds_sll_simdSetLevel can be used to force a lower level (eg: to compare the results against the scalar kernels).
+ * The vectorized kernels are only compiled on x86 targets with a GCC compatible compiler; everywhere else the
+ * scalar kernels are used.
+ *
+ * ###Note:
+ * Floating point sums are accumulated in a different order by each level, so the results of different levels
+ * may differ in their last bits. The result of min and max on blocks containing NaN is unspecified.
+ **/
+
+#include "SinglyLinkedListSimd.h"
+#include <assert.h>
+#include <memory.h>
+#include <stdint.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define DS_SLL_SIMD_X86
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief Macro definition for ASSERT
+ * Used to enforce Design by Contract coding
+ * Typically disabled on release
+ */
+#define ASSERT assert
+
+/**
+ * @brief Number of values gathered from a list before the block kernels are run on them
+ */
+#define DS_SLL_SIMD_BLOCK_LENGTH 256
+
+/**
+ * @brief Number of supported value types (see @ref ds_sll_simd_type_t)
+ */
+#define DS_SLL_SIMD_TYPE_COUNT 4
+
+/**
+ * @brief A set of kernels implemented with one instruction set, indexed by @ref ds_sll_simd_type_t
+ */
+typedef struct ds_sll_simd_kernels_t {
+    ds_sll_simd_level_t level; /**< The instruction set the kernels are implemented with */
+    int (*findFirst[DS_SLL_SIMD_TYPE_COUNT])(const void* values, int count, const void* key);
+    int (*count[DS_SLL_SIMD_TYPE_COUNT])(const void* values, int count, const void* key);
+    void (*min[DS_SLL_SIMD_TYPE_COUNT])(const void* values, int count, void* result);
+    void (*max[DS_SLL_SIMD_TYPE_COUNT])(const void* values, int count, void* result);
+    void (*sum[DS_SLL_SIMD_TYPE_COUNT])(const void* values, int count, void* result);
+} ds_sll_simd_kernels_t;
+
+
+/* Scalar Kernels */
+/**
+ * @brief Generates the portable kernels for one value type
+ * @param NAME Suffix of the generated functions
+ * @param TYPE The value type
+ * @param SUMTYPE The type sums are accumulated in
+ */
+#define DS_SLL_SCALAR_KERNELS(NAME, TYPE, SUMTYPE) \
+static int ds_sll_scalarFindFirst_##NAME(const void* values, int count, const void* key) \
+{ \
+    const TYPE* v = (const TYPE*) values; \
+    const TYPE k = *(const TYPE*) key; \
+    int i; \
+    for(i = 0; i < count; i++) { \
+        if(v[i] == k) { \
+            return i; \
+        } \
+    } \
+    return -1; \
+} \
+static int ds_sll_scalarCount_##NAME(const void* values, int count, const void* key) \
+{ \
+    const TYPE* v = (const TYPE*) values; \
+    const TYPE k = *(const TYPE*) key; \
+    int i, total = 0; \
+    for(i = 0; i < count; i++) { \
+        total += (v[i] == k); \
+    } \
+    return total; \
+} \
+static void ds_sll_scalarMin_##NAME(const void* values, int count, void* result) \
+{ \
+    const TYPE* v = (const TYPE*) values; \
+    TYPE best = v[0]; \
+    int i; \
+    for(i = 1; i < count; i++) { \
+        if(v[i] < best) { \
+            best = v[i]; \
+        } \
+    } \
+    *(TYPE*) result = best; \
+} \
+static void ds_sll_scalarMax_##NAME(const void* values, int count, void* result) \
+{ \
+    const TYPE* v = (const TYPE*) values; \
+    TYPE best = v[0]; \
+    int i; \
+    for(i = 1; i < count; i++) { \
+        if(v[i] > best) { \
+            best = v[i]; \
+        } \
+    } \
+    *(TYPE*) result = best; \
+} \
+static void ds_sll_scalarSum_##NAME(const void* values, int count, void* result) \
+{ \
+    const TYPE* v = (const TYPE*) values; \
+    SUMTYPE total = 0; \
+    int i; \
+    for(i = 0; i < count; i++) { \
+        total += v[i]; \
+    } \
+    *(SUMTYPE*) result = total; \
+}
+
+DS_SLL_SCALAR_KERNELS(int32, int32_t, int64_t)
+DS_SLL_SCALAR_KERNELS(int64, int64_t, int64_t)
+DS_SLL_SCALAR_KERNELS(float, float, double)
+DS_SLL_SCALAR_KERNELS(double, double, double)
+
+static const ds_sll_simd_kernels_t ds_sll_scalarKernels = {
+    DS_SLL_SIMD_SCALAR,
+    { ds_sll_scalarFindFirst_int32, ds_sll_scalarFindFirst_int64, ds_sll_scalarFindFirst_float, ds_sll_scalarFindFirst_double },
+    { ds_sll_scalarCount_int32, ds_sll_scalarCount_int64, ds_sll_scalarCount_float, ds_sll_scalarCount_double },
+    { ds_sll_scalarMin_int32, ds_sll_scalarMin_int64, ds_sll_scalarMin_float, ds_sll_scalarMin_double },
+    { ds_sll_scalarMax_int32, ds_sll_scalarMax_int64, ds_sll_scalarMax_float, ds_sll_scalarMax_double },
+    { ds_sll_scalarSum_int32, ds_sll_scalarSum_int64, ds_sll_scalarSum_float, ds_sll_scalarSum_double }
+};
+/* ------------------------------------------------------------------ */
+
+
+#ifdef DS_SLL_SIMD_X86
+
+#define DS_SLL_TARGET_SSE2 __attribute__((target("sse2")))
+#define DS_SLL_TARGET_AVX2 __attribute__((target("avx2")))
+
+/**
+ * @brief Generates the find-first and count kernels of one instruction set for one value type
+ * @param ISA Instruction set prefix of the generated functions (sse2 or avx2)
+ * @param TARGET Target attribute the functions are compiled with
+ * @param NAME Suffix of the generated functions
+ * @param TYPE The value type
+ * @param LANES Number of values compared at once
+ *
+ * Relies on a function `ds_sll_<ISA>EqualMask_<NAME>(values, key)` that returns a bitmask of the
+ * lanes (starting at `values`) that are equal to `key`.
+ */
+#define DS_SLL_SEARCH_KERNELS(ISA, TARGET, NAME, TYPE, LANES) \
+TARGET static int ds_sll_##ISA##FindFirst_##NAME(const void* values, int count, const void* key) \
+{ \
+    const TYPE* v = (const TYPE*) values; \
+    int i = 0; \
+    for(; i + (LANES) <= count; i += (LANES)) { \
+        int mask = ds_sll_##ISA##EqualMask_##NAME(v + i, key); \
+        if(mask != 0) { \
+            return i + __builtin_ctz((unsigned int) mask); \
+        } \
+    } \
+    int rest = ds_sll_scalarFindFirst_##NAME(v + i, count - i, key); \
+    return (rest == -1) ? -1 : i + rest; \
+} \
+TARGET static int ds_sll_##ISA##Count_##NAME(const void* values, int count, const void* key) \
+{ \
+    const TYPE* v = (const TYPE*) values; \
+    int i = 0, total = 0; \
+    for(; i + (LANES) <= count; i += (LANES)) { \
+        total += __builtin_popcount((unsigned int) ds_sll_##ISA##EqualMask_##NAME(v + i, key)); \
+    } \
+    return total + ds_sll_scalarCount_##NAME(v + i, count - i, key); \
+}
+
+/**
+ * @brief Generates the min and max kernels of one instruction set for one value type
+ * @param ISA Instruction set prefix of the generated functions (sse2 or avx2)
+ * @param TARGET Target attribute the functions are compiled with
+ * @param NAME Suffix of the generated functions
+ * @param TYPE The value type
+ * @param VECTOR The vector type holding `LANES` values
+ * @param LANES Number of values processed at once
+ * @param VMIN Lane-wise minimum of two vectors
+ * @param VMAX Lane-wise maximum of two vectors
+ *
+ * Vectors are loaded and stored through memcpy, which compiles down to unaligned loads and stores.
+ */
+#define DS_SLL_MINMAX_KERNELS(ISA, TARGET, NAME, TYPE, VECTOR, LANES, VMIN, VMAX) \
+TARGET static void ds_sll_##ISA##Min_##NAME(const void* values, int count, void* result) \
+{ \
+    const TYPE* v = (const TYPE*) values; \
+    if(count < (LANES)) { \
+        ds_sll_scalarMin_##NAME(values, count, result); \
+        return; \
+    } \
+    VECTOR acc, x; \
+    TYPE lanes[(LANES) + 1]; \
+    int i; \
+    memcpy(&acc, v, sizeof(VECTOR)); \
+    for(i = (LANES); i + (LANES) <= count; i += (LANES)) { \
+        memcpy(&x, v + i, sizeof(VECTOR)); \
+        acc = VMIN(acc, x); \
+    } \
+    memcpy(lanes, &acc, sizeof(VECTOR)); \
+    ds_sll_scalarMin_##NAME(lanes, (LANES), &lanes[0]); \
+    if(i < count) { \
+        ds_sll_scalarMin_##NAME(v + i, count - i, &lanes[1]); \
+        ds_sll_scalarMin_##NAME(lanes, 2, &lanes[0]); \
+    } \
+    *(TYPE*) result = lanes[0]; \
+} \
+TARGET static void ds_sll_##ISA##Max_##NAME(const void* values, int count, void* result) \
+{ \
+    const TYPE* v = (const TYPE*) values; \
+    if(count < (LANES)) { \
+        ds_sll_scalarMax_##NAME(values, count, result); \
+        return; \
+    } \
+    VECTOR acc, x; \
+    TYPE lanes[(LANES) + 1]; \
+    int i; \
+    memcpy(&acc, v, sizeof(VECTOR)); \
+    for(i = (LANES); i + (LANES) <= count; i += (LANES)) { \
+        memcpy(&x, v + i, sizeof(VECTOR)); \
+        acc = VMAX(acc, x); \
+    } \
+    memcpy(lanes, &acc, sizeof(VECTOR)); \
+    ds_sll_scalarMax_##NAME(lanes, (LANES), &lanes[0]); \
+    if(i < count) { \
+        ds_sll_scalarMax_##NAME(v + i, count - i, &lanes[1]); \
+        ds_sll_scalarMax_##NAME(lanes, 2, &lanes[0]); \
+    } \
+    *(TYPE*) result = lanes[0]; \
+}
+
+
+/* SSE2 Kernels */
+DS_SLL_TARGET_SSE2 static inline int ds_sll_sse2EqualMask_int32(const int32_t* values, const void* key)
+{
+    __m128i x = _mm_loadu_si128((const __m128i*) values);
+    __m128i eq = _mm_cmpeq_epi32(x, _mm_set1_epi32(*(const int32_t*) key));
+    return _mm_movemask_ps(_mm_castsi128_ps(eq));
+}
+
+DS_SLL_TARGET_SSE2 static inline int ds_sll_sse2EqualMask_int64(const int64_t* values, const void* key)
+{
+    // SSE2 has no 64-bit compare: both 32-bit halves of a lane have to be equal
+    __m128i x = _mm_loadu_si128((const __m128i*) values);
+    __m128i eq = _mm_cmpeq_epi32(x, _mm_set1_epi64x(*(const int64_t*) key));
+    eq = _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_movemask_pd(_mm_castsi128_pd(eq));
+}
+
+DS_SLL_TARGET_SSE2 static inline int ds_sll_sse2EqualMask_float(const float* values, const void* key)
+{
+    return _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(values), _mm_set1_ps(*(const float*) key)));
+}
+
+DS_SLL_TARGET_SSE2 static inline int ds_sll_sse2EqualMask_double(const double* values, const void* key)
+{
+    return _mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(values), _mm_set1_pd(*(const double*) key)));
+}
+
+// SSE2 lacks the signed 32-bit min/max (added in SSE4.1), so they are emulated with a compare and a blend
+DS_SLL_TARGET_SSE2 static inline __m128i ds_sll_sse2Min_epi32(__m128i a, __m128i b)
+{
+    __m128i gt = _mm_cmpgt_epi32(a, b);
+    return _mm_or_si128(_mm_and_si128(gt, b), _mm_andnot_si128(gt, a));
+}
+
+DS_SLL_TARGET_SSE2 static inline __m128i ds_sll_sse2Max_epi32(__m128i a, __m128i b)
+{
+    __m128i gt = _mm_cmpgt_epi32(a, b);
+    return _mm_or_si128(_mm_and_si128(gt, a), _mm_andnot_si128(gt, b));
+}
+
+DS_SLL_SEARCH_KERNELS(sse2, DS_SLL_TARGET_SSE2, int32, int32_t, 4)
+DS_SLL_SEARCH_KERNELS(sse2, DS_SLL_TARGET_SSE2, int64, int64_t, 2)
+DS_SLL_SEARCH_KERNELS(sse2, DS_SLL_TARGET_SSE2, float, float, 4)
+DS_SLL_SEARCH_KERNELS(sse2, DS_SLL_TARGET_SSE2, double, double, 2)
+DS_SLL_MINMAX_KERNELS(sse2, DS_SLL_TARGET_SSE2, int32, int32_t, __m128i, 4, ds_sll_sse2Min_epi32, ds_sll_sse2Max_epi32)
+DS_SLL_MINMAX_KERNELS(sse2, DS_SLL_TARGET_SSE2, float, float, __m128, 4, _mm_min_ps, _mm_max_ps)
+DS_SLL_MINMAX_KERNELS(sse2, DS_SLL_TARGET_SSE2, double, double, __m128d, 2, _mm_min_pd, _mm_max_pd)
+
+DS_SLL_TARGET_SSE2 static void ds_sll_sse2Sum_int32(const void* values, int count, void* result)
+{
+    const int32_t* v = (const int32_t*) values;
+    __m128i acc = _mm_setzero_si128();
+    int64_t lanes[2], rest;
+    int i = 0;
+    for(; i + 4 <= count; i += 4) {
+        __m128i x = _mm_loadu_si128((const __m128i*) (v + i));
+        __m128i sign = _mm_cmpgt_epi32(_mm_setzero_si128(), x); // sign extend to 64 bits
+        acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(x, sign));
+        acc = _mm_add_epi64(acc, _mm_unpackhi_epi32(x, sign));
+    }
+    memcpy(lanes, &acc, sizeof(lanes));
+    ds_sll_scalarSum_int32(v + i, count - i, &rest);
+    *(int64_t*) result = lanes[0] + lanes[1] + rest;
+}
+
+DS_SLL_TARGET_SSE2 static void ds_sll_sse2Sum_int64(const void* values, int count, void* result)
+{
+    const int64_t* v = (const int64_t*) values;
+    __m128i acc = _mm_setzero_si128();
+    int64_t lanes[2], rest;
+    int i = 0;
+    for(; i + 2 <= count; i += 2) {
+        acc = _mm_add_epi64(acc, _mm_loadu_si128((const __m128i*) (v + i)));
+    }
+    memcpy(lanes, &acc, sizeof(lanes));
+    ds_sll_scalarSum_int64(v + i, count - i, &rest);
+    *(int64_t*) result = lanes[0] + lanes[1] + rest;
+}
+
+DS_SLL_TARGET_SSE2 static void ds_sll_sse2Sum_float(const void* values, int count, void* result)
+{
+    const float* v = (const float*) values;
+    __m128d acc = _mm_setzero_pd();
+    double lanes[2], rest;
+    int i = 0;
+    for(; i + 4 <= count; i += 4) {
+        __m128 x = _mm_loadu_ps(v + i);
+        acc = _mm_add_pd(acc, _mm_cvtps_pd(x));
+        acc = _mm_add_pd(acc, _mm_cvtps_pd(_mm_movehl_ps(x, x)));
+    }
+    memcpy(lanes, &acc, sizeof(lanes));
+    ds_sll_scalarSum_float(v + i, count - i, &rest);
+    *(double*) result = lanes[0] + lanes[1] + rest;
+}
+
+DS_SLL_TARGET_SSE2 static void ds_sll_sse2Sum_double(const void* values, int count, void* result)
+{
+    const double* v = (const double*) values;
+    __m128d acc = _mm_setzero_pd();
+    double lanes[2], rest;
+    int i = 0;
+    for(; i + 2 <= count; i += 2) {
+        acc = _mm_add_pd(acc, _mm_loadu_pd(v + i));
+    }
+    memcpy(lanes, &acc, sizeof(lanes));
+    ds_sll_scalarSum_double(v + i, count - i, &rest);
+    *(double*) result = lanes[0] + lanes[1] + rest;
+}
+
+static const ds_sll_simd_kernels_t ds_sll_sse2Kernels = {
+    DS_SLL_SIMD_SSE2,
+    { ds_sll_sse2FindFirst_int32, ds_sll_sse2FindFirst_int64, ds_sll_sse2FindFirst_float, ds_sll_sse2FindFirst_double },
+    { ds_sll_sse2Count_int32, ds_sll_sse2Count_int64, ds_sll_sse2Count_float, ds_sll_sse2Count_double },
+    // SSE2 has no 64-bit signed compare (added in SSE4.2), so int64 min/max stay scalar at this level
+    { ds_sll_sse2Min_int32, ds_sll_scalarMin_int64, ds_sll_sse2Min_float, ds_sll_sse2Min_double },
+    { ds_sll_sse2Max_int32, ds_sll_scalarMax_int64, ds_sll_sse2Max_float, ds_sll_sse2Max_double },
+    { ds_sll_sse2Sum_int32, ds_sll_sse2Sum_int64, ds_sll_sse2Sum_float, ds_sll_sse2Sum_double }
+};
+/* ------------------------------------------------------------------ */
+
+
+/* AVX2 Kernels */
+DS_SLL_TARGET_AVX2 static inline int ds_sll_avx2EqualMask_int32(const int32_t* values, const void* key)
+{
+    __m256i x = _mm256_loadu_si256((const __m256i*) values);
+    __m256i eq = _mm256_cmpeq_epi32(x, _mm256_set1_epi32(*(const int32_t*) key));
+    return _mm256_movemask_ps(_mm256_castsi256_ps(eq));
+}
+
+DS_SLL_TARGET_AVX2 static inline int ds_sll_avx2EqualMask_int64(const int64_t* values, const void* key)
+{
+    __m256i x = _mm256_loadu_si256((const __m256i*) values);
+    __m256i eq = _mm256_cmpeq_epi64(x, _mm256_set1_epi64x(*(const int64_t*) key));
+    return _mm256_movemask_pd(_mm256_castsi256_pd(eq));
+}
+
+DS_SLL_TARGET_AVX2 static inline int ds_sll_avx2EqualMask_float(const float* values, const void* key)
+{
+    return _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(values), _mm256_set1_ps(*(const float*) key), _CMP_EQ_OQ));
+}
+
+DS_SLL_TARGET_AVX2 static inline int ds_sll_avx2EqualMask_double(const double* values, const void* key)
+{
+    return _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(values), _mm256_set1_pd(*(const double*) key), _CMP_EQ_OQ));
+}
+
+// AVX2 lacks the signed 64-bit min/max (added in AVX-512), so they are emulated with a compare and a blend
+DS_SLL_TARGET_AVX2 static inline __m256i ds_sll_avx2Min_epi64(__m256i a, __m256i b)
+{
+    return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b));
+}
+
+DS_SLL_TARGET_AVX2 static inline __m256i ds_sll_avx2Max_epi64(__m256i a, __m256i b)
+{
+    return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b));
+}
+
+DS_SLL_SEARCH_KERNELS(avx2, DS_SLL_TARGET_AVX2, int32, int32_t, 8)
+DS_SLL_SEARCH_KERNELS(avx2, DS_SLL_TARGET_AVX2, int64, int64_t, 4)
+DS_SLL_SEARCH_KERNELS(avx2, DS_SLL_TARGET_AVX2, float, float, 8)
+DS_SLL_SEARCH_KERNELS(avx2, DS_SLL_TARGET_AVX2, double, double, 4)
+DS_SLL_MINMAX_KERNELS(avx2, DS_SLL_TARGET_AVX2, int32, int32_t, __m256i, 8, _mm256_min_epi32, _mm256_max_epi32)
+DS_SLL_MINMAX_KERNELS(avx2, DS_SLL_TARGET_AVX2, int64, int64_t, __m256i, 4, ds_sll_avx2Min_epi64, ds_sll_avx2Max_epi64)
+DS_SLL_MINMAX_KERNELS(avx2, DS_SLL_TARGET_AVX2, float, float, __m256, 8, _mm256_min_ps, _mm256_max_ps)
+DS_SLL_MINMAX_KERNELS(avx2, DS_SLL_TARGET_AVX2, double, double, __m256d, 4, _mm256_min_pd, _mm256_max_pd)
+
+DS_SLL_TARGET_AVX2 static void ds_sll_avx2Sum_int32(const void* values, int count, void* result)
+{
+    const int32_t* v = (const int32_t*) values;
+    __m256i acc = _mm256_setzero_si256();
+    int64_t lanes[4], rest;
+    int i = 0;
+    for(; i + 8 <= count; i += 8) {
+        __m256i x = _mm256_loadu_si256((const __m256i*) (v + i));
+        acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(x)));
+        acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(x, 1)));
+    }
+    memcpy(lanes, &acc, sizeof(lanes));
+    ds_sll_scalarSum_int32(v + i, count - i, &rest);
+    *(int64_t*) result = lanes[0] + lanes[1] + lanes[2] + lanes[3] + rest;
+}
+
+DS_SLL_TARGET_AVX2 static void ds_sll_avx2Sum_int64(const void* values, int count, void* result)
+{
+    const int64_t* v = (const int64_t*) values;
+    __m256i acc = _mm256_setzero_si256();
+    int64_t lanes[4], rest;
+    int i = 0;
+    for(; i + 4 <= count; i += 4) {
+        acc = _mm256_add_epi64(acc, _mm256_loadu_si256((const __m256i*) (v + i)));
+    }
+    memcpy(lanes, &acc, sizeof(lanes));
+    ds_sll_scalarSum_int64(v + i, count - i, &rest);
+    *(int64_t*) result = lanes[0] + lanes[1] + lanes[2] + lanes[3] + rest;
+}
+
+DS_SLL_TARGET_AVX2 static void ds_sll_avx2Sum_float(const void* values, int count, void* result)
+{
+    const float* v = (const float*) values;
+    __m256d acc = _mm256_setzero_pd();
+    double lanes[4], rest;
+    int i = 0;
+    for(; i + 8 <= count; i += 8) {
+        __m256 x = _mm256_loadu_ps(v + i);
+        acc = _mm256_add_pd(acc, _mm256_cvtps_pd(_mm256_castps256_ps128(x)));
+        acc = _mm256_add_pd(acc, _mm256_cvtps_pd(_mm256_extractf128_ps(x, 1)));
+    }
+    memcpy(lanes, &acc, sizeof(lanes));
+    ds_sll_scalarSum_float(v + i, count - i, &rest);
+    *(double*) result = lanes[0] + lanes[1] + lanes[2] + lanes[3] + rest;
+}
+
+DS_SLL_TARGET_AVX2 static void ds_sll_avx2Sum_double(const void* values, int count, void* result)
+{
+    const double* v = (const double*) values;
+    __m256d acc = _mm256_setzero_pd();
+    double lanes[4], rest;
+    int i = 0;
+    for(; i + 4 <= count; i += 4) {
+        acc = _mm256_add_pd(acc, _mm256_loadu_pd(v + i));
+    }
+    memcpy(lanes, &acc, sizeof(lanes));
+    ds_sll_scalarSum_double(v + i, count - i, &rest);
+    *(double*) result = lanes[0] + lanes[1] + lanes[2] + lanes[3] + rest;
+}
+
+static const ds_sll_simd_kernels_t ds_sll_avx2Kernels = {
+    DS_SLL_SIMD_AVX2,
+    { ds_sll_avx2FindFirst_int32, ds_sll_avx2FindFirst_int64, ds_sll_avx2FindFirst_float, ds_sll_avx2FindFirst_double },
+    { ds_sll_avx2Count_int32, ds_sll_avx2Count_int64, ds_sll_avx2Count_float, ds_sll_avx2Count_double },
+    { ds_sll_avx2Min_int32, ds_sll_avx2Min_int64, ds_sll_avx2Min_float, ds_sll_avx2Min_double },
+    { ds_sll_avx2Max_int32, ds_sll_avx2Max_int64, ds_sll_avx2Max_float, ds_sll_avx2Max_double },
+    { ds_sll_avx2Sum_int32, ds_sll_avx2Sum_int64, ds_sll_avx2Sum_float, ds_sll_avx2Sum_double }
+};
+/* ------------------------------------------------------------------ */
+
+#endif // DS_SLL_SIMD_X86
+
+
+/* Dispatch */
+/**
+ * The kernel set in use, selected on first use.
+ * Always accessed atomically (release stores, acquire loads) so threads can race on the first selection.
+ */
+static const ds_sll_simd_kernels_t* ds_sll_simdKernels = NULL;
+
+
+/**
+ * @brief Detect the best kernel level supported by the running CPU
+ * @return The highest @ref ds_sll_simd_level_t that can be used on this machine
+ */
+ds_sll_simd_level_t ds_sll_simdDetectLevel()
+{
+#ifdef DS_SLL_SIMD_X86
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2")) {
+        return DS_SLL_SIMD_AVX2;
+    }
+    if(__builtin_cpu_supports("sse2")) {
+        return DS_SLL_SIMD_SSE2;
+    }
+#endif
+    return DS_SLL_SIMD_SCALAR;
+}
+
+
+/**
+ * @brief Get the kernel set of the given level, lowered to the best level supported by the running CPU if needed
+ * @param level The desired level
+ * @return The kernel set
+ */
+static const ds_sll_simd_kernels_t* ds_sll_simdKernelsForLevel(ds_sll_simd_level_t level)
+{
+    ds_sll_simd_level_t supported = ds_sll_simdDetectLevel();
+
+    if(level > supported) {
+        level = supported;
+    }
+
+    switch(level) {
+#ifdef DS_SLL_SIMD_X86
+        case DS_SLL_SIMD_AVX2:
+            return &ds_sll_avx2Kernels;
+        case DS_SLL_SIMD_SSE2:
+            return &ds_sll_sse2Kernels;
+#endif
+        default:
+            return &ds_sll_scalarKernels;
+    }
+}
+
+
+/**
+ * @brief Select the block kernels used by all following calls (the list kernels always use the scalar ones)
+ * @param level The desired level. It is lowered to the best level supported by the running CPU if needed
+ * @return The level that was actually selected
+ *
+ * Mainly useful to compare the vectorized results against the scalar ones.
+ * Calls running concurrently in other threads finish with the kernels they started with.
+ */
+ds_sll_simd_level_t ds_sll_simdSetLevel(ds_sll_simd_level_t level)
+{
+    const ds_sll_simd_kernels_t* kernels = ds_sll_simdKernelsForLevel(level);
+    __atomic_store_n(&ds_sll_simdKernels, kernels, __ATOMIC_RELEASE);
+    return kernels->level;
+}
+
+
+/**
+ * @brief Get the kernel set in use, selecting the best supported one on first use
+ * @return The active kernel set
+ */
+static inline const ds_sll_simd_kernels_t* ds_sll_simdActiveKernels()
+{
+    const ds_sll_simd_kernels_t* kernels = __atomic_load_n(&ds_sll_simdKernels, __ATOMIC_ACQUIRE);
+
+    if(kernels == NULL) {
+        // first use: racing threads select the same set, and an explicit ds_sll_simdSetLevel wins
+        const ds_sll_simd_kernels_t* expected = NULL;
+        kernels = ds_sll_simdKernelsForLevel(ds_sll_simdDetectLevel());
+        if(!__atomic_compare_exchange_n(&ds_sll_simdKernels, &expected, kernels, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            kernels = expected;
+        }
+    }
+    return kernels;
+}
+
+
+/**
+ * @brief Get the level of the kernels currently in use
+ * @return The @ref ds_sll_simd_level_t in use (selecting the best supported one if no kernel was used yet)
+ */
+ds_sll_simd_level_t ds_sll_simdGetLevel()
+{
+    return ds_sll_simdActiveKernels()->level;
+}
+
+
+/**
+ * @brief Get the kernel set used by the list kernels
+ * @return The scalar kernel set, whatever the selected level (see Dispatch above)
+ */
+static inline const ds_sll_simd_kernels_t* ds_sll_simdListKernels()
+{
+    return &ds_sll_scalarKernels;
+}
+
+
+/**
+ * @brief Get the size of one value of the given type
+ * @param type The value type
+ * @return The size (in bytes) of one value
+ */
+size_t ds_sll_simdTypeSize(ds_sll_simd_type_t type)
+{
+    switch(type) {
+        case DS_SLL_SIMD_INT32:
+            return sizeof(int32_t);
+        case DS_SLL_SIMD_INT64:
+            return sizeof(int64_t);
+        case DS_SLL_SIMD_FLOAT:
+            return sizeof(float);
+        case DS_SLL_SIMD_DOUBLE:
+            return sizeof(double);
+        default:
+            return 0;
+    }
+}
+/* ------------------------------------------------------------------ */
+
+
+/* Block Kernels */
+/**
+ * @brief Find the first value equal to the given key
+ * @param values Pointer to `count` contiguous values of the given type
+ * @param count The number of values
+ * @param type The type of the values and of the key
+ * @param key Pointer to the value to search for
+ * @return The index of the first value equal to the key, or -1 if not found
+ */
+int ds_sll_simdFindFirst(const void* values, int count, ds_sll_simd_type_t type, const void* key)
+{
+    ASSERT(((values != NULL) || (count == 0)) && (count >= 0) && (key != NULL) && (type < DS_SLL_SIMD_TYPE_COUNT));
+    return ds_sll_simdActiveKernels()->findFirst[type](values, count, key);
+}
+
+
+/**
+ * @brief Count the values equal to the given key
+ * @param values Pointer to `count` contiguous values of the given type
+ * @param count The number of values
+ * @param type The type of the values and of the key
+ * @param key Pointer to the value to count
+ * @return The number of values equal to the key
+ */
+int ds_sll_simdCount(const void* values, int count, ds_sll_simd_type_t type, const void* key)
+{
+    ASSERT(((values != NULL) || (count == 0)) && (count >= 0) && (key != NULL) && (type < DS_SLL_SIMD_TYPE_COUNT));
+    return ds_sll_simdActiveKernels()->count[type](values, count, key);
+}
+
+
+/**
+ * @brief Find the smallest value
+ * @param values Pointer to `count` contiguous values of the given type
+ * @param count The number of values
+ * @param type The type of the values
+ * @param result Pointer to a value of the given type that is set to the smallest value
+ * @return @ref ds_sll_error_t Error Code. DS_SLL_LIST_TOO_SMALL_ERROR if `count` is 0
+ */
+ds_sll_error_t ds_sll_simdMin(const void* values, int count, ds_sll_simd_type_t type, void* result)
+{
+    ASSERT(((values != NULL) || (count == 0)) && (count >= 0) && (result != NULL) && (type < DS_SLL_SIMD_TYPE_COUNT));
+
+    if(count == 0) {
+        return DS_SLL_LIST_TOO_SMALL_ERROR;
+    }
+
+    ds_sll_simdActiveKernels()->min[type](values, count, result);
+    return DS_SLL_NO_ERROR;
+}
+
+
+/**
+ * @brief Find the largest value
+ * @param values Pointer to `count` contiguous values of the given type
+ * @param count The number of values
+ * @param type The type of the values
+ * @param result Pointer to a value of the given type that is set to the largest value
+ * @return @ref ds_sll_error_t Error Code. DS_SLL_LIST_TOO_SMALL_ERROR if `count` is 0
+ */
+ds_sll_error_t ds_sll_simdMax(const void* values, int count, ds_sll_simd_type_t type, void* result)
+{
+    ASSERT(((values != NULL) || (count == 0)) && (count >= 0) && (result != NULL) && (type < DS_SLL_SIMD_TYPE_COUNT));
+
+    if(count == 0) {
+        return DS_SLL_LIST_TOO_SMALL_ERROR;
+    }
+
+    ds_sll_simdActiveKernels()->max[type](values, count, result);
+    return DS_SLL_NO_ERROR;
+}
+
+
+/**
+ * @brief Sum the values
+ * @param values Pointer to `count` contiguous values of the given type
+ * @param count The number of values
+ * @param type The type of the values
+ * @param result Pointer to an int64_t (integer types) or a double (floating point types) that is set to the sum
+ * @return @ref ds_sll_error_t Error Code.
+ */
+ds_sll_error_t ds_sll_simdSum(const void* values, int count, ds_sll_simd_type_t type, void* result)
+{
+    ASSERT(((values != NULL) || (count == 0)) && (count >= 0) && (result != NULL) && (type < DS_SLL_SIMD_TYPE_COUNT));
+    ds_sll_simdActiveKernels()->sum[type](values, count, result);
+    return DS_SLL_NO_ERROR;
+}
+/* ------------------------------------------------------------------ */
+
+
+/* List Kernels */
+/**
+ * @brief Storage for one block of gathered values, aligned for any of the supported types
+ */
+typedef union ds_sll_simd_block_t {
+    unsigned char bytes[DS_SLL_SIMD_BLOCK_LENGTH * sizeof(int64_t)];
+    int64_t align_int64;
+    double align_double;
+} ds_sll_simd_block_t;
+
+
+/**
+ * @brief Gather the values of the following nodes into a block
+ * @param linkedList The singly linked list being traversed
+ * @param curr Pointer to the next node to gather. Advanced past the gathered nodes, and set to NULL once the tail was gathered
+ * @param block The block to copy the values into
+ * @param offset The slot in the block to start filling at
+ * @param value_size The size (in bytes) of one value
+ * @param nodes Optional. If not NULL the gathered nodes are stored in the same slots as their values
+ * @param status Set to DS_SLL_BROKEN_LIST_ERROR if the list ended before reaching its tail
+ * @return The number of values gathered
+ */
+static int ds_sll_simdGatherBlock(const ds_sll_t* linkedList, ds_sll_node_t** curr, ds_sll_simd_block_t* block, int offset,
+                                  size_t value_size, ds_sll_node_t** nodes, ds_sll_error_t* status)
+{
+    int slot;
+
+    for(slot = offset; (*curr != NULL) && (slot < DS_SLL_SIMD_BLOCK_LENGTH); slot++) {
+        void* element = ds_sll_extractElementFromNode(*curr);
+        ASSERT(element != NULL);
+        memcpy(block->bytes + (slot * value_size), element, value_size);
+        if(nodes != NULL) {
+            nodes[slot] = *curr;
+        }
+
+        if(*curr == linkedList->tail) {
+            *curr = NULL;
+        } else {
+            *curr = ds_sll_nextNode(*curr);
+            if(*curr == NULL) {
+                *status = DS_SLL_BROKEN_LIST_ERROR;
+            }
+        }
+    }
+
+    return slot - offset;
+}
+
+
+/**
+ * @brief Find the first node whose element is equal to the given value
+ * @param linkedList The singly linked list to search. Each element must point to a value of the given type
+ * @param type The type of the values stored in the list
+ * @param key Pointer to the value to search for
+ * @param resultIndex Optional parameter, if not NULL will be set to equal the index of the node that was found
+ * @return The first node containing the given value. NULL if not found or the list is broken
+ *
+ * An alternative to @ref ds_sll_findNodeContainingElement for lists of fixed-width keys, without a callback per node.
+ */
+ds_sll_node_t* ds_sll_findNodeContainingValue(const ds_sll_t* linkedList, ds_sll_simd_type_t type, const void* key, int *resultIndex)
+{
+    ASSERT((linkedList != NULL) && (linkedList->head != NULL) && (linkedList->tail != NULL) && (key != NULL));
+
+    const ds_sll_simd_kernels_t* kernels = ds_sll_simdListKernels();
+    size_t value_size = ds_sll_simdTypeSize(type);
+    ds_sll_simd_block_t block;
+    ds_sll_node_t* nodes[DS_SLL_SIMD_BLOCK_LENGTH];
+    ds_sll_node_t* curr = linkedList->head;
+    ds_sll_error_t status = DS_SLL_NO_ERROR;
+    int base = 0;
+
+    while(curr != NULL) {
+        int gathered = ds_sll_simdGatherBlock(linkedList, &curr, &block, 0, value_size, nodes, &status);
+        int found = kernels->findFirst[type](block.bytes, gathered, key);
+
+        if(found != -1) {
+            if(resultIndex != NULL) {
+                *resultIndex = base + found;
+            }
+            return nodes[found];
+        }
+        base += gathered;
+    }
+
+    return NULL;
+}
+
+
+/**
+ * @brief Count the nodes whose element is equal to the given value
+ * @param linkedList The singly linked list to search. Each element must point to a value of the given type
+ * @param type The type of the values stored in the list
+ * @param key Pointer to the value to count
+ * @return The number of nodes containing the given value,
+ *         or -1 if the list is broken
+ */
+int ds_sll_countNodesContainingValue(const ds_sll_t* linkedList, ds_sll_simd_type_t type, const void* key)
+{
+    ASSERT((linkedList != NULL) && (linkedList->head != NULL) && (linkedList->tail != NULL) && (key != NULL));
+
+    const ds_sll_simd_kernels_t* kernels = ds_sll_simdListKernels();
+    size_t value_size = ds_sll_simdTypeSize(type);
+    ds_sll_simd_block_t block;
+    ds_sll_node_t* curr = linkedList->head;
+    ds_sll_error_t status = DS_SLL_NO_ERROR;
+    int total = 0;
+
+    while(curr != NULL) {
+        int gathered = ds_sll_simdGatherBlock(linkedList, &curr, &block, 0, value_size, NULL, &status);
+        total += kernels->count[type](block.bytes, gathered, key);
+    }
+
+    return (status == DS_SLL_NO_ERROR) ? total : -1;
+}
+
+
+/**
+ * @brief Reduce a list to its smallest or largest value
+ * @param linkedList The singly linked list to reduce
+ * @param type The type of the values stored in the list
+ * @param reduce The min or max kernel to use
+ * @param result Pointer to a value of the given type that is set to the result
+ * @return @ref ds_sll_error_t Error Code.
+ *
+ * The result of each block is carried over into the first slot of the next block,
+ * so a single kernel call per block is enough.
+ */
+static ds_sll_error_t ds_sll_simdReduceList(const ds_sll_t* linkedList, ds_sll_simd_type_t type,
+                                            void (*reduce)(const void*, int, void*), void* result)
+{
+    size_t value_size = ds_sll_simdTypeSize(type);
+    ds_sll_simd_block_t block;
+    ds_sll_node_t* curr = linkedList->head;
+    ds_sll_error_t status = DS_SLL_NO_ERROR;
+    int offset = 0;
+
+    while(curr != NULL) {
+        int gathered = ds_sll_simdGatherBlock(linkedList, &curr, &block, offset, value_size, NULL, &status);
+        reduce(block.bytes, offset + gathered, block.bytes);
+        offset = 1;
+    }
+
+    if(status != DS_SLL_NO_ERROR) {
+        return status;
+    }
+
+    memcpy(result, block.bytes, value_size);
+    return DS_SLL_NO_ERROR;
+}
+
+
+/**
+ * @brief Find the smallest value stored in a list
+ * @param linkedList The singly linked list to search. Each element must point to a value of the given type
+ * @param type The type of the values stored in the list
+ * @param result Pointer to a value of the given type that is set to the smallest value
+ * @return @ref ds_sll_error_t Error Code.
+ */
+ds_sll_error_t ds_sll_minValue(const ds_sll_t* linkedList, ds_sll_simd_type_t type, void* result)
+{
+    ASSERT((linkedList != NULL) && (linkedList->head != NULL) && (linkedList->tail != NULL) && (result != NULL));
+    return ds_sll_simdReduceList(linkedList, type, ds_sll_simdListKernels()->min[type], result);
+}
+
+
+/**
+ * @brief Find the largest value stored in a list
+ * @param linkedList The singly linked list to search. Each element must point to a value of the given type
+ * @param type The type of the values stored in the list
+ * @param result Pointer to a value of the given type that is set to the largest value
+ * @return @ref ds_sll_error_t Error Code.
+ */
+ds_sll_error_t ds_sll_maxValue(const ds_sll_t* linkedList, ds_sll_simd_type_t type, void* result)
+{
+    ASSERT((linkedList != NULL) && (linkedList->head != NULL) && (linkedList->tail != NULL) && (result != NULL));
+    return ds_sll_simdReduceList(linkedList, type, ds_sll_simdListKernels()->max[type], result);
+}
+
+
+/**
+ * @brief Sum the values stored in a list
+ * @param linkedList The singly linked list to sum. Each element must point to a value of the given type
+ * @param type The type of the values stored in the list
+ * @param result Pointer to an int64_t (integer types) or a double (floating point types) that is set to the sum
+ * @return @ref ds_sll_error_t Error Code.
+ */
+ds_sll_error_t ds_sll_sumValues(const ds_sll_t* linkedList, ds_sll_simd_type_t type, void* result)
+{
+    ASSERT((linkedList != NULL) && (linkedList->head != NULL) && (linkedList->tail != NULL) && (result != NULL));
+
+    const ds_sll_simd_kernels_t* kernels = ds_sll_simdListKernels();
+    size_t value_size = ds_sll_simdTypeSize(type);
+    int is_integer = (type == DS_SLL_SIMD_INT32) || (type == DS_SLL_SIMD_INT64);
+    ds_sll_simd_block_t block;
+    ds_sll_node_t* curr = linkedList->head;
+    ds_sll_error_t status = DS_SLL_NO_ERROR;
+    int64_t integer_total = 0;
+    double floating_total = 0;
+
+    while(curr != NULL) {
+        int gathered = ds_sll_simdGatherBlock(linkedList, &curr, &block, 0, value_size, NULL, &status);
+        if(is_integer) {
+            int64_t partial;
+            kernels->sum[type](block.bytes, gathered, &partial);
+            integer_total += partial;
+        } else {
+            double partial;
+            kernels->sum[type](block.bytes, gathered, &partial);
+            floating_total += partial;
+        }
+    }
+
+    if(status != DS_SLL_NO_ERROR) {
+        return status;
+    }
+
+    if(is_integer) {
+        *(int64_t*) result = integer_total;
+    } else {
+        *(double*) result = floating_total;
+    }
+    return DS_SLL_NO_ERROR;
+}
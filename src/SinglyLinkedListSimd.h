@@ -0,0 +1,96 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2017 Ronny Majani
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#ifndef RM_DS_SLL_SINGLYLINKEDLISTSIMD_H
+#define RM_DS_SLL_SINGLYLINKEDLISTSIMD_H
+
+#include "SinglyLinkedList.h"
+
+/**
+ * @ingroup singlylinkedlist
+ * @{
+ */
+
+/**
+ * @file SinglyLinkedListSimd.h
+ * @brief Vectorized search and reduction kernels for Singly Linked Lists of fixed-width keys (Header) (ds_sll)
+ *
+ * The kernels operate on blocks of contiguously stored values of one of the types listed in @ref ds_sll_simd_type_t.
+ * They can be used directly on plain arrays, or through the list level functions which gather the elements
+ * of a @ref ds_sll_t into blocks and then run the kernels on those blocks.
+ *
+ * The best instruction set supported by the running CPU (AVX2, SSE2, or plain C) is selected at runtime for the
+ * block kernels. The list functions always run the plain C kernels: a traversal is bound by following the `next`
+ * pointers, and the vectorized kernels did not consistently beat @ref ds_sll_findNodeContainingElement there.
+ **/
+
+/* Datatype definitions */
+/**
+ * The fixed-width value types supported by the vectorized kernels.
+ * Elements of a list searched with these kernels must point to a value of the given type.
+ */
+typedef enum ds_sll_simd_type_t {
+    DS_SLL_SIMD_INT32 = 0, /**< int32_t values. Sums are accumulated in an int64_t */
+    DS_SLL_SIMD_INT64, /**< int64_t values. Sums are accumulated in an int64_t */
+    DS_SLL_SIMD_FLOAT, /**< float values. Sums are accumulated in a double */
+    DS_SLL_SIMD_DOUBLE /**< double values. Sums are accumulated in a double */
+} ds_sll_simd_type_t;
+
+/**
+ * Instruction set levels the kernels can be dispatched to
+ */
+typedef enum ds_sll_simd_level_t {
+    DS_SLL_SIMD_SCALAR = 0, /**< Portable C fallback */
+    DS_SLL_SIMD_SSE2, /**< 128-bit SSE2 kernels */
+    DS_SLL_SIMD_AVX2 /**< 256-bit AVX2 kernels */
+} ds_sll_simd_level_t;
+/* ------------------------------------------------------------------ */
+
+
+/* Functions */
+// Dispatch
+ds_sll_simd_level_t ds_sll_simdDetectLevel();
+ds_sll_simd_level_t ds_sll_simdGetLevel();
+ds_sll_simd_level_t ds_sll_simdSetLevel(ds_sll_simd_level_t level);
+size_t ds_sll_simdTypeSize(ds_sll_simd_type_t type);
+// Kernels on contiguous blocks
+int ds_sll_simdFindFirst(const void* values, int count, ds_sll_simd_type_t type, const void* key);
+int ds_sll_simdCount(const void* values, int count, ds_sll_simd_type_t type, const void* key);
+ds_sll_error_t ds_sll_simdMin(const void* values, int count, ds_sll_simd_type_t type, void* result);
+ds_sll_error_t ds_sll_simdMax(const void* values, int count, ds_sll_simd_type_t type, void* result);
+ds_sll_error_t ds_sll_simdSum(const void* values, int count, ds_sll_simd_type_t type, void* result);
+// Kernels on lists
+ds_sll_node_t* ds_sll_findNodeContainingValue(const ds_sll_t* linkedList, ds_sll_simd_type_t type, const void* key, int *resultIndex);
+int ds_sll_countNodesContainingValue(const ds_sll_t* linkedList, ds_sll_simd_type_t type, const void* key);
+ds_sll_error_t ds_sll_minValue(const ds_sll_t* linkedList, ds_sll_simd_type_t type, void* result);
+ds_sll_error_t ds_sll_maxValue(const ds_sll_t* linkedList, ds_sll_simd_type_t type, void* result);
+ds_sll_error_t ds_sll_sumValues(const ds_sll_t* linkedList, ds_sll_simd_type_t type, void* result);
+/* ------------------------------------------------------------------ */
+
+
+/**
+ * @}
+ */
+
+#endif //RM_DS_SLL_SINGLYLINKEDLISTSIMD_H
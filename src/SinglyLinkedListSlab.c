@@ -0,0 +1,461 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2017 Ronny Majani
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+/**
+ * @ingroup singlylinkedlist
+ * @file SinglyLinkedListSlab.c
+ * @brief Huge page backed node slabs for Singly Linked Lists (ds_sll)
+ *
+ * Category: Data Structures >> Linked Lists
+ * Codename: ds_sll
+ *
+ * ### Usage:
+ * + Create a slab, choosing the size of the inline element copies (0 for none) and the pages to request
+ * + Create nodes from it (or append elements to a list through it), and use them with any list operation
+ * + Delete single nodes with @ref ds_sll_slabDeleteNode, whole lists with @ref ds_sll_slabReleaseList
+ * + Destroying the slab unmaps every region at once, invalidating all its nodes
+ *
+ * ### Page Fallback:
+ * Explicit huge pages (`MAP_HUGETLB`) only exist when the administrator reserved some, so a failed
+ * explicit mapping falls back to a transparent huge page mapping. That one is aligned to 2 MiB and advised
+ * with `madvise(MADV_HUGEPAGE)`; if the kernel refuses the advice, the region keeps its regular pages.
+ * The pages each region ended up with are recorded in the region.
+ **/
+
+#include "SinglyLinkedListSlab.h"
+#include "SinglyLinkedListTrace.h"
+#include <assert.h>
+#include <memory.h>
+#include <stdint.h>
+#include <sys/mman.h>
+
+/**
+ * @brief Macro definition for ASSERT
+ * Used to enforce Design by Contract coding
+ * Typically disabled on release
+ */
+#define ASSERT assert
+
+/**
+ * @brief Size of a huge page, regions are a multiple of it
+ */
+#define DS_SLL_SLAB_HUGE_PAGE_SIZE ((size_t) 2 * 1024 * 1024)
+
+/**
+ * @brief Region size used when none is given (64 MiB)
+ */
+#define DS_SLL_SLAB_DEFAULT_REGION_SIZE (32 * DS_SLL_SLAB_HUGE_PAGE_SIZE)
+
+/**
+ * @brief Alignment of the slab objects (nodes and their payload)
+ */
+#define DS_SLL_SLAB_ALIGNMENT ((size_t) 16)
+
+#if !defined(MAP_ANONYMOUS) && defined(MAP_ANON)
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+
+
+/**
+ * @brief Map an anonymous region with regular pages
+ * @return The mapping, or NULL if an error occurred
+ */
+static void* ds_sll_slabMapRegular(size_t size)
+{
+    void* base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return (base == MAP_FAILED) ? NULL : base;
+}
+
+
+/**
+ * @brief Map an anonymous region aligned to a huge page, and advise the kernel to back it with transparent huge pages
+ * @param size The size of the region, a multiple of @ref DS_SLL_SLAB_HUGE_PAGE_SIZE
+ * @param pages Set to the pages backing the region
+ * @return The mapping, or NULL if an error occurred
+ */
+static void* ds_sll_slabMapTransparent(size_t size, ds_sll_slab_pages_t* pages)
+{
+    // over-reserve, then trim both ends so the region starts on a huge page boundary
+    char* raw = (char*) ds_sll_slabMapRegular(size + DS_SLL_SLAB_HUGE_PAGE_SIZE);
+    char* base;
+
+    if(raw == NULL) {
+        return NULL;
+    }
+
+    base = (char*) (((uintptr_t) raw + DS_SLL_SLAB_HUGE_PAGE_SIZE - 1) & ~(uintptr_t) (DS_SLL_SLAB_HUGE_PAGE_SIZE - 1));
+    if(base != raw) {
+        munmap(raw, (size_t) (base - raw));
+    }
+    if(base + size != raw + size + DS_SLL_SLAB_HUGE_PAGE_SIZE) {
+        munmap(base + size, (size_t) (raw + DS_SLL_SLAB_HUGE_PAGE_SIZE - base));
+    }
+
+    *pages = DS_SLL_SLAB_PAGES_DEFAULT;
+#ifdef MADV_HUGEPAGE
+    if(madvise(base, size, MADV_HUGEPAGE) == 0) {
+        *pages = DS_SLL_SLAB_PAGES_TRANSPARENT;
+    }
+#endif
+    return base;
+}
+
+
+/**
+ * @brief Reserve a new region for the slab and make it the one objects are carved from
+ * @return @ref ds_sll_error_t Error Code.
+ */
+static ds_sll_error_t ds_sll_slabGrow(ds_sll_slab_t* slab)
+{
+    ds_sll_slab_region_t* region = (ds_sll_slab_region_t*) malloc(sizeof(ds_sll_slab_region_t));
+
+    if(region == NULL) {
+        return DS_SLL_MEMORY_ALLOCATION_ERROR;
+    }
+
+    region->size = slab->region_size;
+    region->base = NULL;
+#ifdef MAP_HUGETLB
+    if(slab->pages == DS_SLL_SLAB_PAGES_EXPLICIT) {
+        region->base = mmap(NULL, region->size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if(region->base == MAP_FAILED) { // no huge pages reserved, fall back to transparent huge pages
+            region->base = NULL;
+        } else {
+            region->pages = DS_SLL_SLAB_PAGES_EXPLICIT;
+        }
+    }
+#endif
+    if((region->base == NULL) && (slab->pages != DS_SLL_SLAB_PAGES_DEFAULT)) {
+        region->base = ds_sll_slabMapTransparent(region->size, &region->pages);
+    }
+    if(region->base == NULL) {
+        region->base = ds_sll_slabMapRegular(region->size);
+        region->pages = DS_SLL_SLAB_PAGES_DEFAULT;
+    }
+    if(region->base == NULL) {
+        free(region);
+        return DS_SLL_MEMORY_ALLOCATION_ERROR;
+    }
+
+    region->next = slab->regions;
+    slab->regions = region;
+    slab->next_object = (char*) region->base;
+    slab->region_end = (char*) region->base + region->size;
+    return DS_SLL_NO_ERROR;
+}
+
+
+/**
+ * @brief Take an object (a node and its payload) from the slab
+ * @return The uninitialized node, or NULL if an error occurred
+ */
+static ds_sll_node_t* ds_sll_slabAllocate(ds_sll_slab_t* slab)
+{
+    ds_sll_node_t* node = slab->free_nodes;
+
+    if(node != NULL) {
+        slab->free_nodes = ds_sll_nextNode(node);
+    } else {
+        if((size_t) (slab->region_end - slab->next_object) < slab->object_size) {
+            if(ds_sll_slabGrow(slab) != DS_SLL_NO_ERROR) {
+                return NULL;
+            }
+        }
+        node = (ds_sll_node_t*) slab->next_object;
+        slab->next_object += slab->object_size;
+    }
+
+    slab->live_nodes++;
+    return node;
+}
+
+
+/**
+ * @brief Get the inline payload of a slab node
+ */
+static inline void* ds_sll_slabPayload(ds_sll_node_t* node)
+{
+    return (char*) node + sizeof(ds_sll_node_t);
+}
+
+
+/**
+ * @brief Create a new node slab. No memory is reserved until the first node is created
+ * @param payload_size Maximum size of the elements copied inline after their node (see @ref ds_sll_slabCreateNodeCopy), 0 for none
+ * @param region_size Size of the regions reserved at a time (rounded up to a multiple of 2 MiB), 0 for the default (64 MiB)
+ * @param pages The pages to request. Requests that can not be satisfied fall back to smaller pages
+ * @return A pointer to the new slab, or NULL if an error occurred
+ */
+ds_sll_slab_t* ds_sll_newSlab(size_t payload_size, size_t region_size, ds_sll_slab_pages_t pages)
+{
+    ds_sll_slab_t* slab = (ds_sll_slab_t*) malloc(sizeof(ds_sll_slab_t));
+
+    if(slab == NULL) {
+        return NULL;
+    }
+
+    slab->payload_size = payload_size;
+    slab->object_size = (sizeof(ds_sll_node_t) + payload_size + DS_SLL_SLAB_ALIGNMENT - 1) & ~(DS_SLL_SLAB_ALIGNMENT - 1);
+    if(region_size == 0) {
+        region_size = DS_SLL_SLAB_DEFAULT_REGION_SIZE;
+    }
+    if(region_size < slab->object_size) {
+        region_size = slab->object_size;
+    }
+    slab->region_size = (region_size + DS_SLL_SLAB_HUGE_PAGE_SIZE - 1) & ~(DS_SLL_SLAB_HUGE_PAGE_SIZE - 1);
+    slab->pages = pages;
+    slab->regions = NULL;
+    slab->next_object = NULL;
+    slab->region_end = NULL;
+    slab->free_nodes = NULL;
+    slab->live_nodes = 0;
+    return slab;
+}
+
+
+/**
+ * @brief Unmap all the regions of a slab, free its resources, and set the given pointer to NULL
+ * @param slab The slab to destroy
+ *
+ * Every node of the slab becomes invalid, so the lists using them must not be accessed anymore.
+ * Elements stored by pointer (see @ref ds_sll_slabCreateNode) in nodes that were not deleted are not freed.
+ */
+void ds_sll_destroySlab(ds_sll_slab_t** slab)
+{
+    ASSERT(slab != NULL);
+
+    if(*slab == NULL) {
+        return;
+    }
+
+    while((*slab)->regions != NULL) {
+        ds_sll_slab_region_t* region = (*slab)->regions;
+        (*slab)->regions = region->next;
+        munmap(region->base, region->size);
+        free(region);
+    }
+
+    free(*slab);
+    *slab = NULL;
+}
+
+
+/**
+ * @brief Create a node from the slab holding the given element pointer
+ * @param slab The slab to allocate the node from
+ * @param element The element to store in the node. It is owned by the node from now on
+ * @return The new node, or NULL if an error occurred
+ */
+ds_sll_node_t* ds_sll_slabCreateNode(ds_sll_slab_t* slab, void* element)
+{
+    ASSERT(slab != NULL);
+    ds_sll_node_t* new_node = ds_sll_slabAllocate(slab);
+
+    if(new_node == NULL) {
+        return NULL;
+    }
+
+    ds_sll_storeElementInNode(new_node, element);
+    new_node->next = NULL;
+    return new_node;
+}
+
+
+/**
+ * @brief Create a node from the slab holding an inline copy of the given element
+ * @param slab The slab to allocate the node from
+ * @param element The element to copy right after the node
+ * @param element_size The size of the element, at most the payload size of the slab
+ * @return The new node, or NULL if an error occurred
+ *
+ * The element lives in the same slab object as its node, so traversals touching the elements stay within the slab.
+ */
+ds_sll_node_t* ds_sll_slabCreateNodeCopy(ds_sll_slab_t* slab, void* element, const size_t element_size)
+{
+    ASSERT((slab != NULL) && (element != NULL) && (element_size <= slab->payload_size));
+    ds_sll_node_t* new_node = ds_sll_slabAllocate(slab);
+
+    if(new_node == NULL) {
+        return NULL;
+    }
+
+    memcpy(ds_sll_slabPayload(new_node), element, element_size);
+    ds_sll_storeElementInNode(new_node, ds_sll_slabPayload(new_node));
+    new_node->next = NULL;
+    return new_node;
+}
+
+
+/**
+ * @brief Return a node (that is not part of a list) to its slab, free its element, and set the Node pointer to NULL
+ * @param slab The slab the node was allocated from
+ * @param node The node to delete
+ *
+ * Inline element copies are released along with the node, elements stored by pointer are freed.
+ */
+void ds_sll_slabDeleteNode(ds_sll_slab_t* slab, ds_sll_node_t** node)
+{
+    ASSERT((slab != NULL) && (node != NULL));
+
+    if(*node == NULL) {
+        return;
+    }
+
+    if((slab->payload_size == 0) || (ds_sll_extractElementFromNode(*node) != ds_sll_slabPayload(*node))) {
+        ds_sll_deleteElement(&(*node)->element);
+    }
+
+    (*node)->next = slab->free_nodes;
+    slab->free_nodes = *node;
+    slab->live_nodes--;
+    *node = NULL;
+}
+
+
+/**
+ * @brief Append an element pointer to the end of a list, in a node allocated from the slab
+ * @param slab The slab to allocate the node from
+ * @param linkedList The singly linked list to append to
+ * @param element The element to append. It is owned by the node from now on
+ * @return @ref ds_sll_error_t Error Code.
+ */
+ds_sll_error_t ds_sll_slabAppendElement(ds_sll_slab_t* slab, ds_sll_t* linkedList, void* element)
+{
+    ASSERT(linkedList != NULL);
+    // the append that follows is how the slab builds the list, not a user operation
+    DS_SLL_TRACE(DS_SLL_TRACE_NONE, NULL, NULL, 0, 0);
+    ds_sll_node_t* new_node = ds_sll_slabCreateNode(slab, element);
+
+    if(new_node == NULL) {
+        return DS_SLL_NODE_CREATION_ERROR;
+    }
+
+    ds_sll_appendNode(linkedList, new_node);
+    return DS_SLL_NO_ERROR;
+}
+
+
+/**
+ * @brief Append an inline copy of an element to the end of a list, in a node allocated from the slab
+ * @param slab The slab to allocate the node from
+ * @param linkedList The singly linked list to append to
+ * @param element The element to copy
+ * @param element_size The size of the element, at most the payload size of the slab
+ * @return @ref ds_sll_error_t Error Code.
+ */
+ds_sll_error_t ds_sll_slabAppendElementCopy(ds_sll_slab_t* slab, ds_sll_t* linkedList, void* element, const size_t element_size)
+{
+    ASSERT(linkedList != NULL);
+    DS_SLL_TRACE(DS_SLL_TRACE_NONE, NULL, NULL, 0, 0);
+    ds_sll_node_t* new_node = ds_sll_slabCreateNodeCopy(slab, element, element_size);
+
+    if(new_node == NULL) {
+        return DS_SLL_NODE_CREATION_ERROR;
+    }
+
+    ds_sll_appendNode(linkedList, new_node);
+    return DS_SLL_NO_ERROR;
+}
+
+
+/**
+ * @brief Return all the nodes of a list to their slab (see @ref ds_sll_slabDeleteNode), leaving the list empty
+ * @param slab The slab all the nodes of the list were allocated from
+ * @param linkedList The singly linked list to empty. The header itself is not freed
+ */
+void ds_sll_slabReleaseList(ds_sll_slab_t* slab, ds_sll_t* linkedList)
+{
+    ASSERT((slab != NULL) && (linkedList != NULL));
+    ds_sll_node_t* node = linkedList->head;
+
+    while(node != NULL) {
+        ds_sll_node_t* todel = node;
+        node = ds_sll_nextNode(node);
+        ds_sll_slabDeleteNode(slab, &todel);
+    }
+
+    linkedList->head = NULL;
+    linkedList->tail = NULL;
+}
+
+
+/**
+ * @brief Get the number of bytes reserved by the slab
+ * @param slab The slab
+ * @return The total size of its regions
+ */
+size_t ds_sll_slabReservedBytes(const ds_sll_slab_t* slab)
+{
+    ASSERT(slab != NULL);
+    const ds_sll_slab_region_t* region;
+    size_t bytes = 0;
+
+    for(region = slab->regions; region != NULL; region = region->next) {
+        bytes += region->size;
+    }
+    return bytes;
+}
+
+
+/**
+ * @brief Get the number of reserved bytes backed (or advised to be backed) by huge pages
+ * @param slab The slab
+ * @return The total size of its regions that are not using regular pages
+ *         (see @ref ds_sll_slabPageBytes to tell explicit huge pages from advised ones)
+ */
+size_t ds_sll_slabHugePageBytes(const ds_sll_slab_t* slab)
+{
+    ASSERT(slab != NULL);
+    const ds_sll_slab_region_t* region;
+    size_t bytes = 0;
+
+    for(region = slab->regions; region != NULL; region = region->next) {
+        if(region->pages != DS_SLL_SLAB_PAGES_DEFAULT) {
+            bytes += region->size;
+        }
+    }
+    return bytes;
+}
+
+
+/**
+ * @brief Get the number of reserved bytes backed by the given kind of pages
+ * @param slab The slab
+ * @param pages The kind of pages
+ * @return The total size of its regions that ended up with the given pages.
+ *         Eg: 0 for DS_SLL_SLAB_PAGES_EXPLICIT when every explicit mapping fell back to transparent huge pages
+ */
+size_t ds_sll_slabPageBytes(const ds_sll_slab_t* slab, ds_sll_slab_pages_t pages)
+{
+    ASSERT(slab != NULL);
+    const ds_sll_slab_region_t* region;
+    size_t bytes = 0;
+
+    for(region = slab->regions; region != NULL; region = region->next) {
+        if(region->pages == pages) {
+            bytes += region->size;
+        }
+    }
+    return bytes;
+}
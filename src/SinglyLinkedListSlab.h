@@ -0,0 +1,109 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2017 Ronny Majani
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#ifndef RM_DS_SLL_SINGLYLINKEDLISTSLAB_H
+#define RM_DS_SLL_SINGLYLINKEDLISTSLAB_H
+
+#include "SinglyLinkedList.h"
+
+/**
+ * @ingroup singlylinkedlist
+ * @{
+ */
+
+/**
+ * @file SinglyLinkedListSlab.h
+ * @brief Huge page backed node slabs for Singly Linked Lists (Header) (ds_sll)
+ *
+ * A slab carves nodes (and optionally an inline copy of their element) out of large memory regions
+ * reserved with `mmap`, backed by 2 MiB pages where the system allows it. Giant lists allocated from a slab
+ * are packed densely and need far fewer TLB entries to traverse than nodes scattered by `malloc`.
+ *
+ * Nodes of a slab are regular @ref ds_sll_node_t and work with every list operation,
+ * but they must be deleted with @ref ds_sll_slabDeleteNode or @ref ds_sll_slabReleaseList,
+ * never with @ref ds_sll_deleteNode or @ref ds_sll_destroySinglyLinkedList.
+ * A slab is not thread-safe.
+ **/
+
+/* Datatype definitions */
+/**
+ * Page sizes backing a slab
+ */
+typedef enum ds_sll_slab_pages_t {
+    DS_SLL_SLAB_PAGES_DEFAULT = 0, /**< Regular pages */
+    DS_SLL_SLAB_PAGES_TRANSPARENT, /**< Regular mapping advised to use transparent huge pages (`MADV_HUGEPAGE`) */
+    DS_SLL_SLAB_PAGES_EXPLICIT /**< Explicit huge pages (`MAP_HUGETLB`), needs pages reserved by the system */
+} ds_sll_slab_pages_t;
+
+/**
+ * A memory region reserved by a slab
+ */
+typedef struct ds_sll_slab_region_t {
+    void* base; /**< Start of the mapping */
+    size_t size; /**< Size of the mapping */
+    ds_sll_slab_pages_t pages; /**< Pages actually backing the mapping */
+    struct ds_sll_slab_region_t* next; /**< Next region of the slab */
+} ds_sll_slab_region_t;
+
+/**
+ * Node slab datatype
+ */
+typedef struct ds_sll_slab_t {
+    size_t payload_size; /**< Maximum size of an inline element copy, 0 for nodes only */
+    size_t object_size; /**< Size of a node and its payload, rounded up to keep nodes aligned */
+    size_t region_size; /**< Size of every region, a multiple of 2 MiB */
+    ds_sll_slab_pages_t pages; /**< Requested pages */
+    ds_sll_slab_region_t* regions; /**< Reserved regions, the newest first */
+    char* next_object; /**< Next never used object of the newest region */
+    char* region_end; /**< End of the newest region */
+    ds_sll_node_t* free_nodes; /**< Deleted nodes, linked through their `next` pointer */
+    size_t live_nodes; /**< Number of nodes currently allocated from the slab */
+} ds_sll_slab_t;
+/* ------------------------------------------------------------------ */
+
+
+/* Functions */
+// Create/Delete
+ds_sll_slab_t* ds_sll_newSlab(size_t payload_size, size_t region_size, ds_sll_slab_pages_t pages);
+void ds_sll_destroySlab(ds_sll_slab_t** slab);
+// Nodes
+ds_sll_node_t* ds_sll_slabCreateNode(ds_sll_slab_t* slab, void* element);
+ds_sll_node_t* ds_sll_slabCreateNodeCopy(ds_sll_slab_t* slab, void* element, const size_t element_size);
+void ds_sll_slabDeleteNode(ds_sll_slab_t* slab, ds_sll_node_t** node);
+// Lists
+ds_sll_error_t ds_sll_slabAppendElement(ds_sll_slab_t* slab, ds_sll_t* linkedList, void* element);
+ds_sll_error_t ds_sll_slabAppendElementCopy(ds_sll_slab_t* slab, ds_sll_t* linkedList, void* element, const size_t element_size);
+void ds_sll_slabReleaseList(ds_sll_slab_t* slab, ds_sll_t* linkedList);
+// Statistics
+size_t ds_sll_slabReservedBytes(const ds_sll_slab_t* slab);
+size_t ds_sll_slabHugePageBytes(const ds_sll_slab_t* slab);
+size_t ds_sll_slabPageBytes(const ds_sll_slab_t* slab, ds_sll_slab_pages_t pages);
+/* ------------------------------------------------------------------ */
+
+
+/**
+ * @}
+ */
+
+#endif //RM_DS_SLL_SINGLYLINKEDLISTSLAB_H
@@ -0,0 +1,392 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2017 Ronny Majani
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+/**
+ * @ingroup singlylinkedlist
+ * @file SinglyLinkedListTrace.c
+ * @brief Workload trace recording for Singly Linked Lists (ds_sll)
+ *
+ * Category: Data Structures >> Linked Lists
+ * Codename: ds_sll
+ *
+ * ### Trace Format:
+ * An 8 byte magic ("DSLLTRC" followed by the format version), the size of one record as a uint32_t,
+ * then one @ref ds_sll_trace_record_t per recorded call, in host byte order.
+ *
+ * ### Recording:
+ * Each public list function of SinglyLinkedList.c starts with a @ref DS_SLL_TRACE hook. The hook keeps a per thread
+ * nesting depth so that only the outermost call is recorded (eg: ds_sll_appendElementCopy, but not the
+ * ds_sll_appendElement and ds_sll_appendNode calls it makes). The other modules open a DS_SLL_TRACE_NONE scope
+ * around the core calls they make internally (eg: the embedded list of a lazy list), so those are never recorded
+ * either. Lists are identified by small ids assigned the first time a list is seen, and forgotten when the list
+ * is destroyed, so a reused address gets a new id.
+ * Recording is serialized by a mutex; while not recording a hook costs a thread local increment and a load.
+ **/
+
+#include "SinglyLinkedListTrace.h"
+#include <assert.h>
+#include <pthread.h>
+#include <string.h>
+
+/**
+ * @brief Macro definition for ASSERT
+ * Used to enforce Design by Contract coding
+ * Typically disabled on release
+ */
+#define ASSERT assert
+
+/**
+ * @brief Magic bytes at the start of every trace file (the last byte is the format version)
+ */
+#define DS_SLL_TRACE_MAGIC "DSLLTRC\1"
+
+/**
+ * @brief Initial capacity of the list id table (must be a power of 2)
+ */
+#define DS_SLL_TRACE_INITIAL_CAPACITY 64
+
+static pthread_mutex_t ds_sll_traceLock = PTHREAD_MUTEX_INITIALIZER; /**< Guards everything below */
+static FILE* ds_sll_traceFile = NULL; /**< The trace being recorded, NULL when not recording */
+static int ds_sll_traceActive = 0; /**< 1 while recording. Read atomically by the hooks */
+static const ds_sll_t** ds_sll_traceKeys = NULL; /**< List id table: the lists (open addressing, NULL = empty slot) */
+static uint32_t* ds_sll_traceIds = NULL; /**< List id table: the id of the list in the same slot */
+static size_t ds_sll_traceCapacity = 0; /**< Number of slots of the list id table */
+static size_t ds_sll_traceCount = 0; /**< Number of lists in the list id table */
+static uint32_t ds_sll_traceNextId = 1; /**< Id given to the next list seen */
+static _Thread_local int ds_sll_traceDepth = 0; /**< Nesting depth of traced calls on this thread */
+
+
+/**
+ * @brief Slot of the list id table a list hashes to
+ */
+static inline size_t ds_sll_traceSlot(const ds_sll_t* linkedList, size_t capacity)
+{
+    uintptr_t key = (uintptr_t) linkedList;
+    key ^= key >> 17;
+    key *= (uintptr_t) 0x9E3779B97F4A7C15ull;
+    return (size_t) (key ^ (key >> 29)) & (capacity - 1);
+}
+
+
+/**
+ * @brief Free the list id table (ds_sll_traceLock must be held)
+ */
+static void ds_sll_traceClearIds()
+{
+    free(ds_sll_traceKeys);
+    free(ds_sll_traceIds);
+    ds_sll_traceKeys = NULL;
+    ds_sll_traceIds = NULL;
+    ds_sll_traceCapacity = 0;
+    ds_sll_traceCount = 0;
+    ds_sll_traceNextId = 1;
+}
+
+
+/**
+ * @brief Resize the list id table (ds_sll_traceLock must be held)
+ * @param capacity The new number of slots (a power of 2)
+ * @return 0 on success, -1 if the allocation failed (the table is left unchanged)
+ */
+static int ds_sll_traceResize(size_t capacity)
+{
+    const ds_sll_t** keys = (const ds_sll_t**) calloc(capacity, sizeof(const ds_sll_t*));
+    uint32_t* ids = (uint32_t*) malloc(capacity * sizeof(uint32_t));
+    size_t i;
+
+    if((keys == NULL) || (ids == NULL)) {
+        free(keys);
+        free(ids);
+        return -1;
+    }
+
+    for(i = 0; i < ds_sll_traceCapacity; i++) {
+        if(ds_sll_traceKeys[i] != NULL) {
+            size_t slot = ds_sll_traceSlot(ds_sll_traceKeys[i], capacity);
+            while(keys[slot] != NULL) {
+                slot = (slot + 1) & (capacity - 1);
+            }
+            keys[slot] = ds_sll_traceKeys[i];
+            ids[slot] = ds_sll_traceIds[i];
+        }
+    }
+
+    free(ds_sll_traceKeys);
+    free(ds_sll_traceIds);
+    ds_sll_traceKeys = keys;
+    ds_sll_traceIds = ids;
+    ds_sll_traceCapacity = capacity;
+    return 0;
+}
+
+
+/**
+ * @brief Get the id of a list, assigning a new one the first time it is seen (ds_sll_traceLock must be held)
+ * @param linkedList The list (may be NULL)
+ * @return The id of the list, or 0 for NULL (or if the id table could not grow)
+ */
+static uint32_t ds_sll_traceListId(const ds_sll_t* linkedList)
+{
+    if(linkedList == NULL) {
+        return 0;
+    }
+
+    if((ds_sll_traceCount + 1) * 2 > ds_sll_traceCapacity) {
+        size_t capacity = (ds_sll_traceCapacity == 0) ? DS_SLL_TRACE_INITIAL_CAPACITY : ds_sll_traceCapacity * 2;
+        if(ds_sll_traceResize(capacity) != 0) {
+            return 0;
+        }
+    }
+
+    size_t slot = ds_sll_traceSlot(linkedList, ds_sll_traceCapacity);
+    while(ds_sll_traceKeys[slot] != NULL) {
+        if(ds_sll_traceKeys[slot] == linkedList) {
+            return ds_sll_traceIds[slot];
+        }
+        slot = (slot + 1) & (ds_sll_traceCapacity - 1);
+    }
+
+    ds_sll_traceKeys[slot] = linkedList;
+    ds_sll_traceIds[slot] = ds_sll_traceNextId++;
+    ds_sll_traceCount++;
+    return ds_sll_traceIds[slot];
+}
+
+
+/**
+ * @brief Remove a destroyed list from the id table (ds_sll_traceLock must be held)
+ * @param linkedList The destroyed list
+ *
+ * Uses backward shift deletion, so lookups never need tombstones.
+ */
+static void ds_sll_traceForgetList(const ds_sll_t* linkedList)
+{
+    if((linkedList == NULL) || (ds_sll_traceCapacity == 0)) {
+        return;
+    }
+
+    size_t mask = ds_sll_traceCapacity - 1;
+    size_t slot = ds_sll_traceSlot(linkedList, ds_sll_traceCapacity);
+
+    while(ds_sll_traceKeys[slot] != linkedList) {
+        if(ds_sll_traceKeys[slot] == NULL) {
+            return;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    // shift back the following entries that would no longer be reachable through the emptied slot
+    size_t next = (slot + 1) & mask;
+    while(ds_sll_traceKeys[next] != NULL) {
+        size_t home = ds_sll_traceSlot(ds_sll_traceKeys[next], ds_sll_traceCapacity);
+        if(((next - home) & mask) >= ((next - slot) & mask)) {
+            ds_sll_traceKeys[slot] = ds_sll_traceKeys[next];
+            ds_sll_traceIds[slot] = ds_sll_traceIds[next];
+            slot = next;
+        }
+        next = (next + 1) & mask;
+    }
+
+    ds_sll_traceKeys[slot] = NULL;
+    ds_sll_traceCount--;
+}
+
+
+/**
+ * @brief Append a record to the trace
+ */
+static void ds_sll_traceWrite(ds_sll_trace_op_t op, const ds_sll_t* linkedList, const ds_sll_t* otherList, int index, size_t element_size)
+{
+    ds_sll_trace_record_t record;
+
+    pthread_mutex_lock(&ds_sll_traceLock);
+    if(ds_sll_traceFile != NULL) {
+        memset(&record, 0, sizeof(record));
+        record.op = (uint8_t) op;
+        record.list_id = ds_sll_traceListId(linkedList);
+        record.other_list_id = ds_sll_traceListId(otherList);
+        record.index = (int32_t) index;
+        record.element_size = (uint32_t) element_size;
+        fwrite(&record, sizeof(record), 1, ds_sll_traceFile);
+
+        if(op == DS_SLL_TRACE_DESTROY_LIST) {
+            ds_sll_traceForgetList(linkedList);
+        }
+    }
+    pthread_mutex_unlock(&ds_sll_traceLock);
+}
+
+
+/**
+ * @brief Start recording every public list operation to a new trace file
+ * @param path The file to write the trace to (overwritten)
+ * @return @ref ds_sll_error_t Error code. DS_SLL_TRACE_ERROR if the file could not be opened,
+ *         a trace is already being recorded, or the library was built without DS_SLL_TRACE_ENABLED
+ */
+ds_sll_error_t ds_sll_traceStart(const char* path)
+{
+    ASSERT(path != NULL);
+
+#ifndef DS_SLL_TRACE_ENABLED
+    return DS_SLL_TRACE_ERROR;
+#else
+    uint32_t record_size = sizeof(ds_sll_trace_record_t);
+
+    pthread_mutex_lock(&ds_sll_traceLock);
+    if(ds_sll_traceFile != NULL) {
+        pthread_mutex_unlock(&ds_sll_traceLock);
+        return DS_SLL_TRACE_ERROR;
+    }
+
+    ds_sll_traceFile = fopen(path, "wb");
+    if((ds_sll_traceFile == NULL)
+       || (fwrite(DS_SLL_TRACE_MAGIC, 8, 1, ds_sll_traceFile) != 1)
+       || (fwrite(&record_size, sizeof(record_size), 1, ds_sll_traceFile) != 1)) {
+        if(ds_sll_traceFile != NULL) {
+            fclose(ds_sll_traceFile);
+            ds_sll_traceFile = NULL;
+        }
+        pthread_mutex_unlock(&ds_sll_traceLock);
+        return DS_SLL_TRACE_ERROR;
+    }
+
+    ds_sll_traceClearIds();
+    __atomic_store_n(&ds_sll_traceActive, 1, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&ds_sll_traceLock);
+    return DS_SLL_NO_ERROR;
+#endif
+}
+
+
+/**
+ * @brief Stop recording and close the trace file
+ * @return @ref ds_sll_error_t Error code. DS_SLL_TRACE_ERROR if no trace was being recorded or the file could not be written
+ */
+ds_sll_error_t ds_sll_traceStop()
+{
+    pthread_mutex_lock(&ds_sll_traceLock);
+    if(ds_sll_traceFile == NULL) {
+        pthread_mutex_unlock(&ds_sll_traceLock);
+        return DS_SLL_TRACE_ERROR;
+    }
+
+    __atomic_store_n(&ds_sll_traceActive, 0, __ATOMIC_RELEASE);
+    int failed = ferror(ds_sll_traceFile);
+    failed |= fclose(ds_sll_traceFile);
+    ds_sll_traceFile = NULL;
+    ds_sll_traceClearIds();
+    pthread_mutex_unlock(&ds_sll_traceLock);
+
+    return (failed != 0) ? DS_SLL_TRACE_ERROR : DS_SLL_NO_ERROR;
+}
+
+
+/**
+ * @brief Open a trace file for reading and check its header
+ * @param path The trace file
+ * @return The open file positioned at the first record, or NULL if it could not be opened or is not a trace
+ */
+FILE* ds_sll_traceOpen(const char* path)
+{
+    ASSERT(path != NULL);
+    char magic[8];
+    uint32_t record_size;
+    FILE* trace = fopen(path, "rb");
+
+    if(trace == NULL) {
+        return NULL;
+    }
+
+    if((fread(magic, 8, 1, trace) != 1) || (memcmp(magic, DS_SLL_TRACE_MAGIC, 8) != 0)
+       || (fread(&record_size, sizeof(record_size), 1, trace) != 1) || (record_size != sizeof(ds_sll_trace_record_t))) {
+        fclose(trace);
+        return NULL;
+    }
+
+    return trace;
+}
+
+
+/**
+ * @brief Read the next record of a trace
+ * @param trace A trace opened with @ref ds_sll_traceOpen
+ * @param record Set to the next record
+ * @return 1 if a record was read, 0 at the end of the trace
+ */
+int ds_sll_traceRead(FILE* trace, ds_sll_trace_record_t* record)
+{
+    ASSERT((trace != NULL) && (record != NULL));
+    return fread(record, sizeof(ds_sll_trace_record_t), 1, trace) == 1;
+}
+
+
+/**
+ * @brief Get a printable name for a recorded operation
+ * @param op The operation
+ * @return A static string naming the operation
+ */
+const char* ds_sll_traceOpName(ds_sll_trace_op_t op)
+{
+    static const char* names[DS_SLL_TRACE_OP_COUNT] = {
+        "none", "new", "destroy", "append", "insert", "delete", "get", "find", "execute", "length",
+        "split", "insertAfter", "deleteAfter", "splice", "concatenate", "insertSorted", "merge", "batchGet"
+    };
+
+    return ((unsigned) op < DS_SLL_TRACE_OP_COUNT) ? names[op] : "unknown";
+}
+
+
+/**
+ * @brief Hook called at the start of a traced public function (see @ref DS_SLL_TRACE)
+ * @return A dummy value for the scope variable
+ */
+int ds_sll_traceEnter(ds_sll_trace_op_t op, const ds_sll_t* linkedList, const ds_sll_t* otherList, int index, size_t element_size)
+{
+    if((ds_sll_traceDepth++ == 0) && (op != DS_SLL_TRACE_NONE) && __atomic_load_n(&ds_sll_traceActive, __ATOMIC_RELAXED)) {
+        ds_sll_traceWrite(op, linkedList, otherList, index, element_size);
+    }
+    return 0;
+}
+
+
+/**
+ * @brief Cleanup of the scope variable declared by @ref DS_SLL_TRACE, called when a traced public function returns
+ * @param scope The scope variable (unused)
+ */
+void ds_sll_traceLeave(int* scope)
+{
+    (void) scope;
+    ds_sll_traceDepth--;
+}
+
+
+/**
+ * @brief Record a call from within a traced public function (see @ref DS_SLL_TRACE_RECORD)
+ */
+void ds_sll_traceRecord(ds_sll_trace_op_t op, const ds_sll_t* linkedList, const ds_sll_t* otherList, int index, size_t element_size)
+{
+    if((ds_sll_traceDepth == 0) && __atomic_load_n(&ds_sll_traceActive, __ATOMIC_RELAXED)) {
+        ds_sll_traceWrite(op, linkedList, otherList, index, element_size);
+    }
+}
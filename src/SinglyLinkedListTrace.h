@@ -0,0 +1,132 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2017 Ronny Majani
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#ifndef RM_DS_SLL_SINGLYLINKEDLISTTRACE_H
+#define RM_DS_SLL_SINGLYLINKEDLISTTRACE_H
+
+#include "SinglyLinkedList.h"
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * @ingroup singlylinkedlist
+ * @{
+ */
+
+/**
+ * @file SinglyLinkedListTrace.h
+ * @brief Workload trace recording for Singly Linked Lists (Header) (ds_sll)
+ *
+ * When the library is built with `DS_SLL_TRACE_ENABLED` defined (CMake option `DS_SLL_ENABLE_TRACE`),
+ * every call to a public list operation of SinglyLinkedList.h made between @ref ds_sll_traceStart and
+ * @ref ds_sll_traceStop is appended to a compact binary trace file, which the `ds_sll_replay` tool can replay.
+ * Without `DS_SLL_TRACE_ENABLED` the recording hooks compile to nothing.
+ *
+ * Known limitation: only the core operations are recorded. Functions of the other modules that rewire the nodes
+ * of a user's list themselves are not, so their effect on the list lengths is missing from the trace:
+ * the set operations of SinglyLinkedListSet.h, and the partition functions of SinglyLinkedListPartition.h
+ * (@ref ds_sll_concatenateSegments is recorded as one DS_SLL_TRACE_CONCATENATE per segment).
+ **/
+
+/* Datatype definitions */
+/**
+ * Recorded operations
+ */
+typedef enum ds_sll_trace_op_t {
+    DS_SLL_TRACE_NONE = 0, /**< Not recorded (used internally) */
+    DS_SLL_TRACE_NEW_LIST, /**< ds_sll_newSinglyLinkedList */
+    DS_SLL_TRACE_DESTROY_LIST, /**< ds_sll_destroySinglyLinkedList, ds_sll_destroySinglyLinkedListAsync */
+    DS_SLL_TRACE_APPEND, /**< ds_sll_append* (element_size is set for copies) */
+    DS_SLL_TRACE_INSERT_AT_INDEX, /**< ds_sll_insert*AtIndex */
+    DS_SLL_TRACE_DELETE_AT_INDEX, /**< ds_sll_deleteNodeAtIndex */
+    DS_SLL_TRACE_GET_AT_INDEX, /**< ds_sll_getNodeAtIndex, ds_sll_getElementAtIndex, ds_sll_traverseNodeToIndex */
+    DS_SLL_TRACE_FIND, /**< ds_sll_findNodeContainingElement (index is 1 when continuing a previous search, 0 otherwise) */
+    DS_SLL_TRACE_EXECUTE, /**< ds_sll_executeFunctionOnElements */
+    DS_SLL_TRACE_LENGTH, /**< ds_sll_calculateLength */
+    DS_SLL_TRACE_SPLIT, /**< ds_sll_splitSinglyLinkedListAtIndex (other_list_id is the second list) */
+    DS_SLL_TRACE_INSERT_AFTER, /**< ds_sll_insert*After (index 0 when inserting at the head, -1 otherwise) */
+    DS_SLL_TRACE_DELETE_AFTER, /**< ds_sll_unlinkNodeAfter, ds_sll_deleteNodeAfter, ds_sll_popHeadNode (index 0 at the head, -1 otherwise) */
+    DS_SLL_TRACE_SPLICE, /**< ds_sll_spliceAfter (other_list_id is the source list) */
+    DS_SLL_TRACE_CONCATENATE, /**< ds_sll_concatenate (other_list_id is the second list) */
+    DS_SLL_TRACE_INSERT_SORTED, /**< ds_sll_insert*Sorted */
+    DS_SLL_TRACE_MERGE, /**< ds_sll_mergeSortedLists (other_list_id is the second list) */
+    DS_SLL_TRACE_BATCH_GET, /**< ds_sll_getElementsAtIndices* (index is the number of indices) */
+    DS_SLL_TRACE_OP_COUNT /**< Number of operations */
+} ds_sll_trace_op_t;
+
+/**
+ * One recorded call. Records are stored back to back (in host byte order) after the file header
+ */
+typedef struct ds_sll_trace_record_t {
+    uint32_t list_id; /**< Id of the list the operation was called on (ids start at 1, 0 for none) */
+    uint32_t other_list_id; /**< Id of the second list of two-list operations, 0 otherwise */
+    int32_t index; /**< Index argument of the operation, or operation specific value (see @ref ds_sll_trace_op_t) */
+    uint32_t element_size; /**< Size of the copied element, 0 if the element was not copied */
+    uint8_t op; /**< The @ref ds_sll_trace_op_t */
+    uint8_t reserved[3]; /**< Padding, always 0 */
+} ds_sll_trace_record_t;
+/* ------------------------------------------------------------------ */
+
+
+/* Functions */
+// Recording
+ds_sll_error_t ds_sll_traceStart(const char* path);
+ds_sll_error_t ds_sll_traceStop();
+// Reading
+FILE* ds_sll_traceOpen(const char* path);
+int ds_sll_traceRead(FILE* trace, ds_sll_trace_record_t* record);
+const char* ds_sll_traceOpName(ds_sll_trace_op_t op);
+// Recording hooks (used by the library)
+int ds_sll_traceEnter(ds_sll_trace_op_t op, const ds_sll_t* linkedList, const ds_sll_t* otherList, int index, size_t element_size);
+void ds_sll_traceLeave(int* scope);
+void ds_sll_traceRecord(ds_sll_trace_op_t op, const ds_sll_t* linkedList, const ds_sll_t* otherList, int index, size_t element_size);
+/* ------------------------------------------------------------------ */
+
+
+/* Recording Hooks */
+#ifdef DS_SLL_TRACE_ENABLED
+/**
+ * @brief Record the enclosing public function call, unless it was made by another public function
+ * Declares a scope variable whose cleanup marks the end of the call, so nested library calls are not recorded
+ */
+#define DS_SLL_TRACE(op, linkedList, otherList, index, element_size) \
+    int ds_sll_trace_scope __attribute__((cleanup(ds_sll_traceLeave), unused)) = \
+        ds_sll_traceEnter((op), (linkedList), (otherList), (index), (element_size))
+/**
+ * @brief Record a call at the current point of a public function (when the list is only known at the end)
+ */
+#define DS_SLL_TRACE_RECORD(op, linkedList, otherList, index, element_size) \
+    ds_sll_traceRecord((op), (linkedList), (otherList), (index), (element_size))
+#else
+#define DS_SLL_TRACE(op, linkedList, otherList, index, element_size) do {} while(0)
+#define DS_SLL_TRACE_RECORD(op, linkedList, otherList, index, element_size) do {} while(0)
+#endif
+/* ------------------------------------------------------------------ */
+
+
+/**
+ * @}
+ */
+
+#endif //RM_DS_SLL_SINGLYLINKEDLISTTRACE_H
@@ -0,0 +1,126 @@
+#include "SinglyLinkedList.h"
+#include "test_common.h"
+
+/*
+ * Batched index lookups: duplicate, unsorted, negative and too large indices, on the plain and the
+ * interleaved variants. Every result must match what ds_sll_getElementAtIndex answers for that index,
+ * and an out of range index yields NULL plus DS_SLL_INDEX_OUT_OF_BOUNDS_ERROR without affecting the others.
+ */
+
+#define MAX_INDICES 64
+
+static ds_sll_t* newList(int length, int base) {
+    ds_sll_t* linkedList = ds_sll_newSinglyLinkedList();
+    for(int i = 0; i < length; i++) {
+        ds_sll_appendElement(linkedList, newInt(base + i));
+    }
+    return linkedList;
+}
+
+/* The expected element of a list of `length` values starting at `base`, or -1 for NULL */
+static int expectedValue(int index, int length, int base) {
+    return ((index >= 0) && (index < length)) ? base + index : -1;
+}
+
+static void checkResults(void** results, const int* indices, int count, int length, int base) {
+    for(int i = 0; i < count; i++) {
+        int expected = expectedValue(indices[i], length, base);
+        if(expected < 0) {
+            CHECK(results[i] == NULL);
+        } else {
+            CHECK(results[i] != NULL && *(int*)results[i] == expected);
+        }
+    }
+}
+
+static void testPlain(void) {
+    ds_sll_t* linkedList = newList(10, 100);
+    void* results[MAX_INDICES];
+
+    // unsorted, with duplicates, first and last
+    static const int unsorted[] = { 7, 2, 2, 9, 0, 7, 5 };
+    CHECK_EQ_INT(ds_sll_getElementsAtIndices(linkedList, unsorted, 7, results), DS_SLL_NO_ERROR);
+    checkResults(results, unsorted, 7, 10, 100);
+
+    // out of range on both sides, mixed with valid and duplicate indices
+    static const int outOfRange[] = { 3, 10, -1, 3, 42, 9, -7 };
+    CHECK_EQ_INT(ds_sll_getElementsAtIndices(linkedList, outOfRange, 7, results), DS_SLL_INDEX_OUT_OF_BOUNDS_ERROR);
+    checkResults(results, outOfRange, 7, 10, 100);
+
+    // only out of range indices
+    static const int allOutOfRange[] = { 11, -2, 10 };
+    CHECK_EQ_INT(ds_sll_getElementsAtIndices(linkedList, allOutOfRange, 3, results), DS_SLL_INDEX_OUT_OF_BOUNDS_ERROR);
+    checkResults(results, allOutOfRange, 3, 10, 100);
+
+    // no index at all
+    CHECK_EQ_INT(ds_sll_getElementsAtIndices(linkedList, NULL, 0, NULL), DS_SLL_NO_ERROR);
+
+    // an empty list has no valid index
+    ds_sll_t empty = { NULL, NULL };
+    static const int zero[] = { 0, 0 };
+    results[0] = results[1] = linkedList;
+    CHECK_EQ_INT(ds_sll_getElementsAtIndices(&empty, zero, 2, results), DS_SLL_INDEX_OUT_OF_BOUNDS_ERROR);
+    CHECK(results[0] == NULL && results[1] == NULL);
+
+    ds_sll_destroySinglyLinkedList(&linkedList);
+}
+
+static void testInterleaved(void) {
+    static const int lengths[] = { 10, 1, 0, 33 };
+    static const int indices[][8] = {
+        { 9, 9, 0, 4, 4, 1, 8, 3 },      // valid, unsorted, duplicates
+        { 0, 1, 0, -1, 0, 0, 2, 0 },     // a single node list
+        { 0, 0, 0, 0, 0, 0, 0, 0 },      // an empty list
+        { 32, 33, 5, 5, -3, 100, 0, 32 } // a longer list, out of range on both sides
+    };
+    static const int counts[] = { 8, 8, 8, 8 };
+    ds_sll_t* lists[4];
+    void* results[4][8];
+    ds_sll_batch_lookup_t batches[5];
+
+    for(int b = 0; b < 4; b++) {
+        lists[b] = newList(lengths[b], 1000 * b);
+        batches[b].linkedList = lists[b];
+        batches[b].indices = indices[b];
+        batches[b].count = counts[b];
+        batches[b].results = results[b];
+    }
+    // a batch without indices, on the same list as another batch
+    batches[4].linkedList = lists[0];
+    batches[4].indices = NULL;
+    batches[4].count = 0;
+    batches[4].results = NULL;
+
+    CHECK_EQ_INT(ds_sll_getElementsAtIndicesInterleaved(batches, 5), DS_SLL_INDEX_OUT_OF_BOUNDS_ERROR);
+    for(int b = 0; b < 4; b++) {
+        checkResults(results[b], indices[b], counts[b], lengths[b], 1000 * b);
+    }
+
+    // the same lists, all indices valid: no error
+    CHECK_EQ_INT(ds_sll_getElementsAtIndicesInterleaved(batches, 1), DS_SLL_NO_ERROR);
+    checkResults(results[0], indices[0], counts[0], lengths[0], 0);
+    CHECK_EQ_INT(ds_sll_getElementsAtIndicesInterleaved(batches, 0), DS_SLL_NO_ERROR);
+
+    // each batch agrees with the plain variant and with single lookups
+    for(int b = 0; b < 4; b++) {
+        void* plain[8];
+        ds_sll_getElementsAtIndices(lists[b], indices[b], counts[b], plain);
+        for(int i = 0; i < counts[b]; i++) {
+            CHECK(plain[i] == results[b][i]);
+            if((lengths[b] > 0) && (indices[b][i] >= 0) && (indices[b][i] < lengths[b])) {
+                CHECK(ds_sll_getElementAtIndex(lists[b], indices[b][i]) == results[b][i]);
+            }
+        }
+    }
+
+    for(int b = 0; b < 4; b++) {
+        ds_sll_destroySinglyLinkedList(&lists[b]);
+    }
+}
+
+
+int main(void) {
+    RUN_TEST(testPlain);
+    RUN_TEST(testInterleaved);
+    return TEST_EXIT_CODE();
+}
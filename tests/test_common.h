@@ -0,0 +1,41 @@
+#ifndef RM_DS_SLL_TEST_COMMON_H
+#define RM_DS_SLL_TEST_COMMON_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Minimal check macros shared by the tests: a failed check is reported and counted, and the test keeps going */
+static int test_failures = 0;
+
+#define CHECK(cond) do { \
+    if(!(cond)) { \
+        fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+        test_failures++; \
+    } \
+} while(0)
+
+#define CHECK_EQ_INT(actual, expected) do { \
+    long long check_actual_ = (long long)(actual), check_expected_ = (long long)(expected); \
+    if(check_actual_ != check_expected_) { \
+        fprintf(stderr, "%s:%d: check failed: %s == %s (%lld != %lld)\n", \
+                __FILE__, __LINE__, #actual, #expected, check_actual_, check_expected_); \
+        test_failures++; \
+    } \
+} while(0)
+
+#define RUN_TEST(test) do { \
+    int failures_before_ = test_failures; \
+    test(); \
+    printf("%s %s\n", test_failures == failures_before_ ? "PASS" : "FAIL", #test); \
+} while(0)
+
+#define TEST_EXIT_CODE() (test_failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE)
+
+/* Allocates an int element; the lists free their elements on delete */
+static inline int* newInt(int value) {
+    int* element = (int*)malloc(sizeof(int));
+    *element = value;
+    return element;
+}
+
+#endif //RM_DS_SLL_TEST_COMMON_H
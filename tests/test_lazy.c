@@ -0,0 +1,193 @@
+#include "SinglyLinkedListLazy.h"
+#include "test_common.h"
+
+/*
+ * Lazy deletion: deleted nodes become tombstones that indices and traversals skip, and compaction
+ * (automatic past the dead fraction, or on request) is deferred while a traversal is in progress.
+ */
+
+#define LENGTH 1000
+#define MIN_COMPACTION 64 /* DS_SLL_LAZY_MIN_COMPACTION */
+
+/* Number of nodes physically in the list, live or dead */
+static int countNodes(const ds_sll_lazy_t* lazyList) {
+    int count = 0;
+    for(ds_sll_node_t* node = lazyList->list.head; node != NULL; node = ds_sll_nextNode(node)) {
+        count++;
+    }
+    return count;
+}
+
+static ds_sll_lazy_t* newFilledList(double dead_fraction, int length) {
+    ds_sll_lazy_t* lazyList = ds_sll_newLazyList(dead_fraction);
+    for(int i = 0; i < length; i++) {
+        ds_sll_lazyAppendElement(lazyList, newInt(i));
+    }
+    return lazyList;
+}
+
+static ds_sll_lazy_t* traversed_list; /* the list the callbacks below work on */
+
+static ds_sll_func_return_t collectElement(void* element, ds_sll_node_t* node, int index, void* values) {
+    ((int*)values)[index] = *(int*)element;
+    return DS_SLL_CONTINUE_EXECUTION;
+}
+
+/* Deletes the odd elements, checking on the way that nothing is compacted under the traversal */
+static ds_sll_func_return_t deleteOdd(void* element, ds_sll_node_t* node, int index, void* seen) {
+    int value = *(int*)element;
+    CHECK_EQ_INT(value, *(int*)seen);
+    CHECK_EQ_INT(index, *(int*)seen);
+    (*(int*)seen)++;
+    if(value % 2 == 1) {
+        CHECK_EQ_INT(ds_sll_lazyDeleteNode(traversed_list, node), DS_SLL_NO_ERROR);
+        CHECK_EQ_INT(ds_sll_lazyCompact(traversed_list), 0);
+    }
+    if(value == LENGTH - 1) {
+        // past the dead fraction by now, but every tombstone is still linked in
+        CHECK_EQ_INT(traversed_list->dead_count, LENGTH / 2);
+        CHECK_EQ_INT(countNodes(traversed_list), LENGTH);
+    }
+    return DS_SLL_CONTINUE_EXECUTION;
+}
+
+static void testCompactionDeferredDuringTraversal(void) {
+    ds_sll_lazy_t* lazyList = newFilledList(0, LENGTH);
+    int seen = 0;
+    traversed_list = lazyList;
+
+    CHECK_EQ_INT(ds_sll_lazyExecuteFunctionOnElements(lazyList, deleteOdd, &seen), -1);
+    CHECK_EQ_INT(seen, LENGTH);
+    CHECK_EQ_INT(lazyList->traversals, 0);
+
+    // the compaction postponed by the traversal ran as soon as it completed
+    CHECK_EQ_INT(lazyList->dead_count, 0);
+    CHECK_EQ_INT(lazyList->live_count, LENGTH / 2);
+    CHECK_EQ_INT(countNodes(lazyList), LENGTH / 2);
+    CHECK_EQ_INT(*(int*)ds_sll_extractElementFromNode(lazyList->list.tail), LENGTH - 2);
+
+    int values[LENGTH / 2];
+    ds_sll_lazyExecuteFunctionOnElements(lazyList, collectElement, values);
+    int wrong = 0;
+    for(int i = 0; i < LENGTH / 2; i++) {
+        wrong += (values[i] != 2 * i);
+    }
+    CHECK_EQ_INT(wrong, 0);
+
+    // the tail is still right after compaction
+    ds_sll_lazyAppendElement(lazyList, newInt(-1));
+    CHECK_EQ_INT(*(int*)ds_sll_lazyGetElementAtIndex(lazyList, LENGTH / 2), -1);
+    ds_sll_destroyLazyList(&lazyList);
+    CHECK(lazyList == NULL);
+}
+
+
+/* Deletes itself and the next live node from inside a nested traversal */
+static ds_sll_func_return_t deleteFromNestedTraversal(void* element, ds_sll_node_t* node, int index, void* depth) {
+    if(*(int*)depth == 0 && index == 0) {
+        (*(int*)depth)++;
+        ds_sll_lazyExecuteFunctionOnElements(traversed_list, deleteFromNestedTraversal, depth);
+        (*(int*)depth)--;
+        CHECK_EQ_INT(ds_sll_lazyCompact(traversed_list), 0); // the outer traversal is still running
+        return DS_SLL_STOP_EXECUTION;
+    }
+    if(*(int*)depth == 1 && index < MIN_COMPACTION) {
+        ds_sll_lazyDeleteNode(traversed_list, node);
+    }
+    return DS_SLL_CONTINUE_EXECUTION;
+}
+
+static void testNestedTraversals(void) {
+    ds_sll_lazy_t* lazyList = newFilledList(0, 2 * MIN_COMPACTION);
+    int depth = 0;
+    traversed_list = lazyList;
+
+    ds_sll_lazyExecuteFunctionOnElements(lazyList, deleteFromNestedTraversal, &depth);
+    // the inner traversal completing does not compact under the outer one, the outer one completing does
+    CHECK_EQ_INT(lazyList->traversals, 0);
+    CHECK_EQ_INT(lazyList->dead_count, 0);
+    CHECK_EQ_INT(countNodes(lazyList), MIN_COMPACTION);
+    CHECK_EQ_INT(*(int*)ds_sll_lazyGetElementAtIndex(lazyList, 0), MIN_COMPACTION);
+    ds_sll_destroyLazyList(&lazyList);
+}
+
+
+static void testIndicesSkipTombstones(void) {
+    ds_sll_lazy_t* lazyList = newFilledList(1.0, 10); // manual compaction only
+
+    CHECK_EQ_INT(ds_sll_lazyDeleteNodeAtIndex(lazyList, 0), DS_SLL_NO_ERROR); // 1..9
+    CHECK_EQ_INT(ds_sll_lazyDeleteNodeAtIndex(lazyList, 3), DS_SLL_NO_ERROR); // 1 2 3 5 .. 9
+    CHECK_EQ_INT(ds_sll_lazyDeleteNodeAtIndex(lazyList, 7), DS_SLL_NO_ERROR); // 1 2 3 5 6 7 8
+    CHECK_EQ_INT(ds_sll_lazyDeleteNodeAtIndex(lazyList, 7), DS_SLL_INDEX_OUT_OF_BOUNDS_ERROR);
+    CHECK_EQ_INT(ds_sll_lazyCalculateLength(lazyList), 7);
+    CHECK_EQ_INT(lazyList->dead_count, 3);
+    CHECK(ds_sll_lazyGetElementAtIndex(lazyList, 7) == NULL);
+
+    int expected[] = { 1, 2, 3, 5, 6, 7, 8 };
+    for(int i = 0; i < 7; i++) {
+        CHECK_EQ_INT(*(int*)ds_sll_lazyGetElementAtIndex(lazyList, i), expected[i]);
+    }
+
+    // inserting next to a tombstone, at the front, and at the end (after the dead tail)
+    CHECK_EQ_INT(ds_sll_lazyInsertElementAtIndex(lazyList, newInt(4), 3), DS_SLL_NO_ERROR);
+    CHECK_EQ_INT(ds_sll_lazyInsertElementAtIndex(lazyList, newInt(0), 0), DS_SLL_NO_ERROR);
+    CHECK_EQ_INT(ds_sll_lazyInsertElementAtIndex(lazyList, newInt(9), 9), DS_SLL_NO_ERROR);
+    CHECK_EQ_INT(ds_sll_lazyInsertElementAtIndex(lazyList, NULL, 11), DS_SLL_INDEX_OUT_OF_BOUNDS_ERROR);
+    int values[10];
+    CHECK_EQ_INT(ds_sll_lazyCalculateLength(lazyList), 10);
+    ds_sll_lazyExecuteFunctionOnElements(lazyList, collectElement, values);
+    for(int i = 0; i < 10; i++) {
+        CHECK_EQ_INT(values[i], i);
+    }
+
+    // deleting a tombstone again is a no-op
+    ds_sll_node_t* dead = lazyList->list.head;
+    while(dead != NULL && !((ds_sll_lazy_node_t*)dead)->dead) {
+        dead = ds_sll_nextNode(dead);
+    }
+    CHECK(dead != NULL && *(int*)ds_sll_extractElementFromNode(dead) == 0); // the original 0, deleted first
+    CHECK_EQ_INT(ds_sll_lazyDeleteNode(lazyList, dead), DS_SLL_NO_ERROR);
+    CHECK_EQ_INT(lazyList->dead_count, 3);
+    CHECK_EQ_INT(ds_sll_lazyCalculateLength(lazyList), 10);
+
+    CHECK_EQ_INT(ds_sll_lazyCompact(lazyList), 3);
+    CHECK_EQ_INT(ds_sll_lazyCompact(lazyList), 0);
+    CHECK_EQ_INT(countNodes(lazyList), 10);
+    ds_sll_destroyLazyList(&lazyList);
+}
+
+
+static void testCompactionThresholds(void) {
+    // default fraction: nothing happens below the minimum number of dead nodes
+    ds_sll_lazy_t* lazyList = newFilledList(0, 100);
+    for(int i = 0; i < MIN_COMPACTION - 1; i++) {
+        ds_sll_lazyDeleteNodeAtIndex(lazyList, 0);
+    }
+    CHECK_EQ_INT(lazyList->dead_count, MIN_COMPACTION - 1);
+    CHECK_EQ_INT(countNodes(lazyList), 100);
+    ds_sll_lazyDeleteNodeAtIndex(lazyList, 0);
+    CHECK_EQ_INT(lazyList->dead_count, 0);
+    CHECK_EQ_INT(countNodes(lazyList), 100 - MIN_COMPACTION);
+    ds_sll_destroyLazyList(&lazyList);
+
+    // manual only: even a list that is all tombstones waits for ds_sll_lazyCompact
+    lazyList = newFilledList(1.0, 2 * MIN_COMPACTION);
+    for(int i = 0; i < 2 * MIN_COMPACTION; i++) {
+        ds_sll_lazyDeleteNodeAtIndex(lazyList, 0);
+    }
+    CHECK_EQ_INT(lazyList->dead_count, 2 * MIN_COMPACTION);
+    CHECK_EQ_INT(ds_sll_lazyCompact(lazyList), 2 * MIN_COMPACTION);
+    CHECK(lazyList->list.head == NULL && lazyList->list.tail == NULL);
+    ds_sll_lazyAppendElement(lazyList, newInt(5));
+    CHECK_EQ_INT(*(int*)ds_sll_lazyGetElementAtIndex(lazyList, 0), 5);
+    ds_sll_destroyLazyList(&lazyList);
+}
+
+
+int main(void) {
+    RUN_TEST(testCompactionDeferredDuringTraversal);
+    RUN_TEST(testNestedTraversals);
+    RUN_TEST(testIndicesSkipTombstones);
+    RUN_TEST(testCompactionThresholds);
+    return TEST_EXIT_CODE();
+}
@@ -0,0 +1,243 @@
+#include <pthread.h>
+#include <string.h>
+#include "SinglyLinkedListLocked.h"
+#include "test_common.h"
+
+/*
+ * Linearizability stress tests for the hand-over-hand locked list.
+ * Writers race on the same list; afterwards the contents and the length must match
+ * a sequential history in which every thread's operations keep their program order.
+ */
+
+#define WRITERS 4
+#define OPS_PER_WRITER 500
+#define PREFILL 64
+
+typedef struct writer_t {
+    pthread_t thread;
+    ds_sll_locked_t* list;
+    int id;
+    int errors;
+} writer_t;
+
+typedef struct snapshot_t {
+    int* values;
+    int count;
+    int capacity;
+} snapshot_t;
+
+static ds_sll_func_return_t collectElement(void* element, ds_sll_locked_node_t* node, int index, void* shared) {
+    snapshot_t* snapshot = (snapshot_t*)shared;
+    if(snapshot->count < snapshot->capacity) {
+        snapshot->values[snapshot->count] = *(int*)element;
+    }
+    snapshot->count++;
+    return DS_SLL_CONTINUE_EXECUTION;
+}
+
+static int compareInts(void* a, void* b) {
+    return (*(int*)a > *(int*)b) - (*(int*)a < *(int*)b);
+}
+
+static int equalInts(void* a, void* b) {
+    return *(int*)a == *(int*)b;
+}
+
+static void runWriters(writer_t* writers, ds_sll_locked_t* list, void* (*body)(void*)) {
+    for(int t = 0; t < WRITERS; t++) {
+        writers[t].list = list;
+        writers[t].id = t;
+        writers[t].errors = 0;
+        pthread_create(&writers[t].thread, NULL, body, &writers[t]);
+    }
+    for(int t = 0; t < WRITERS; t++) {
+        pthread_join(writers[t].thread, NULL);
+        CHECK_EQ_INT(writers[t].errors, 0);
+    }
+}
+
+static snapshot_t takeSnapshot(ds_sll_locked_t* list, int capacity) {
+    snapshot_t snapshot = { (int*)malloc(sizeof(int) * capacity), 0, capacity };
+    if(ds_sll_lockedCalculateLength(list) > 0) {
+        ds_sll_lockedExecuteFunctionOnElements(list, collectElement, &snapshot);
+    }
+    return snapshot;
+}
+
+
+/* Distinct regions: each writer inserts its own key range in sorted order, then deletes every odd key of it */
+static void* distinctRangeWriter(void* arg) {
+    writer_t* writer = (writer_t*)arg;
+    int base = writer->id * OPS_PER_WRITER;
+    for(int i = 0; i < OPS_PER_WRITER; i++) {
+        if(ds_sll_lockedInsertElementSorted(writer->list, newInt(base + i), compareInts) != DS_SLL_NO_ERROR) {
+            writer->errors++;
+        }
+    }
+    for(int i = 1; i < OPS_PER_WRITER; i += 2) {
+        int key = base + i;
+        if(ds_sll_lockedDeleteNodeContainingElement(writer->list, &key, equalInts) != DS_SLL_NO_ERROR) {
+            writer->errors++;
+        }
+    }
+    return NULL;
+}
+
+static void testDistinctRanges(void) {
+    ds_sll_locked_t* list = ds_sll_newLockedList();
+    writer_t writers[WRITERS];
+    runWriters(writers, list, distinctRangeWriter);
+
+    // sequential history: all keys inserted in sorted order, odd offsets removed
+    int expected_length = WRITERS * ((OPS_PER_WRITER + 1) / 2);
+    CHECK_EQ_INT(ds_sll_lockedCalculateLength(list), expected_length);
+    snapshot_t snapshot = takeSnapshot(list, expected_length);
+    CHECK_EQ_INT(snapshot.count, expected_length);
+    for(int i = 0; i < snapshot.count && i < expected_length; i++) {
+        int key = (i / ((OPS_PER_WRITER + 1) / 2)) * OPS_PER_WRITER + 2 * (i % ((OPS_PER_WRITER + 1) / 2));
+        CHECK_EQ_INT(snapshot.values[i], key);
+    }
+    free(snapshot.values);
+    ds_sll_destroyLockedList(&list);
+}
+
+
+/* Overlapping regions: every writer inserts its keys interleaved with everyone else's, then deletes half of them */
+static void* interleavedWriter(void* arg) {
+    writer_t* writer = (writer_t*)arg;
+    for(int i = 0; i < OPS_PER_WRITER; i++) {
+        if(ds_sll_lockedInsertElementSorted(writer->list, newInt(i * WRITERS + writer->id), compareInts) != DS_SLL_NO_ERROR) {
+            writer->errors++;
+        }
+    }
+    for(int i = 0; i < OPS_PER_WRITER; i += 2) {
+        int key = i * WRITERS + writer->id;
+        if(ds_sll_lockedDeleteNodeContainingElement(writer->list, &key, equalInts) != DS_SLL_NO_ERROR) {
+            writer->errors++;
+        }
+    }
+    return NULL;
+}
+
+static void testInterleavedKeys(void) {
+    ds_sll_locked_t* list = ds_sll_newLockedList();
+    writer_t writers[WRITERS];
+    runWriters(writers, list, interleavedWriter);
+
+    int expected_length = WRITERS * (OPS_PER_WRITER / 2);
+    CHECK_EQ_INT(ds_sll_lockedCalculateLength(list), expected_length);
+    snapshot_t snapshot = takeSnapshot(list, expected_length);
+    CHECK_EQ_INT(snapshot.count, expected_length);
+    int expected_index = 0;
+    for(int i = 1; i < OPS_PER_WRITER; i += 2) {
+        for(int t = 0; t < WRITERS && expected_index < snapshot.count; t++, expected_index++) {
+            CHECK_EQ_INT(snapshot.values[expected_index], i * WRITERS + t);
+        }
+    }
+    free(snapshot.values);
+    ds_sll_destroyLockedList(&list);
+}
+
+
+/* Same index: all writers push to index 0. Each writer's keys must come out newest first */
+static void* headWriter(void* arg) {
+    writer_t* writer = (writer_t*)arg;
+    for(int i = 0; i < OPS_PER_WRITER; i++) {
+        if(ds_sll_lockedInsertElementAtIndex(writer->list, newInt(writer->id * OPS_PER_WRITER + i), 0) != DS_SLL_NO_ERROR) {
+            writer->errors++;
+        }
+    }
+    return NULL;
+}
+
+static void testSameIndexInserts(void) {
+    ds_sll_locked_t* list = ds_sll_newLockedList();
+    writer_t writers[WRITERS];
+    runWriters(writers, list, headWriter);
+
+    int expected_length = WRITERS * OPS_PER_WRITER;
+    CHECK_EQ_INT(ds_sll_lockedCalculateLength(list), expected_length);
+    snapshot_t snapshot = takeSnapshot(list, expected_length);
+    CHECK_EQ_INT(snapshot.count, expected_length);
+
+    int next_expected[WRITERS];
+    for(int t = 0; t < WRITERS; t++) {
+        next_expected[t] = OPS_PER_WRITER - 1;
+    }
+    for(int i = 0; i < snapshot.count && i < expected_length; i++) {
+        int writer = snapshot.values[i] / OPS_PER_WRITER;
+        int sequence = snapshot.values[i] % OPS_PER_WRITER;
+        CHECK(writer >= 0 && writer < WRITERS);
+        if(writer >= 0 && writer < WRITERS) {
+            CHECK_EQ_INT(sequence, next_expected[writer]);
+            next_expected[writer] = sequence - 1;
+        }
+    }
+    for(int t = 0; t < WRITERS; t++) {
+        CHECK_EQ_INT(next_expected[t], -1);
+    }
+    free(snapshot.values);
+    ds_sll_destroyLockedList(&list);
+}
+
+
+/*
+ * Mixed inserts and deletes at random, overlapping indices. Every writer deletes at most as many nodes
+ * as it inserted, so the list never drops below PREFILL nodes and every index in [0, PREFILL) is valid
+ */
+static void* mixedWriter(void* arg) {
+    writer_t* writer = (writer_t*)arg;
+    unsigned int seed = (unsigned int)writer->id * 2654435761u + 1u;
+    for(int i = 0; i < OPS_PER_WRITER; i++) {
+        seed = seed * 1103515245u + 12345u;
+        int index = (int)((seed >> 16) % (PREFILL + 1));
+        if(ds_sll_lockedInsertElementAtIndex(writer->list, newInt(PREFILL + writer->id * OPS_PER_WRITER + i), index) != DS_SLL_NO_ERROR) {
+            writer->errors++;
+        }
+        seed = seed * 1103515245u + 12345u;
+        index = (int)((seed >> 16) % PREFILL);
+        if(ds_sll_lockedDeleteNodeAtIndex(writer->list, index) != DS_SLL_NO_ERROR) {
+            writer->errors++;
+        }
+    }
+    return NULL;
+}
+
+static void testMixedIndices(void) {
+    ds_sll_locked_t* list = ds_sll_newLockedList();
+    for(int i = 0; i < PREFILL; i++) {
+        ds_sll_lockedInsertElementAtIndex(list, newInt(i), i);
+    }
+    writer_t writers[WRITERS];
+    runWriters(writers, list, mixedWriter);
+
+    // every operation succeeded, so the sequential history has exactly as many deletes as inserts
+    CHECK_EQ_INT(ds_sll_lockedCalculateLength(list), PREFILL);
+    int total_keys = PREFILL + WRITERS * OPS_PER_WRITER;
+    snapshot_t snapshot = takeSnapshot(list, PREFILL);
+    CHECK_EQ_INT(snapshot.count, PREFILL);
+    char* seen = (char*)calloc((size_t)total_keys, 1);
+    for(int i = 0; i < snapshot.count && i < PREFILL; i++) {
+        int key = snapshot.values[i];
+        CHECK(key >= 0 && key < total_keys);
+        if(key >= 0 && key < total_keys) {
+            CHECK(!seen[key]);
+            seen[key] = 1;
+        }
+    }
+    free(seen);
+    free(snapshot.values);
+
+    CHECK_EQ_INT(ds_sll_lockedDeleteNodeAtIndex(list, PREFILL), DS_SLL_INDEX_OUT_OF_BOUNDS_ERROR);
+    CHECK_EQ_INT(ds_sll_lockedInsertElementAtIndex(list, NULL, PREFILL + 1), DS_SLL_INDEX_OUT_OF_BOUNDS_ERROR);
+    ds_sll_destroyLockedList(&list);
+}
+
+
+int main(void) {
+    RUN_TEST(testDistinctRanges);
+    RUN_TEST(testInterleavedKeys);
+    RUN_TEST(testSameIndexInserts);
+    RUN_TEST(testMixedIndices);
+    return TEST_EXIT_CODE();
+}
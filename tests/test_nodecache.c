@@ -0,0 +1,193 @@
+#include <pthread.h>
+#include "SinglyLinkedListNodeCache.h"
+#include "test_common.h"
+
+/*
+ * Thread local node caches: magazines spill to and refill from the depot, the depot is bounded,
+ * and a thread's magazines (and counters) are handed back when it exits.
+ * Magazines of 4 nodes keep the counts below easy to follow.
+ */
+
+#define MAGAZINE 4
+#define STRESS_THREADS 4
+#define STRESS_ROUNDS 200
+#define STRESS_BATCH 37
+
+static void createNodes(ds_sll_node_cache_t* cache, ds_sll_node_t** nodes, int count) {
+    for(int i = 0; i < count; i++) {
+        nodes[i] = ds_sll_nodeCacheCreateNode(cache, NULL);
+        CHECK(nodes[i] != NULL);
+    }
+}
+
+static void deleteNodes(ds_sll_node_cache_t* cache, ds_sll_node_t** nodes, int count) {
+    for(int i = 0; i < count; i++) {
+        ds_sll_nodeCacheDeleteNode(cache, &nodes[i]);
+        CHECK(nodes[i] == NULL);
+    }
+}
+
+
+static void testSpillAndRefill(void) {
+    ds_sll_node_cache_t* cache = ds_sll_newNodeCache(MAGAZINE, 2);
+    ds_sll_node_t* nodes[3 * MAGAZINE];
+    ds_sll_node_cache_stats_t stats;
+
+    // nothing cached yet: every node comes from malloc
+    createNodes(cache, nodes, 3 * MAGAZINE);
+    // two magazines fill up in the thread, the third delete of a magazine's worth spills one to the depot
+    deleteNodes(cache, nodes, 3 * MAGAZINE);
+    ds_sll_nodeCacheStats(cache, &stats);
+    CHECK_EQ_INT(stats.allocations, 3 * MAGAZINE);
+    CHECK_EQ_INT(stats.hits, 0);
+    CHECK_EQ_INT(stats.frees, 3 * MAGAZINE);
+    CHECK_EQ_INT(stats.cached_frees, 3 * MAGAZINE);
+    CHECK_EQ_INT(stats.depot_puts, 1);
+    CHECK_EQ_INT(stats.depot_full, 1);
+
+    // the two thread magazines are used up first, then the full magazine is taken back from the depot
+    createNodes(cache, nodes, 3 * MAGAZINE);
+    ds_sll_nodeCacheStats(cache, &stats);
+    CHECK_EQ_INT(stats.hits, 3 * MAGAZINE);
+    CHECK_EQ_INT(stats.depot_gets, 1);
+    CHECK_EQ_INT(stats.depot_full, 0);
+    CHECK(stats.hit_rate == 0.5);
+
+    deleteNodes(cache, nodes, 3 * MAGAZINE);
+    ds_sll_nodeCacheReleaseThread(cache);
+    ds_sll_destroyNodeCache(&cache);
+    CHECK(cache == NULL);
+}
+
+
+static void testDepotIsBounded(void) {
+    enum { DEPOT = 2, COUNT = 2 * MAGAZINE + DEPOT * MAGAZINE + MAGAZINE };
+    ds_sll_node_cache_t* cache = ds_sll_newNodeCache(MAGAZINE, DEPOT);
+    ds_sll_node_t* nodes[COUNT];
+    ds_sll_node_cache_stats_t stats;
+
+    createNodes(cache, nodes, COUNT);
+    deleteNodes(cache, nodes, COUNT);
+    // both thread magazines and the depot are full: the last magazine's worth of nodes is freed
+    ds_sll_nodeCacheStats(cache, &stats);
+    CHECK_EQ_INT(stats.frees, COUNT);
+    CHECK_EQ_INT(stats.cached_frees, COUNT - MAGAZINE);
+    CHECK_EQ_INT(stats.depot_puts, DEPOT);
+    CHECK_EQ_INT(stats.depot_full, DEPOT);
+
+    ds_sll_nodeCacheReleaseThread(cache);
+    ds_sll_destroyNodeCache(&cache);
+}
+
+
+typedef struct handoff_t {
+    ds_sll_node_cache_t* cache;
+    ds_sll_node_t** nodes;
+    int count;
+} handoff_t;
+
+static void* deleteAndExit(void* arg) {
+    handoff_t* handoff = (handoff_t*)arg;
+    deleteNodes(handoff->cache, handoff->nodes, handoff->count);
+    return NULL; // the thread cache is released by the thread exit
+}
+
+static void* createAndExit(void* arg) {
+    handoff_t* handoff = (handoff_t*)arg;
+    createNodes(handoff->cache, handoff->nodes, handoff->count);
+    return NULL;
+}
+
+static void testReleaseOnThreadExit(void) {
+    enum { COUNT = 4 * MAGAZINE };
+    ds_sll_node_cache_t* cache = ds_sll_newNodeCache(MAGAZINE, 4);
+    ds_sll_node_t* nodes[COUNT];
+    ds_sll_node_cache_stats_t stats;
+    handoff_t handoff = { cache, nodes, COUNT };
+    pthread_t thread;
+
+    createNodes(cache, nodes, COUNT);
+
+    // another thread deletes the nodes: two magazines spill while it runs, two more are handed over when it exits
+    pthread_create(&thread, NULL, deleteAndExit, &handoff);
+    pthread_join(thread, NULL);
+    ds_sll_nodeCacheStats(cache, &stats);
+    CHECK_EQ_INT(stats.depot_full, 4);
+    CHECK_EQ_INT(stats.depot_puts, 2);
+    CHECK_EQ_INT(stats.frees, COUNT); // the counters of the exited thread are kept
+    CHECK_EQ_INT(stats.cached_frees, COUNT);
+
+    // a third thread gets all of them back from the depot, without a single malloc
+    pthread_create(&thread, NULL, createAndExit, &handoff);
+    pthread_join(thread, NULL);
+    ds_sll_nodeCacheStats(cache, &stats);
+    CHECK_EQ_INT(stats.allocations, 2 * COUNT);
+    CHECK_EQ_INT(stats.hits, COUNT);
+    CHECK_EQ_INT(stats.depot_gets, 4);
+    CHECK_EQ_INT(stats.depot_full, 0);
+
+    deleteNodes(cache, nodes, COUNT);
+    ds_sll_nodeCacheReleaseThread(cache);
+    ds_sll_nodeCacheStats(cache, &stats);
+    CHECK_EQ_INT(stats.frees, 2 * COUNT);
+    ds_sll_destroyNodeCache(&cache);
+}
+
+
+/* Every thread creates a batch and deletes the batch of its neighbour */
+typedef struct stress_t {
+    pthread_t thread;
+    ds_sll_node_cache_t* cache;
+    ds_sll_node_t* batch[STRESS_BATCH];
+    pthread_barrier_t* barrier;
+    int id;
+    struct stress_t* all;
+} stress_t;
+
+static void* stressWorker(void* arg) {
+    stress_t* worker = (stress_t*)arg;
+    for(int round = 0; round < STRESS_ROUNDS; round++) {
+        createNodes(worker->cache, worker->batch, STRESS_BATCH);
+        pthread_barrier_wait(worker->barrier);
+        deleteNodes(worker->cache, worker->all[(worker->id + 1) % STRESS_THREADS].batch, STRESS_BATCH);
+        pthread_barrier_wait(worker->barrier);
+    }
+    return NULL;
+}
+
+static void testCrossThreadStress(void) {
+    static stress_t workers[STRESS_THREADS];
+    ds_sll_node_cache_t* cache = ds_sll_newNodeCache(MAGAZINE, 3);
+    pthread_barrier_t barrier;
+    ds_sll_node_cache_stats_t stats;
+
+    pthread_barrier_init(&barrier, NULL, STRESS_THREADS);
+    for(int t = 0; t < STRESS_THREADS; t++) {
+        workers[t].cache = cache;
+        workers[t].barrier = &barrier;
+        workers[t].id = t;
+        workers[t].all = workers;
+        pthread_create(&workers[t].thread, NULL, stressWorker, &workers[t]);
+    }
+    for(int t = 0; t < STRESS_THREADS; t++) {
+        pthread_join(workers[t].thread, NULL);
+    }
+    pthread_barrier_destroy(&barrier);
+
+    ds_sll_nodeCacheStats(cache, &stats);
+    CHECK_EQ_INT(stats.allocations, STRESS_THREADS * STRESS_ROUNDS * STRESS_BATCH);
+    CHECK_EQ_INT(stats.frees, stats.allocations);
+    CHECK(stats.hits > 0);
+    CHECK(stats.depot_gets > 0 && stats.depot_puts > 0);
+    CHECK(stats.depot_full <= 3);
+    ds_sll_destroyNodeCache(&cache);
+}
+
+
+int main(void) {
+    RUN_TEST(testSpillAndRefill);
+    RUN_TEST(testDepotIsBounded);
+    RUN_TEST(testReleaseOnThreadExit);
+    RUN_TEST(testCrossThreadStress);
+    return TEST_EXIT_CODE();
+}
@@ -0,0 +1,152 @@
+#include "SinglyLinkedList.h"
+#include "test_common.h"
+
+/*
+ * Constant time operations on node handles: inserting, unlinking and deleting after a node, popping the head,
+ * splicing and concatenating, at the head, in the middle and at the tail. The tail must follow every change.
+ */
+
+#define MAX_VALUES 32
+
+/* Checks the elements of a list in order, and that head, tail and the final NULL agree */
+static void checkValues(const ds_sll_t* linkedList, const int* expected, int count) {
+    int found = 0;
+    ds_sll_node_t* last = NULL;
+    for(ds_sll_node_t* node = linkedList->head; node != NULL && found < MAX_VALUES; node = node->next) {
+        if(found < count) {
+            CHECK_EQ_INT(*(int*)node->element, expected[found]);
+        }
+        found++;
+        last = node;
+    }
+    CHECK_EQ_INT(found, count);
+    CHECK(linkedList->tail == last);
+}
+
+static void freeList(ds_sll_t* linkedList) {
+    ds_sll_node_t* node;
+    while((node = ds_sll_popHeadNode(linkedList)) != NULL) {
+        ds_sll_deleteNode(&node);
+    }
+}
+
+static void testInsertAfter(void) {
+    ds_sll_t list = { NULL, NULL };
+
+    // head insert into an empty list sets the tail too
+    CHECK_EQ_INT(ds_sll_insertElementAfter(&list, NULL, newInt(2)), DS_SLL_NO_ERROR);
+    checkValues(&list, (int[]){ 2 }, 1);
+
+    // head insert keeps the tail
+    ds_sll_insertNodeAfter(&list, NULL, ds_sll_createNode(newInt(0)));
+    checkValues(&list, (int[]){ 0, 2 }, 2);
+
+    // insert after the tail moves the tail
+    CHECK_EQ_INT(ds_sll_insertElementAfter(&list, list.tail, newInt(3)), DS_SLL_NO_ERROR);
+    checkValues(&list, (int[]){ 0, 2, 3 }, 3);
+
+    // insert in the middle keeps the tail
+    ds_sll_insertNodeAfter(&list, list.head, ds_sll_createNode(newInt(1)));
+    checkValues(&list, (int[]){ 0, 1, 2, 3 }, 4);
+
+    freeList(&list);
+}
+
+static void testUnlinkAndDeleteAfter(void) {
+    ds_sll_t list = { NULL, NULL };
+    for(int i = 0; i < 4; i++) {
+        ds_sll_appendElement(&list, newInt(i));
+    }
+
+    // unlinking the tail moves the tail back to prev
+    ds_sll_node_t* prev = list.head->next->next;
+    ds_sll_node_t* unlinked = ds_sll_unlinkNodeAfter(&list, prev);
+    CHECK(unlinked != NULL && *(int*)unlinked->element == 3 && unlinked->next == NULL);
+    CHECK(list.tail == prev);
+    checkValues(&list, (int[]){ 0, 1, 2 }, 3);
+    ds_sll_deleteNode(&unlinked);
+
+    // nothing after the tail
+    CHECK(ds_sll_unlinkNodeAfter(&list, list.tail) == NULL);
+    CHECK_EQ_INT(ds_sll_deleteNodeAfter(&list, list.tail), DS_SLL_INDEX_OUT_OF_BOUNDS_ERROR);
+
+    // deleting the tail through deleteNodeAfter moves the tail too
+    prev = list.head->next;
+    CHECK_EQ_INT(ds_sll_deleteNodeAfter(&list, prev), DS_SLL_NO_ERROR);
+    CHECK(list.tail == prev);
+    checkValues(&list, (int[]){ 0, 1 }, 2);
+    CHECK_EQ_INT(ds_sll_deleteNodeAfter(&list, list.head), DS_SLL_NO_ERROR);
+    checkValues(&list, (int[]){ 0 }, 1);
+
+    // deleting the only node empties the list
+    CHECK_EQ_INT(ds_sll_deleteNodeAfter(&list, NULL), DS_SLL_NO_ERROR);
+    checkValues(&list, NULL, 0);
+    CHECK(list.head == NULL && list.tail == NULL);
+    CHECK_EQ_INT(ds_sll_deleteNodeAfter(&list, NULL), DS_SLL_INDEX_OUT_OF_BOUNDS_ERROR);
+}
+
+static void testPopHead(void) {
+    ds_sll_t list = { NULL, NULL };
+    for(int i = 0; i < 3; i++) {
+        ds_sll_appendElement(&list, newInt(i));
+    }
+
+    for(int i = 0; i < 3; i++) {
+        ds_sll_node_t* node = ds_sll_popHeadNode(&list);
+        CHECK(node != NULL && *(int*)node->element == i && node->next == NULL);
+        ds_sll_deleteNode(&node);
+    }
+    CHECK(list.head == NULL && list.tail == NULL);
+    CHECK(ds_sll_popHeadNode(&list) == NULL);
+}
+
+static void testSpliceAndConcatenate(void) {
+    ds_sll_t list = { NULL, NULL };
+    ds_sll_t source = { NULL, NULL };
+    ds_sll_t empty = { NULL, NULL };
+
+    // empty into empty, then a list into an empty one takes its head and tail
+    ds_sll_concatenate(&list, &empty);
+    CHECK(list.head == NULL && list.tail == NULL);
+    ds_sll_appendElement(&source, newInt(2));
+    ds_sll_appendElement(&source, newInt(3));
+    ds_sll_concatenate(&list, &source);
+    checkValues(&list, (int[]){ 2, 3 }, 2);
+    checkValues(&source, NULL, 0);
+
+    // an empty list changes nothing
+    ds_sll_concatenate(&list, &empty);
+    ds_sll_spliceAfter(&list, list.head, &empty);
+    checkValues(&list, (int[]){ 2, 3 }, 2);
+
+    // splice at the front keeps the tail
+    ds_sll_appendElement(&source, newInt(0));
+    ds_sll_appendElement(&source, newInt(1));
+    ds_sll_spliceAfter(&list, NULL, &source);
+    checkValues(&list, (int[]){ 0, 1, 2, 3 }, 4);
+    CHECK(source.head == NULL && source.tail == NULL);
+
+    // splice in the middle keeps the tail, splice after the tail moves it
+    ds_sll_appendElement(&source, newInt(10));
+    ds_sll_spliceAfter(&list, list.head, &source);
+    checkValues(&list, (int[]){ 0, 10, 1, 2, 3 }, 5);
+    ds_sll_appendElement(&source, newInt(4));
+    ds_sll_appendElement(&source, newInt(5));
+    ds_sll_spliceAfter(&list, list.tail, &source);
+    checkValues(&list, (int[]){ 0, 10, 1, 2, 3, 4, 5 }, 7);
+
+    // appending after the new tail still works
+    ds_sll_appendElement(&list, newInt(6));
+    checkValues(&list, (int[]){ 0, 10, 1, 2, 3, 4, 5, 6 }, 8);
+
+    freeList(&list);
+}
+
+
+int main(void) {
+    RUN_TEST(testInsertAfter);
+    RUN_TEST(testUnlinkAndDeleteAfter);
+    RUN_TEST(testPopHead);
+    RUN_TEST(testSpliceAndConcatenate);
+    return TEST_EXIT_CODE();
+}
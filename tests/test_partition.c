@@ -0,0 +1,231 @@
+#include "SinglyLinkedListPartition.h"
+#include "test_common.h"
+
+/*
+ * k-way partitioning: every node ends up in exactly one segment, in order, whatever the length hint,
+ * and re-concatenating the segments gives back the original list.
+ */
+
+#define MAX_K 8
+#define MAX_VALUES 64
+
+typedef struct segments_t {
+    ds_sll_t lists[MAX_K];
+    ds_sll_t* pointers[MAX_K];
+} segments_t;
+
+static void initSegments(segments_t* segments) {
+    for(int i = 0; i < MAX_K; i++) {
+        segments->lists[i].head = NULL;
+        segments->lists[i].tail = NULL;
+        segments->pointers[i] = &segments->lists[i];
+    }
+}
+
+static void fillList(ds_sll_t* linkedList, int first, int length) {
+    for(int i = 0; i < length; i++) {
+        ds_sll_appendElement(linkedList, newInt(first + i));
+    }
+}
+
+/* Copies the elements of a list into `values`, checking that head, tail and the final NULL agree */
+static int listValues(const ds_sll_t* linkedList, int* values) {
+    int count = 0;
+    ds_sll_node_t* last = NULL;
+    for(ds_sll_node_t* node = linkedList->head; node != NULL && count < MAX_VALUES; node = node->next) {
+        values[count++] = *(int*)node->element;
+        last = node;
+    }
+    CHECK(linkedList->tail == last);
+    return count;
+}
+
+static void checkValues(const ds_sll_t* linkedList, const int* expected, int count) {
+    int values[MAX_VALUES];
+    CHECK_EQ_INT(listValues(linkedList, values), count);
+    for(int i = 0; i < count; i++) {
+        CHECK_EQ_INT(values[i], expected[i]);
+    }
+}
+
+static void checkRange(const ds_sll_t* linkedList, int first, int count) {
+    int expected[MAX_VALUES];
+    for(int i = 0; i < count; i++) {
+        expected[i] = first + i;
+    }
+    checkValues(linkedList, expected, count);
+}
+
+static void freeList(ds_sll_t* linkedList) {
+    ds_sll_node_t* node = linkedList->head;
+    while(node != NULL) {
+        ds_sll_node_t* next = node->next;
+        ds_sll_deleteNode(&node);
+        node = next;
+    }
+    linkedList->head = NULL;
+    linkedList->tail = NULL;
+}
+
+
+static void testSegmentSizes(void) {
+    // {length, k, hint}: exact, counted, fewer nodes than segments, hint too small, hint too large
+    static const int cases[][3] = { { 10, 4, 10 }, { 10, 4, -1 }, { 3, 5, -1 }, { 3, 5, 3 }, { 10, 4, 2 }, { 10, 4, 100 }, { 0, 3, -1 }, { 7, 1, -1 } };
+    static const int expected_sizes[][MAX_K] = {
+        { 3, 3, 2, 2 }, { 3, 3, 2, 2 }, { 1, 1, 1, 0, 0 }, { 1, 1, 1, 0, 0 },
+        { 1, 1, 0, 8 }, { 10, 0, 0, 0 }, { 0, 0, 0 }, { 7 }
+    };
+
+    for(size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        int length = cases[c][0], k = cases[c][1], hint = cases[c][2];
+        ds_sll_t linkedList = { NULL, NULL };
+        segments_t segments;
+        initSegments(&segments);
+        fillList(&linkedList, 0, length);
+
+        CHECK_EQ_INT(ds_sll_partitionIntoSegments(&linkedList, segments.pointers, k, hint), DS_SLL_NO_ERROR);
+        CHECK(linkedList.head == NULL && linkedList.tail == NULL);
+
+        int next = 0;
+        for(int i = 0; i < k; i++) {
+            int values[MAX_VALUES];
+            int size = listValues(&segments.lists[i], values);
+            CHECK_EQ_INT(size, expected_sizes[c][i]);
+            checkRange(&segments.lists[i], next, size);
+            next += size;
+        }
+        CHECK_EQ_INT(next, length);
+
+        ds_sll_concatenateSegments(&linkedList, segments.pointers, k);
+        checkRange(&linkedList, 0, length);
+        for(int i = 0; i < k; i++) {
+            CHECK(segments.lists[i].head == NULL && segments.lists[i].tail == NULL);
+        }
+        freeList(&linkedList);
+    }
+}
+
+
+static void testSegmentsKeepTheirNodes(void) {
+    // segments that already hold nodes get the new ones appended
+    ds_sll_t linkedList = { NULL, NULL };
+    segments_t segments;
+    initSegments(&segments);
+    fillList(&segments.lists[0], 100, 2);
+    fillList(&linkedList, 0, 4);
+
+    ds_sll_partitionIntoSegments(&linkedList, segments.pointers, 2, 4);
+    int expected[] = { 100, 101, 0, 1 };
+    checkValues(&segments.lists[0], expected, 4);
+    checkRange(&segments.lists[1], 2, 2);
+
+    // concatenating into a non-empty list, with empty segments in between
+    fillList(&linkedList, 50, 1);
+    segments.pointers[1] = &segments.lists[2]; // empty
+    segments.pointers[2] = &segments.lists[1];
+    ds_sll_concatenateSegments(&linkedList, segments.pointers, 3);
+    int concatenated[] = { 50, 100, 101, 0, 1, 2, 3 };
+    checkValues(&linkedList, concatenated, 7);
+
+    // appending after the concatenation uses the right tail
+    ds_sll_appendElement(&linkedList, newInt(4));
+    CHECK_EQ_INT(*(int*)linkedList.tail->element, 4);
+    freeList(&linkedList);
+}
+
+
+/*
+ * Re-concatenation is O(k): it only links tails to heads. The inside of the second segment is a cycle that
+ * never reaches its tail, so an implementation walking the segments would never return (ctest times out)
+ */
+static void testConcatenationOnlyTouchesEnds(void) {
+    ds_sll_t linkedList = { NULL, NULL };
+    segments_t segments;
+    ds_sll_node_t *head, *tail;
+    initSegments(&segments);
+    fillList(&segments.lists[0], 0, 1);
+    fillList(&segments.lists[1], 1, 2);
+    head = segments.lists[1].head;
+    tail = segments.lists[1].tail;
+    head->next = head;
+
+    ds_sll_concatenateSegments(&linkedList, segments.pointers, 2);
+    CHECK(linkedList.head != NULL && linkedList.head->next == head);
+    CHECK(linkedList.tail == tail);
+    CHECK(tail->next == NULL);
+
+    head->next = tail;
+    checkRange(&linkedList, 0, 3);
+    freeList(&linkedList);
+}
+
+
+static int selectModulo(void* element, void* k) {
+    int value = *(int*)element;
+    return (value == 7) ? *(int*)k + 2 : value % *(int*)k;
+}
+
+static void testSelector(void) {
+    ds_sll_t linkedList = { NULL, NULL };
+    segments_t segments;
+    int k = 3;
+    initSegments(&segments);
+    fillList(&linkedList, 0, 10);
+
+    // the selector sends 7 out of bounds: 0..6 are distributed, 7..9 stay in the list
+    CHECK_EQ_INT(ds_sll_partitionBySelector(&linkedList, segments.pointers, k, selectModulo, &k), DS_SLL_INDEX_OUT_OF_BOUNDS_ERROR);
+    checkRange(&linkedList, 7, 3);
+    int first[] = { 0, 3, 6 }, second[] = { 1, 4 }, third[] = { 2, 5 };
+    checkValues(&segments.lists[0], first, 3);
+    checkValues(&segments.lists[1], second, 2);
+    checkValues(&segments.lists[2], third, 2);
+
+    ds_sll_concatenateSegments(&linkedList, segments.pointers, k);
+    int all[] = { 7, 8, 9, 0, 3, 6, 1, 4, 2, 5 };
+    checkValues(&linkedList, all, 10);
+    freeList(&linkedList);
+}
+
+
+static size_t hashModulo(void* element) {
+    return (size_t)(*(int*)element % 5);
+}
+
+static void testHash(void) {
+    ds_sll_t linkedList = { NULL, NULL };
+    segments_t segments;
+    initSegments(&segments);
+    for(int i = 0; i < 20; i++) {
+        ds_sll_appendElement(&linkedList, newInt(i % 10)); // every value twice
+    }
+
+    CHECK_EQ_INT(ds_sll_partitionByHash(&linkedList, segments.pointers, 3, hashModulo), DS_SLL_NO_ERROR);
+    CHECK(linkedList.head == NULL && linkedList.tail == NULL);
+    int total = 0;
+    for(int i = 0; i < 3; i++) {
+        int values[MAX_VALUES];
+        int size = listValues(&segments.lists[i], values);
+        for(int v = 0; v < size; v++) {
+            CHECK_EQ_INT((values[v] % 5) % 3, i);
+        }
+        // relative order is kept: the first pass over 0..9 comes before the second one
+        for(int v = 1; v < size / 2; v++) {
+            CHECK(values[v - 1] < values[v]);
+        }
+        total += size;
+    }
+    CHECK_EQ_INT(total, 20);
+
+    ds_sll_concatenateSegments(&linkedList, segments.pointers, 3);
+    freeList(&linkedList);
+}
+
+
+int main(void) {
+    RUN_TEST(testSegmentSizes);
+    RUN_TEST(testSegmentsKeepTheirNodes);
+    RUN_TEST(testConcatenationOnlyTouchesEnds);
+    RUN_TEST(testSelector);
+    RUN_TEST(testHash);
+    return TEST_EXIT_CODE();
+}
@@ -0,0 +1,88 @@
+#include "SinglyLinkedListPersistent.h"
+#include "test_common.h"
+
+/*
+ * Persistent lists: versions that share a tail count their references on the shared nodes,
+ * and releasing one version (in any order) leaves every other version intact.
+ */
+
+static int refcount(const ds_sll_node_t* node) {
+    return ((const ds_sll_persistent_node_t*)node)->refcount;
+}
+
+/* Checks the length and the elements of a version, from the head */
+static void checkVersion(const ds_sll_persistent_t* version, const int* expected, int count) {
+    CHECK_EQ_INT(version->length, count);
+    for(int i = 0; i < count; i++) {
+        int* element = (int*)ds_sll_persistentGetElementAtIndex(version, i);
+        CHECK(element != NULL && *element == expected[i]);
+    }
+    CHECK(ds_sll_persistentGetElementAtIndex(version, count) == NULL);
+}
+
+static void testSharedTailRefcounts(void) {
+    ds_sll_persistent_t* empty = ds_sll_newPersistentList();
+    ds_sll_persistent_t* base = ds_sll_persistentPrependElement(empty, newInt(1));
+    ds_sll_persistent_t* left = ds_sll_persistentPrependElement(base, newInt(2));
+    int value = 3;
+    ds_sll_persistent_t* right = ds_sll_persistentPrependElementCopy(base, &value, sizeof(value));
+
+    // the shared node is referenced by base and by the heads of both branches
+    ds_sll_node_t* shared = base->head;
+    CHECK(left->head->next == shared && right->head->next == shared);
+    CHECK_EQ_INT(refcount(shared), 3);
+    CHECK_EQ_INT(refcount(left->head), 1);
+    checkVersion(left, (int[]){ 2, 1 }, 2);
+    checkVersion(right, (int[]){ 3, 1 }, 2);
+
+    // snapshots and pops reference the same nodes instead of copying them
+    ds_sll_persistent_t* snapshot = ds_sll_persistentSnapshot(left);
+    ds_sll_persistent_t* popped = ds_sll_persistentPopHead(right);
+    CHECK(snapshot->head == left->head && popped->head == shared);
+    CHECK_EQ_INT(refcount(left->head), 2);
+    CHECK_EQ_INT(refcount(shared), 4);
+
+    ds_sll_persistentRelease(&base);
+    CHECK(base == NULL);
+    CHECK_EQ_INT(refcount(shared), 3);
+
+    // dropping both handles of the left branch frees its head only, the shared node survives
+    ds_sll_persistentRelease(&left);
+    checkVersion(snapshot, (int[]){ 2, 1 }, 2);
+    ds_sll_persistentRelease(&snapshot);
+    CHECK_EQ_INT(refcount(shared), 2);
+    checkVersion(right, (int[]){ 3, 1 }, 2);
+    checkVersion(popped, (int[]){ 1 }, 1);
+
+    ds_sll_persistentRelease(&right);
+    CHECK_EQ_INT(refcount(shared), 1);
+    checkVersion(popped, (int[]){ 1 }, 1);
+
+    ds_sll_persistentRelease(&popped);
+    checkVersion(empty, NULL, 0);
+    ds_sll_persistentRelease(&empty);
+}
+
+static void testReleaseOrderDoesNotMatter(void) {
+    // a chain of versions, each one node longer than the previous, released oldest first
+    ds_sll_persistent_t* versions[6];
+    versions[0] = ds_sll_newPersistentList();
+    for(int i = 1; i < 6; i++) {
+        versions[i] = ds_sll_persistentPrependElement(versions[i - 1], newInt(i));
+    }
+
+    for(int i = 0; i < 5; i++) {
+        ds_sll_persistentRelease(&versions[i]);
+        checkVersion(versions[5], (int[]){ 5, 4, 3, 2, 1 }, 5);
+    }
+    CHECK_EQ_INT(refcount(versions[5]->head), 1);
+    CHECK_EQ_INT(refcount(versions[5]->head->next), 1);
+    ds_sll_persistentRelease(&versions[5]);
+}
+
+
+int main(void) {
+    RUN_TEST(testSharedTailRefcounts);
+    RUN_TEST(testReleaseOrderDoesNotMatter);
+    return TEST_EXIT_CODE();
+}
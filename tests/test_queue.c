@@ -0,0 +1,274 @@
+#include <pthread.h>
+#include <time.h>
+#include "SinglyLinkedListQueue.h"
+#include "test_common.h"
+
+/*
+ * Bounded MPMC queue: timeouts on a full or empty queue, close semantics (pushes fail, pops drain,
+ * every waiter wakes up), and no element lost or duplicated with several producers and consumers.
+ */
+
+#define TIMEOUT_MS 40
+#define WAITERS 3
+#define PRODUCERS 3
+#define CONSUMERS 3
+#define ITEMS_PER_PRODUCER 5000
+
+static double elapsedMs(const struct timespec* start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)(now.tv_sec - start->tv_sec) * 1e3 + (double)(now.tv_nsec - start->tv_nsec) * 1e-6;
+}
+
+static void sleepMs(long ms) {
+    struct timespec pause = { ms / 1000, (ms % 1000) * 1000000L };
+    nanosleep(&pause, NULL);
+}
+
+
+static void testTimeouts(void) {
+    ds_sll_queue_t* queue = ds_sll_newQueue(2);
+    ds_sll_t batch = { NULL, NULL };
+    struct timespec start;
+    void* element = NULL;
+
+    // empty: a zero timeout never waits, a positive one waits about that long
+    CHECK_EQ_INT(ds_sll_queuePopTimed(queue, &element, 0), DS_SLL_TIMEOUT_ERROR);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    CHECK_EQ_INT(ds_sll_queuePopTimed(queue, &element, TIMEOUT_MS), DS_SLL_TIMEOUT_ERROR);
+    CHECK(elapsedMs(&start) >= TIMEOUT_MS - 5);
+    CHECK_EQ_INT(ds_sll_queuePopBatch(queue, &batch, 4, TIMEOUT_MS), 0);
+    CHECK(batch.head == NULL);
+
+    // full
+    CHECK_EQ_INT(ds_sll_queuePush(queue, newInt(1)), DS_SLL_NO_ERROR);
+    CHECK_EQ_INT(ds_sll_queuePushTimed(queue, newInt(2), 0), DS_SLL_NO_ERROR);
+    int* rejected = newInt(3);
+    CHECK_EQ_INT(ds_sll_queuePushTimed(queue, rejected, 0), DS_SLL_TIMEOUT_ERROR);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    CHECK_EQ_INT(ds_sll_queuePushTimed(queue, rejected, TIMEOUT_MS), DS_SLL_TIMEOUT_ERROR);
+    CHECK(elapsedMs(&start) >= TIMEOUT_MS - 5);
+    free(rejected); // a rejected element still belongs to the caller
+    CHECK_EQ_INT(ds_sll_queueLength(queue), 2);
+
+    // a batch that does not fit: what fits is moved, the rest stays in the batch
+    CHECK_EQ_INT(ds_sll_queuePopTimed(queue, &element, 0), DS_SLL_NO_ERROR);
+    CHECK_EQ_INT(*(int*)element, 1);
+    free(element);
+    ds_sll_appendElement(&batch, newInt(4));
+    ds_sll_appendElement(&batch, newInt(5));
+    ds_sll_appendElement(&batch, newInt(6));
+    CHECK_EQ_INT(ds_sll_queuePushBatch(queue, &batch, TIMEOUT_MS), DS_SLL_TIMEOUT_ERROR);
+    CHECK_EQ_INT(ds_sll_queueLength(queue), 2);
+    CHECK(batch.head != NULL && *(int*)batch.head->element == 5);
+    CHECK(batch.tail != NULL && *(int*)batch.tail->element == 6);
+    CHECK(batch.head != NULL && batch.head->next == batch.tail);
+
+    int expected[] = { 2, 4 };
+    for(int i = 0; i < 2; i++) {
+        CHECK_EQ_INT(ds_sll_queuePop(queue, &element), DS_SLL_NO_ERROR);
+        CHECK_EQ_INT(*(int*)element, expected[i]);
+        free(element);
+    }
+    CHECK_EQ_INT(ds_sll_queuePushBatch(queue, &batch, 0), DS_SLL_NO_ERROR);
+    CHECK(batch.head == NULL && batch.tail == NULL);
+    CHECK_EQ_INT(ds_sll_queueLength(queue), 2);
+    ds_sll_destroyQueue(&queue);
+    CHECK(queue == NULL);
+}
+
+
+static void testCloseDrains(void) {
+    ds_sll_queue_t* queue = ds_sll_newQueue(8);
+    ds_sll_t batch = { NULL, NULL };
+    void* element = NULL;
+
+    for(int i = 0; i < 3; i++) {
+        ds_sll_queuePush(queue, newInt(i));
+    }
+    ds_sll_queueClose(queue);
+
+    int* rejected = newInt(99);
+    CHECK_EQ_INT(ds_sll_queuePush(queue, rejected), DS_SLL_QUEUE_CLOSED_ERROR);
+    CHECK_EQ_INT(ds_sll_queuePushTimed(queue, rejected, 0), DS_SLL_QUEUE_CLOSED_ERROR);
+    ds_sll_appendElement(&batch, rejected);
+    CHECK_EQ_INT(ds_sll_queuePushBatch(queue, &batch, -1), DS_SLL_QUEUE_CLOSED_ERROR);
+    CHECK(batch.head != NULL && batch.head->element == rejected);
+    CHECK_EQ_INT(ds_sll_queueLength(queue), 3);
+
+    // the queued elements are still delivered in order, then pops fail instead of blocking
+    CHECK_EQ_INT(ds_sll_queuePop(queue, &element), DS_SLL_NO_ERROR);
+    CHECK_EQ_INT(*(int*)element, 0);
+    free(element);
+    ds_sll_t drained = { NULL, NULL };
+    CHECK_EQ_INT(ds_sll_queuePopBatch(queue, &drained, 8, -1), 2);
+    CHECK(drained.head != NULL && *(int*)drained.head->element == 1);
+    CHECK(drained.tail != NULL && *(int*)drained.tail->element == 2);
+    free(drained.head->element);
+    free(drained.tail->element);
+    ds_sll_queueRecycleNodes(queue, &drained);
+    CHECK(drained.head == NULL);
+
+    CHECK_EQ_INT(ds_sll_queuePop(queue, &element), DS_SLL_QUEUE_CLOSED_ERROR);
+    CHECK_EQ_INT(ds_sll_queuePopTimed(queue, &element, TIMEOUT_MS), DS_SLL_QUEUE_CLOSED_ERROR);
+    CHECK_EQ_INT(ds_sll_queuePopBatch(queue, &drained, 8, -1), 0);
+
+    free(batch.head->element);
+    free(batch.head);
+    ds_sll_destroyQueue(&queue);
+}
+
+
+typedef struct waiter_t {
+    pthread_t thread;
+    ds_sll_queue_t* queue;
+    ds_sll_error_t result;
+} waiter_t;
+
+static void* blockedPopper(void* arg) {
+    waiter_t* waiter = (waiter_t*)arg;
+    void* element = NULL;
+    waiter->result = ds_sll_queuePop(waiter->queue, &element);
+    return NULL;
+}
+
+static void* blockedPusher(void* arg) {
+    waiter_t* waiter = (waiter_t*)arg;
+    int* element = newInt(7);
+    waiter->result = ds_sll_queuePush(waiter->queue, element);
+    if(waiter->result != DS_SLL_NO_ERROR) {
+        free(element);
+    }
+    return NULL;
+}
+
+static void testCloseWakesWaiters(void) {
+    ds_sll_queue_t* empty = ds_sll_newQueue(1);
+    ds_sll_queue_t* full = ds_sll_newQueue(1);
+    waiter_t poppers[WAITERS], pushers[WAITERS];
+
+    ds_sll_queuePush(full, newInt(0));
+    for(int i = 0; i < WAITERS; i++) {
+        poppers[i].queue = empty;
+        pushers[i].queue = full;
+        poppers[i].result = pushers[i].result = DS_SLL_NO_ERROR;
+        pthread_create(&poppers[i].thread, NULL, blockedPopper, &poppers[i]);
+        pthread_create(&pushers[i].thread, NULL, blockedPusher, &pushers[i]);
+    }
+    sleepMs(TIMEOUT_MS); // let every waiter block
+
+    ds_sll_queueClose(empty);
+    ds_sll_queueClose(full);
+    for(int i = 0; i < WAITERS; i++) {
+        pthread_join(poppers[i].thread, NULL);
+        pthread_join(pushers[i].thread, NULL);
+        CHECK_EQ_INT(poppers[i].result, DS_SLL_QUEUE_CLOSED_ERROR);
+        CHECK_EQ_INT(pushers[i].result, DS_SLL_QUEUE_CLOSED_ERROR);
+    }
+    CHECK_EQ_INT(ds_sll_queueLength(full), 1);
+
+    ds_sll_destroyQueue(&empty);
+    ds_sll_destroyQueue(&full);
+}
+
+
+typedef struct worker_t {
+    pthread_t thread;
+    ds_sll_queue_t* queue;
+    int id;
+    int* counts; /* per item, consumers only */
+    pthread_mutex_t* counts_lock;
+} worker_t;
+
+static void* producer(void* arg) {
+    worker_t* worker = (worker_t*)arg;
+    int base = worker->id * ITEMS_PER_PRODUCER;
+    for(int i = 0; i < ITEMS_PER_PRODUCER; i++) {
+        if(i % 4 == 0 && i + 1 < ITEMS_PER_PRODUCER) {
+            ds_sll_t batch = { NULL, NULL };
+            ds_sll_appendElement(&batch, newInt(base + i));
+            ds_sll_appendElement(&batch, newInt(base + i + 1));
+            ds_sll_queuePushBatch(worker->queue, &batch, -1);
+            i++;
+        } else {
+            ds_sll_queuePush(worker->queue, newInt(base + i));
+        }
+    }
+    return NULL;
+}
+
+static void countItem(worker_t* worker, int* element) {
+    pthread_mutex_lock(worker->counts_lock);
+    if(*element >= 0 && *element < PRODUCERS * ITEMS_PER_PRODUCER) {
+        worker->counts[*element]++;
+    }
+    pthread_mutex_unlock(worker->counts_lock);
+    free(element);
+}
+
+static void* consumer(void* arg) {
+    worker_t* worker = (worker_t*)arg;
+    for(;;) {
+        if(worker->id == 0) {
+            ds_sll_t batch = { NULL, NULL };
+            if(ds_sll_queuePopBatch(worker->queue, &batch, 16, -1) == 0) {
+                break; // closed and empty
+            }
+            for(ds_sll_node_t* node = batch.head; node != NULL; node = node->next) {
+                countItem(worker, (int*)node->element);
+            }
+            ds_sll_queueRecycleNodes(worker->queue, &batch);
+        } else {
+            void* element;
+            ds_sll_error_t status = ds_sll_queuePopTimed(worker->queue, &element, 5);
+            if(status == DS_SLL_QUEUE_CLOSED_ERROR) {
+                break;
+            }
+            if(status == DS_SLL_NO_ERROR) {
+                countItem(worker, (int*)element);
+            }
+        }
+    }
+    return NULL;
+}
+
+static void testProducersConsumers(void) {
+    ds_sll_queue_t* queue = ds_sll_newQueue(8);
+    int* counts = (int*)calloc(PRODUCERS * ITEMS_PER_PRODUCER, sizeof(int));
+    pthread_mutex_t counts_lock = PTHREAD_MUTEX_INITIALIZER;
+    worker_t producers[PRODUCERS], consumers[CONSUMERS];
+
+    for(int i = 0; i < CONSUMERS; i++) {
+        consumers[i] = (worker_t){ 0, queue, i, counts, &counts_lock };
+        pthread_create(&consumers[i].thread, NULL, consumer, &consumers[i]);
+    }
+    for(int i = 0; i < PRODUCERS; i++) {
+        producers[i] = (worker_t){ 0, queue, i, NULL, NULL };
+        pthread_create(&producers[i].thread, NULL, producer, &producers[i]);
+    }
+    for(int i = 0; i < PRODUCERS; i++) {
+        pthread_join(producers[i].thread, NULL);
+    }
+    ds_sll_queueClose(queue);
+    for(int i = 0; i < CONSUMERS; i++) {
+        pthread_join(consumers[i].thread, NULL);
+    }
+
+    int wrong = 0;
+    for(int i = 0; i < PRODUCERS * ITEMS_PER_PRODUCER; i++) {
+        wrong += (counts[i] != 1);
+    }
+    CHECK_EQ_INT(wrong, 0);
+    CHECK_EQ_INT(ds_sll_queueLength(queue), 0);
+    free(counts);
+    ds_sll_destroyQueue(&queue);
+}
+
+
+int main(void) {
+    RUN_TEST(testTimeouts);
+    RUN_TEST(testCloseDrains);
+    RUN_TEST(testCloseWakesWaiters);
+    RUN_TEST(testProducersConsumers);
+    return TEST_EXIT_CODE();
+}
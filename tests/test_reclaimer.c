@@ -0,0 +1,92 @@
+#include "SinglyLinkedListReclaimer.h"
+#include "test_common.h"
+
+/*
+ * Background destruction: after a drain every list handed over has been freed and the counters add up,
+ * whatever the batch size, and destroying the reclaimer frees the lists still pending.
+ */
+
+static ds_sll_t* newList(int length) {
+    ds_sll_t* linkedList = ds_sll_newSinglyLinkedList();
+    for(int i = 0; i < length; i++) {
+        ds_sll_appendElement(linkedList, newInt(i));
+    }
+    return linkedList;
+}
+
+static void checkStats(ds_sll_reclaimer_t* reclaimer, long pending, long lists, long nodes) {
+    ds_sll_reclaimer_stats_t stats = ds_sll_reclaimerStats(reclaimer);
+    CHECK_EQ_INT(stats.pending_lists, pending);
+    CHECK_EQ_INT(stats.reclaimed_lists, lists);
+    CHECK_EQ_INT(stats.reclaimed_nodes, nodes);
+}
+
+static void testDrainCounts(int batch_size) {
+    ds_sll_reclaimer_t* reclaimer = ds_sll_newReclaimer(batch_size);
+    CHECK(reclaimer != NULL);
+    if(reclaimer == NULL) {
+        return;
+    }
+
+    // nothing to do: a drain returns right away
+    ds_sll_reclaimerDrain(reclaimer);
+    checkStats(reclaimer, 0, 0, 0);
+
+    static const int lengths[] = { 1, 10, 1000, 4096 };
+    long nodes = 0;
+    for(int i = 0; i < 4; i++) {
+        ds_sll_t* linkedList = newList(lengths[i]);
+        CHECK_EQ_INT(ds_sll_destroySinglyLinkedListAsync(reclaimer, &linkedList), DS_SLL_NO_ERROR);
+        CHECK(linkedList == NULL);
+        nodes += lengths[i];
+    }
+    ds_sll_reclaimerDrain(reclaimer);
+    checkStats(reclaimer, 0, 4, nodes);
+
+    // empty and NULL lists are accepted, but there is nothing to reclaim
+    ds_sll_t* linkedList = ds_sll_newSinglyLinkedList();
+    CHECK_EQ_INT(ds_sll_destroySinglyLinkedListAsync(reclaimer, &linkedList), DS_SLL_NO_ERROR);
+    CHECK(linkedList == NULL);
+    CHECK_EQ_INT(ds_sll_destroySinglyLinkedListAsync(reclaimer, &linkedList), DS_SLL_NO_ERROR);
+    ds_sll_reclaimerDrain(reclaimer);
+    checkStats(reclaimer, 0, 4, nodes);
+
+    // lists handed over after a drain are counted on top
+    linkedList = newList(7);
+    ds_sll_destroySinglyLinkedListAsync(reclaimer, &linkedList);
+    ds_sll_reclaimerDrain(reclaimer);
+    checkStats(reclaimer, 0, 5, nodes + 7);
+
+    ds_sll_destroyReclaimer(&reclaimer);
+    CHECK(reclaimer == NULL);
+}
+
+static void testDefaultBatchSize(void) {
+    testDrainCounts(0);
+}
+
+static void testSmallBatches(void) {
+    testDrainCounts(3);
+}
+
+static void testDestroyFreesPendingLists(void) {
+    ds_sll_reclaimer_t* reclaimer = ds_sll_newReclaimer(1);
+    for(int i = 0; i < 8; i++) {
+        ds_sll_t* linkedList = newList(500);
+        ds_sll_destroySinglyLinkedListAsync(reclaimer, &linkedList);
+    }
+    ds_sll_reclaimer_stats_t stats = ds_sll_reclaimerStats(reclaimer);
+    CHECK_EQ_INT(stats.pending_lists + stats.reclaimed_lists, 8);
+
+    // no drain: the backlog is freed by the destroy itself (a leak checker sees any node left behind)
+    ds_sll_destroyReclaimer(&reclaimer);
+    CHECK(reclaimer == NULL);
+}
+
+
+int main(void) {
+    RUN_TEST(testDefaultBatchSize);
+    RUN_TEST(testSmallBatches);
+    RUN_TEST(testDestroyFreesPendingLists);
+    return TEST_EXIT_CODE();
+}
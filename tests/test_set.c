@@ -0,0 +1,159 @@
+#include "SinglyLinkedListSet.h"
+#include "test_common.h"
+
+/*
+ * Set operations on lists with duplicates: the first occurrence of every element is kept in order,
+ * whatever the hash function. Each case runs with a good hash, a hash with many collisions and a
+ * constant hash (every element collides), which must only cost time.
+ */
+
+#define MAX_VALUES 64
+
+static size_t hashInt(void* element) {
+    return ds_sll_hashBytes(element, sizeof(int));
+}
+
+static size_t hashIntMod3(void* element) {
+    return (size_t)(*(int*)element % 3);
+}
+
+static size_t hashConstant(void* element) {
+    return 7;
+}
+
+static int equalInts(void* a, void* b) {
+    return *(int*)a == *(int*)b;
+}
+
+static size_t (*const hashes[])(void*) = { hashInt, hashIntMod3, hashConstant };
+#define HASH_COUNT 3
+
+static void fillList(ds_sll_t* linkedList, const int* values, int count) {
+    for(int i = 0; i < count; i++) {
+        ds_sll_appendElement(linkedList, newInt(values[i]));
+    }
+}
+
+/* Checks the elements of a list in order, and that head, tail and the final NULL agree */
+static void checkValues(const ds_sll_t* linkedList, const int* expected, int count) {
+    int found = 0;
+    ds_sll_node_t* last = NULL;
+    for(ds_sll_node_t* node = linkedList->head; node != NULL && found < MAX_VALUES; node = node->next) {
+        if(found < count) {
+            CHECK_EQ_INT(*(int*)node->element, expected[found]);
+        }
+        found++;
+        last = node;
+    }
+    CHECK_EQ_INT(found, count);
+    CHECK(linkedList->tail == last);
+}
+
+static void freeList(ds_sll_t* linkedList) {
+    ds_sll_node_t* node;
+    while((node = ds_sll_popHeadNode(linkedList)) != NULL) {
+        ds_sll_deleteNode(&node);
+    }
+}
+
+static void testDedupe(void) {
+    for(int h = 0; h < HASH_COUNT; h++) {
+        ds_sll_t list = { NULL, NULL };
+
+        CHECK_EQ_INT(ds_sll_setDedupe(&list, hashes[h], equalInts), DS_SLL_NO_ERROR);
+        checkValues(&list, NULL, 0);
+
+        // duplicates at the head, in the middle and at the tail (the tail must move back)
+        fillList(&list, (int[]){ 4, 4, 1, 7, 4, 3, 1, 6, 9, 3, 3 }, 11);
+        CHECK_EQ_INT(ds_sll_setDedupe(&list, hashes[h], equalInts), DS_SLL_NO_ERROR);
+        checkValues(&list, (int[]){ 4, 1, 7, 3, 6, 9 }, 6);
+
+        // already distinct: unchanged
+        CHECK_EQ_INT(ds_sll_setDedupe(&list, hashes[h], equalInts), DS_SLL_NO_ERROR);
+        checkValues(&list, (int[]){ 4, 1, 7, 3, 6, 9 }, 6);
+        freeList(&list);
+
+        // all equal
+        fillList(&list, (int[]){ 5, 5, 5, 5 }, 4);
+        CHECK_EQ_INT(ds_sll_setDedupe(&list, hashes[h], equalInts), DS_SLL_NO_ERROR);
+        checkValues(&list, (int[]){ 5 }, 1);
+        freeList(&list);
+    }
+}
+
+static void testUnion(void) {
+    for(int h = 0; h < HASH_COUNT; h++) {
+        ds_sll_t first = { NULL, NULL };
+        ds_sll_t second = { NULL, NULL };
+
+        // duplicates inside and across both lists
+        fillList(&first, (int[]){ 3, 1, 3, 6 }, 4);
+        fillList(&second, (int[]){ 6, 2, 9, 2, 1, 12 }, 6);
+        CHECK_EQ_INT(ds_sll_setUnion(&first, &second, hashes[h], equalInts), DS_SLL_NO_ERROR);
+        checkValues(&first, (int[]){ 3, 1, 6, 2, 9, 12 }, 6);
+        checkValues(&second, NULL, 0);
+
+        // an empty second list only dedupes the first
+        CHECK_EQ_INT(ds_sll_setUnion(&first, &second, hashes[h], equalInts), DS_SLL_NO_ERROR);
+        checkValues(&first, (int[]){ 3, 1, 6, 2, 9, 12 }, 6);
+
+        // an empty first list takes the distinct elements of the second
+        fillList(&second, (int[]){ 8, 8, 5 }, 3);
+        ds_sll_t empty = { NULL, NULL };
+        CHECK_EQ_INT(ds_sll_setUnion(&empty, &second, hashes[h], equalInts), DS_SLL_NO_ERROR);
+        checkValues(&empty, (int[]){ 8, 5 }, 2);
+        checkValues(&second, NULL, 0);
+
+        freeList(&first);
+        freeList(&empty);
+    }
+}
+
+static void testIntersectionAndDifference(void) {
+    static const int firstValues[] = { 5, 2, 9, 2, 7, 5, 12, 0 };
+    static const int secondValues[] = { 12, 3, 5, 5, 0, 15, 6 };
+
+    for(int h = 0; h < HASH_COUNT; h++) {
+        ds_sll_t first = { NULL, NULL };
+        ds_sll_t second = { NULL, NULL };
+        ds_sll_t empty = { NULL, NULL };
+        fillList(&second, secondValues, 7);
+
+        // the second list (duplicates included) is left untouched by both
+        fillList(&first, firstValues, 8);
+        CHECK_EQ_INT(ds_sll_setIntersection(&first, &second, hashes[h], equalInts), DS_SLL_NO_ERROR);
+        checkValues(&first, (int[]){ 5, 12, 0 }, 3);
+        checkValues(&second, secondValues, 7);
+        freeList(&first);
+
+        fillList(&first, firstValues, 8);
+        CHECK_EQ_INT(ds_sll_setDifference(&first, &second, hashes[h], equalInts), DS_SLL_NO_ERROR);
+        checkValues(&first, (int[]){ 2, 9, 7 }, 3);
+        checkValues(&second, secondValues, 7);
+        freeList(&first);
+
+        // against an empty list: nothing is in common, everything is different (but deduplicated)
+        fillList(&first, firstValues, 8);
+        CHECK_EQ_INT(ds_sll_setIntersection(&first, &empty, hashes[h], equalInts), DS_SLL_NO_ERROR);
+        checkValues(&first, NULL, 0);
+        fillList(&first, firstValues, 8);
+        CHECK_EQ_INT(ds_sll_setDifference(&first, &empty, hashes[h], equalInts), DS_SLL_NO_ERROR);
+        checkValues(&first, (int[]){ 5, 2, 9, 7, 12, 0 }, 6);
+        freeList(&first);
+
+        // an empty first list stays empty
+        CHECK_EQ_INT(ds_sll_setIntersection(&first, &second, hashes[h], equalInts), DS_SLL_NO_ERROR);
+        CHECK_EQ_INT(ds_sll_setDifference(&first, &second, hashes[h], equalInts), DS_SLL_NO_ERROR);
+        checkValues(&first, NULL, 0);
+
+        freeList(&second);
+    }
+}
+
+
+int main(void) {
+    RUN_TEST(testDedupe);
+    RUN_TEST(testUnion);
+    RUN_TEST(testIntersectionAndDifference);
+    return TEST_EXIT_CODE();
+}
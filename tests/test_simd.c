@@ -0,0 +1,215 @@
+#include <pthread.h>
+#include <stdint.h>
+#include <string.h>
+#include "SinglyLinkedListSimd.h"
+#include "test_common.h"
+
+/*
+ * Every vectorized kernel, at every level the running CPU supports, must return exactly what the scalar
+ * kernels return. The lengths straddle the 256 value gather blocks of the list kernels.
+ * All values are small integers, so float sums are exact whatever order they are added in.
+ */
+
+#define MAX_LENGTH 600
+#define FIRST_USE_THREADS 4
+
+static const int lengths[] = { 0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 32, 33, 255, 256, 257, 511, 512, 513, 600 };
+static const char* type_names[] = { "int32", "int64", "float", "double" };
+
+typedef struct results_t {
+    int first_duplicate, first_last, first_absent;
+    int count_duplicate, count_absent;
+    ds_sll_error_t min_status, max_status;
+    unsigned char min[8], max[8];
+    int64_t sum_integer;
+    double sum_float;
+    // list kernels (only for non-empty inputs)
+    int list_first_duplicate, list_first_last, list_first_absent;
+    int list_count_duplicate;
+    unsigned char list_min[8], list_max[8];
+    int64_t list_sum_integer;
+    double list_sum_float;
+} results_t;
+
+static void storeValue(ds_sll_simd_type_t type, void* values, int index, int value) {
+    switch(type) {
+        case DS_SLL_SIMD_INT32: ((int32_t*)values)[index] = value; break;
+        case DS_SLL_SIMD_INT64: ((int64_t*)values)[index] = (int64_t)value * 1000000007LL; break;
+        case DS_SLL_SIMD_FLOAT: ((float*)values)[index] = (float)value; break;
+        default: ((double*)values)[index] = (double)value; break;
+    }
+}
+
+/* Values repeat with a period of 61, with a unique extreme planted in the middle and a unique key at the end */
+static void fillValues(ds_sll_simd_type_t type, void* values, int length) {
+    for(int i = 0; i < length; i++) {
+        storeValue(type, values, i, (i * 37) % 61 - 30);
+    }
+    if(length > 2) {
+        storeValue(type, values, length / 2, -5000);
+    }
+    if(length > 0) {
+        storeValue(type, values, length - 1, 5000);
+    }
+}
+
+static void computeResults(ds_sll_simd_type_t type, const void* values, int length, results_t* results) {
+    size_t size = ds_sll_simdTypeSize(type);
+    unsigned char duplicate[8], last[8], absent[8], sum[8];
+    unsigned char keys[3 * 8];
+    storeValue(type, keys, 0, (3 * 37) % 61 - 30); // the value at index 3, repeated every 61 values
+    storeValue(type, keys, 1, 5000);
+    storeValue(type, keys, 2, 7777);
+    memcpy(duplicate, keys, size);
+    memcpy(last, keys + size, size);
+    memcpy(absent, keys + 2 * size, size);
+
+    memset(results, 0, sizeof(*results));
+    results->first_duplicate = ds_sll_simdFindFirst(values, length, type, duplicate);
+    results->first_last = ds_sll_simdFindFirst(values, length, type, last);
+    results->first_absent = ds_sll_simdFindFirst(values, length, type, absent);
+    results->count_duplicate = ds_sll_simdCount(values, length, type, duplicate);
+    results->count_absent = ds_sll_simdCount(values, length, type, absent);
+    results->min_status = ds_sll_simdMin(values, length, type, results->min);
+    results->max_status = ds_sll_simdMax(values, length, type, results->max);
+    ds_sll_simdSum(values, length, type, sum);
+    if(type == DS_SLL_SIMD_INT32 || type == DS_SLL_SIMD_INT64) {
+        memcpy(&results->sum_integer, sum, sizeof(int64_t));
+    } else {
+        memcpy(&results->sum_float, sum, sizeof(double));
+    }
+
+    if(length == 0) {
+        return; // the list kernels require a non-empty list
+    }
+    ds_sll_t* list = ds_sll_newSinglyLinkedList();
+    for(int i = 0; i < length; i++) {
+        ds_sll_appendElementCopy(list, (unsigned char*)values + i * size, size);
+    }
+    if(ds_sll_findNodeContainingValue(list, type, duplicate, &results->list_first_duplicate) == NULL) {
+        results->list_first_duplicate = -1;
+    }
+    if(ds_sll_findNodeContainingValue(list, type, last, &results->list_first_last) == NULL) {
+        results->list_first_last = -1;
+    }
+    if(ds_sll_findNodeContainingValue(list, type, absent, &results->list_first_absent) == NULL) {
+        results->list_first_absent = -1;
+    }
+    results->list_count_duplicate = ds_sll_countNodesContainingValue(list, type, duplicate);
+    ds_sll_minValue(list, type, results->list_min);
+    ds_sll_maxValue(list, type, results->list_max);
+    ds_sll_sumValues(list, type, sum);
+    if(type == DS_SLL_SIMD_INT32 || type == DS_SLL_SIMD_INT64) {
+        memcpy(&results->list_sum_integer, sum, sizeof(int64_t));
+    } else {
+        memcpy(&results->list_sum_float, sum, sizeof(double));
+    }
+    ds_sll_destroySinglyLinkedList(&list);
+}
+
+static void compareResults(const results_t* expected, const results_t* actual, ds_sll_simd_type_t type, int length, ds_sll_simd_level_t level) {
+    size_t size = ds_sll_simdTypeSize(type);
+    int failures_before = test_failures;
+
+    CHECK_EQ_INT(actual->first_duplicate, expected->first_duplicate);
+    CHECK_EQ_INT(actual->first_last, expected->first_last);
+    CHECK_EQ_INT(actual->first_absent, expected->first_absent);
+    CHECK_EQ_INT(actual->count_duplicate, expected->count_duplicate);
+    CHECK_EQ_INT(actual->count_absent, expected->count_absent);
+    CHECK_EQ_INT(actual->min_status, expected->min_status);
+    CHECK_EQ_INT(actual->max_status, expected->max_status);
+    CHECK(memcmp(actual->min, expected->min, size) == 0);
+    CHECK(memcmp(actual->max, expected->max, size) == 0);
+    CHECK_EQ_INT(actual->sum_integer, expected->sum_integer);
+    CHECK(actual->sum_float == expected->sum_float);
+
+    CHECK_EQ_INT(actual->list_first_duplicate, expected->list_first_duplicate);
+    CHECK_EQ_INT(actual->list_first_last, expected->list_first_last);
+    CHECK_EQ_INT(actual->list_first_absent, expected->list_first_absent);
+    CHECK_EQ_INT(actual->list_count_duplicate, expected->list_count_duplicate);
+    CHECK(memcmp(actual->list_min, expected->list_min, size) == 0);
+    CHECK(memcmp(actual->list_max, expected->list_max, size) == 0);
+    CHECK_EQ_INT(actual->list_sum_integer, expected->list_sum_integer);
+    CHECK(actual->list_sum_float == expected->list_sum_float);
+
+    if(test_failures != failures_before) {
+        fprintf(stderr, "  (type %s, length %d, level %d)\n", type_names[type], length, (int)level);
+    }
+}
+
+/* The scalar results themselves, checked against the known contents of the input */
+static void checkScalarResults(const results_t* results, int length) {
+    CHECK_EQ_INT(results->first_last, length > 0 ? length - 1 : -1);
+    CHECK_EQ_INT(results->first_absent, -1);
+    CHECK_EQ_INT(results->count_absent, 0);
+    if(length >= 8) {
+        CHECK_EQ_INT(results->first_duplicate, 3);
+    }
+    CHECK_EQ_INT(results->min_status, length > 0 ? DS_SLL_NO_ERROR : DS_SLL_LIST_TOO_SMALL_ERROR);
+    if(length > 0) {
+        CHECK_EQ_INT(results->list_first_last, length - 1);
+        CHECK_EQ_INT(results->list_first_duplicate, results->first_duplicate);
+        CHECK_EQ_INT(results->list_count_duplicate, results->count_duplicate);
+    }
+}
+
+static void testKernelsMatchScalar(void) {
+    static unsigned char values[MAX_LENGTH * 8];
+    ds_sll_simd_level_t best = ds_sll_simdDetectLevel();
+
+    for(int type = 0; type <= DS_SLL_SIMD_DOUBLE; type++) {
+        for(size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+            int length = lengths[l];
+            results_t expected, actual;
+            fillValues((ds_sll_simd_type_t)type, values, length);
+
+            CHECK_EQ_INT(ds_sll_simdSetLevel(DS_SLL_SIMD_SCALAR), DS_SLL_SIMD_SCALAR);
+            computeResults((ds_sll_simd_type_t)type, values, length, &expected);
+            checkScalarResults(&expected, length);
+
+            for(int level = DS_SLL_SIMD_SCALAR + 1; level <= (int)best; level++) {
+                CHECK_EQ_INT(ds_sll_simdSetLevel((ds_sll_simd_level_t)level), level);
+                CHECK_EQ_INT(ds_sll_simdGetLevel(), level);
+                computeResults((ds_sll_simd_type_t)type, values, length, &actual);
+                compareResults(&expected, &actual, (ds_sll_simd_type_t)type, length, (ds_sll_simd_level_t)level);
+            }
+        }
+    }
+    ds_sll_simdSetLevel(best);
+}
+
+static void testSetLevelClampsToCpu(void) {
+    ds_sll_simd_level_t best = ds_sll_simdDetectLevel();
+    CHECK_EQ_INT(ds_sll_simdSetLevel(DS_SLL_SIMD_AVX2), best);
+    CHECK_EQ_INT(ds_sll_simdGetLevel(), best);
+}
+
+
+/* Racing first uses must all see the same, fully selected kernel set */
+static void* firstUse(void* arg) {
+    int32_t values[3] = { 4, -2, 9 };
+    int32_t min = 0;
+    ds_sll_simdMin(values, 3, DS_SLL_SIMD_INT32, &min);
+    *(int*)arg = (min == -2) ? (int)ds_sll_simdGetLevel() : -1;
+    return NULL;
+}
+
+static void testConcurrentFirstUse(void) {
+    pthread_t threads[FIRST_USE_THREADS];
+    int levels[FIRST_USE_THREADS];
+    for(int t = 0; t < FIRST_USE_THREADS; t++) {
+        pthread_create(&threads[t], NULL, firstUse, &levels[t]);
+    }
+    for(int t = 0; t < FIRST_USE_THREADS; t++) {
+        pthread_join(threads[t], NULL);
+        CHECK_EQ_INT(levels[t], ds_sll_simdDetectLevel());
+    }
+}
+
+
+int main(void) {
+    RUN_TEST(testConcurrentFirstUse); // must run first, before anything selects the kernels
+    RUN_TEST(testKernelsMatchScalar);
+    RUN_TEST(testSetLevelClampsToCpu);
+    return TEST_EXIT_CODE();
+}
@@ -0,0 +1,143 @@
+#include "SinglyLinkedList.h"
+#include "test_common.h"
+
+/*
+ * Sorted lists: inserts and merges keep the comparator order, equal keys keep their insertion order
+ * (and the first list's elements come first in a merge), and empty inputs are handled on both sides.
+ */
+
+#define MAX_VALUES 64
+
+/* Elements are ordered by key only, the tag records where an element came from */
+typedef struct item_t {
+    int key;
+    int tag;
+} item_t;
+
+static item_t* newItem(int key, int tag) {
+    item_t* item = (item_t*)malloc(sizeof(item_t));
+    item->key = key;
+    item->tag = tag;
+    return item;
+}
+
+static int compareKeys(void* a, void* b) {
+    return ((item_t*)a)->key - ((item_t*)b)->key;
+}
+
+/* Checks keys and tags in order, and that head, tail and the final NULL agree */
+static void checkItems(const ds_sll_t* linkedList, const int* keys, const int* tags, int count) {
+    int found = 0;
+    ds_sll_node_t* last = NULL;
+    for(ds_sll_node_t* node = linkedList->head; node != NULL && found < MAX_VALUES; node = node->next) {
+        if(found < count) {
+            CHECK_EQ_INT(((item_t*)node->element)->key, keys[found]);
+            CHECK_EQ_INT(((item_t*)node->element)->tag, tags[found]);
+        }
+        found++;
+        last = node;
+    }
+    CHECK_EQ_INT(found, count);
+    CHECK(linkedList->tail == last);
+}
+
+static void freeList(ds_sll_t* linkedList) {
+    ds_sll_node_t* node;
+    while((node = ds_sll_popHeadNode(linkedList)) != NULL) {
+        ds_sll_deleteNode(&node);
+    }
+}
+
+static void fillSorted(ds_sll_t* linkedList, const int* keys, int count, int tag) {
+    for(int i = 0; i < count; i++) {
+        ds_sll_insertElementSorted(linkedList, newItem(keys[i], tag), compareKeys);
+    }
+}
+
+static void testInsertIsStable(void) {
+    ds_sll_t list = { NULL, NULL };
+    static const int keys[] = { 5, 1, 5, 3, 1, 9, 5 };
+
+    // the tag is the insertion order, equal keys must keep it (head, middle and tail positions)
+    for(int i = 0; i < 7; i++) {
+        CHECK_EQ_INT(ds_sll_insertElementSorted(&list, newItem(keys[i], i), compareKeys), DS_SLL_NO_ERROR);
+    }
+    checkItems(&list, (int[]){ 1, 1, 3, 5, 5, 5, 9 }, (int[]){ 1, 4, 3, 0, 2, 6, 5 }, 7);
+
+    // the copy and node variants land in the same place, after the equal keys already there
+    item_t copy = { 3, 7 };
+    CHECK_EQ_INT(ds_sll_insertElementCopySorted(&list, &copy, sizeof(copy), compareKeys), DS_SLL_NO_ERROR);
+    ds_sll_insertNodeSorted(&list, ds_sll_createNode(newItem(9, 8)), compareKeys);
+    ds_sll_insertNodeSorted(&list, ds_sll_createNode(newItem(0, 9)), compareKeys);
+    checkItems(&list, (int[]){ 0, 1, 1, 3, 3, 5, 5, 5, 9, 9 }, (int[]){ 9, 1, 4, 3, 7, 0, 2, 6, 5, 8 }, 10);
+
+    freeList(&list);
+}
+
+static void testMergeTwo(void) {
+    ds_sll_t first = { NULL, NULL };
+    ds_sll_t second = { NULL, NULL };
+
+    // both empty
+    ds_sll_mergeSortedLists(&first, &second, compareKeys);
+    checkItems(&first, NULL, NULL, 0);
+
+    // empty first takes the whole second list
+    fillSorted(&second, (int[]){ 2, 4 }, 2, 1);
+    ds_sll_mergeSortedLists(&first, &second, compareKeys);
+    checkItems(&first, (int[]){ 2, 4 }, (int[]){ 1, 1 }, 2);
+    checkItems(&second, NULL, NULL, 0);
+
+    // empty second changes nothing
+    ds_sll_mergeSortedLists(&first, &second, compareKeys);
+    checkItems(&first, (int[]){ 2, 4 }, (int[]){ 1, 1 }, 2);
+
+    // interleaved, with equal keys: the first list's element comes first, and the second's tail becomes the tail
+    fillSorted(&second, (int[]){ 1, 2, 4, 7 }, 4, 2);
+    ds_sll_mergeSortedLists(&first, &second, compareKeys);
+    checkItems(&first, (int[]){ 1, 2, 2, 4, 4, 7 }, (int[]){ 2, 1, 2, 1, 2, 2 }, 6);
+    checkItems(&second, NULL, NULL, 0);
+
+    // the first list's tail stays the tail when the second one runs out first
+    fillSorted(&second, (int[]){ 0, 3 }, 2, 3);
+    ds_sll_mergeSortedLists(&first, &second, compareKeys);
+    checkItems(&first, (int[]){ 0, 1, 2, 2, 3, 4, 4, 7 }, (int[]){ 3, 2, 1, 2, 3, 1, 2, 2 }, 8);
+
+    freeList(&first);
+}
+
+static void testMergeK(void) {
+    ds_sll_t lists[5];
+    ds_sll_t* pointers[5];
+    for(int i = 0; i < 5; i++) {
+        lists[i].head = NULL;
+        lists[i].tail = NULL;
+        pointers[i] = &lists[i];
+    }
+
+    // no list, a single list, and only empty lists
+    ds_sll_mergeSortedListsK(pointers, 0, compareKeys);
+    ds_sll_mergeSortedListsK(pointers, 1, compareKeys);
+    ds_sll_mergeSortedListsK(pointers, 5, compareKeys);
+    checkItems(&lists[0], NULL, NULL, 0);
+
+    // empty lists at the front, middle and end; the tag is the list index, equal keys follow the list order
+    fillSorted(&lists[1], (int[]){ 1, 5, 8 }, 3, 1);
+    fillSorted(&lists[3], (int[]){ 2, 5 }, 2, 3);
+    fillSorted(&lists[4], (int[]){ 5, 9 }, 2, 4);
+    ds_sll_mergeSortedListsK(pointers, 5, compareKeys);
+    checkItems(&lists[0], (int[]){ 1, 2, 5, 5, 5, 8, 9 }, (int[]){ 1, 3, 1, 3, 4, 1, 4 }, 7);
+    for(int i = 1; i < 5; i++) {
+        checkItems(&lists[i], NULL, NULL, 0);
+    }
+
+    freeList(&lists[0]);
+}
+
+
+int main(void) {
+    RUN_TEST(testInsertIsStable);
+    RUN_TEST(testMergeTwo);
+    RUN_TEST(testMergeK);
+    return TEST_EXIT_CODE();
+}
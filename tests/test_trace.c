@@ -0,0 +1,183 @@
+#include <stdio.h>
+#include "SinglyLinkedList.h"
+#include "SinglyLinkedListTrace.h"
+#include "SinglyLinkedListEpoch.h"
+#include "SinglyLinkedListLazy.h"
+#include "SinglyLinkedListPartition.h"
+#include "SinglyLinkedListReclaimer.h"
+#include "SinglyLinkedListSet.h"
+#include "SinglyLinkedListSlab.h"
+#include "test_common.h"
+
+/*
+ * Only the list operations called by the user are recorded. The core calls other modules make internally
+ * (Lazy and Epoch on their embedded lists, Set and Slab on the user's lists) must not show up, or the trace could
+ * not be replayed.
+ */
+
+#define TRACE_PATH "test_trace.dslltrace"
+#define MAX_RECORDS 64
+
+static size_t hashInt(void* element) {
+    return (size_t)*(int*)element;
+}
+
+static int equalInts(void* a, void* b) {
+    return *(int*)a == *(int*)b;
+}
+
+static int readTrace(ds_sll_trace_record_t* records) {
+    FILE* trace = ds_sll_traceOpen(TRACE_PATH);
+    int count = 0;
+    CHECK(trace != NULL);
+    if(trace == NULL) {
+        return 0;
+    }
+    while((count < MAX_RECORDS) && ds_sll_traceRead(trace, &records[count])) {
+        count++;
+    }
+    fclose(trace);
+    remove(TRACE_PATH);
+    return count;
+}
+
+static void testInternalCallsAreNotRecorded(void) {
+    ds_sll_trace_record_t records[MAX_RECORDS];
+    CHECK_EQ_INT(ds_sll_traceStart(TRACE_PATH), DS_SLL_NO_ERROR);
+
+    // Lazy: appends, inserts and compaction all work on the embedded list
+    ds_sll_lazy_t* lazyList = ds_sll_newLazyList(1.0);
+    ds_sll_lazyAppendElement(lazyList, newInt(1));
+    ds_sll_lazyAppendElement(lazyList, newInt(2));
+    ds_sll_lazyInsertElementAtIndex(lazyList, newInt(0), 0);
+    ds_sll_lazyDeleteNodeAtIndex(lazyList, 1);
+    CHECK_EQ_INT(ds_sll_lazyCompact(lazyList), 1);
+    ds_sll_destroyLazyList(&lazyList);
+
+    // Set and Slab modify user lists: only the user's own calls are recorded
+    ds_sll_t* first = ds_sll_newSinglyLinkedList();
+    ds_sll_t* second = ds_sll_newSinglyLinkedList();
+    ds_sll_appendElement(first, newInt(1));
+    ds_sll_appendElement(first, newInt(1));
+    ds_sll_appendElement(second, newInt(2));
+    ds_sll_appendElement(second, newInt(1));
+    CHECK_EQ_INT(ds_sll_setUnion(first, second, hashInt, equalInts), DS_SLL_NO_ERROR);
+    CHECK_EQ_INT(ds_sll_setDedupe(first, hashInt, equalInts), DS_SLL_NO_ERROR);
+
+    ds_sll_slab_t* slab = ds_sll_newSlab(sizeof(int), 0, DS_SLL_SLAB_PAGES_DEFAULT);
+    ds_sll_t* slabList = ds_sll_newSinglyLinkedList();
+    int value = 3;
+    ds_sll_slabAppendElementCopy(slab, slabList, &value, sizeof(value));
+    ds_sll_slabAppendElement(slab, slabList, newInt(4));
+
+    CHECK_EQ_INT(ds_sll_traceStop(), DS_SLL_NO_ERROR);
+    ds_sll_slabReleaseList(slab, slabList);
+    ds_sll_destroySlab(&slab);
+    free(slabList);
+
+    int count = readTrace(records);
+    static const ds_sll_trace_op_t expected[] = {
+        DS_SLL_TRACE_NEW_LIST, DS_SLL_TRACE_NEW_LIST,
+        DS_SLL_TRACE_APPEND, DS_SLL_TRACE_APPEND, DS_SLL_TRACE_APPEND, DS_SLL_TRACE_APPEND,
+        DS_SLL_TRACE_NEW_LIST
+    };
+    CHECK_EQ_INT(count, sizeof(expected) / sizeof(expected[0]));
+    for(int i = 0; i < count && i < (int)(sizeof(expected) / sizeof(expected[0])); i++) {
+        CHECK_EQ_INT(records[i].op, expected[i]);
+    }
+
+    // every list a record refers to was created inside the trace, so the trace can be replayed
+    uint32_t created = 0;
+    for(int i = 0; i < count; i++) {
+        if(records[i].op == DS_SLL_TRACE_NEW_LIST) {
+            created = records[i].list_id > created ? records[i].list_id : created;
+        } else {
+            CHECK(records[i].list_id != 0 && records[i].list_id <= created);
+        }
+    }
+
+    ds_sll_destroySinglyLinkedList(&first);
+    ds_sll_destroySinglyLinkedList(&second);
+}
+
+static void testEpochCallsAreNotRecorded(void) {
+    ds_sll_trace_record_t records[MAX_RECORDS];
+    CHECK_EQ_INT(ds_sll_traceStart(TRACE_PATH), DS_SLL_NO_ERROR);
+
+    ds_sll_epoch_list_t* epochList = ds_sll_newEpochList();
+    ds_sll_epochAppendElement(epochList, newInt(1));
+    ds_sll_epochAppendElement(epochList, newInt(3));
+    CHECK_EQ_INT(ds_sll_epochInsertElementAtIndex(epochList, newInt(2), 1), DS_SLL_NO_ERROR);
+    CHECK_EQ_INT(ds_sll_epochInsertElementAtIndex(epochList, newInt(9), 7), DS_SLL_INDEX_OUT_OF_BOUNDS_ERROR);
+    CHECK_EQ_INT(ds_sll_epochDeleteNodeAtIndex(epochList, 2), DS_SLL_NO_ERROR);
+    CHECK_EQ_INT(ds_sll_epochDeleteNodeAtIndex(epochList, 5), DS_SLL_INDEX_OUT_OF_BOUNDS_ERROR);
+
+    CHECK_EQ_INT(ds_sll_traceStop(), DS_SLL_NO_ERROR);
+    ds_sll_destroyEpochList(&epochList);
+
+    CHECK_EQ_INT(readTrace(records), 0);
+}
+
+static void testAsyncDestroyForgetsTheList(void) {
+    ds_sll_trace_record_t records[MAX_RECORDS];
+    ds_sll_reclaimer_t* reclaimer = ds_sll_newReclaimer(0);
+    CHECK_EQ_INT(ds_sll_traceStart(TRACE_PATH), DS_SLL_NO_ERROR);
+
+    ds_sll_t* linkedList = ds_sll_newSinglyLinkedList();
+    ds_sll_appendElement(linkedList, newInt(1));
+    CHECK_EQ_INT(ds_sll_destroySinglyLinkedListAsync(reclaimer, &linkedList), DS_SLL_NO_ERROR);
+    // the allocator is likely to hand the same address back, which must not inherit the old id
+    linkedList = ds_sll_newSinglyLinkedList();
+
+    CHECK_EQ_INT(ds_sll_traceStop(), DS_SLL_NO_ERROR);
+    ds_sll_destroySinglyLinkedList(&linkedList);
+    ds_sll_destroyReclaimer(&reclaimer);
+
+    int count = readTrace(records);
+    CHECK_EQ_INT(count, 4);
+    if(count == 4) {
+        CHECK_EQ_INT(records[2].op, DS_SLL_TRACE_DESTROY_LIST);
+        CHECK_EQ_INT(records[2].list_id, records[0].list_id);
+        CHECK_EQ_INT(records[3].op, DS_SLL_TRACE_NEW_LIST);
+        CHECK(records[3].list_id != records[0].list_id);
+    }
+}
+
+static void testPartitionRecordsOnlyTheConcatenations(void) {
+    ds_sll_trace_record_t records[MAX_RECORDS];
+    ds_sll_t* linkedList = ds_sll_newSinglyLinkedList();
+    ds_sll_t* segments[3];
+    for(int i = 0; i < 3; i++) {
+        segments[i] = ds_sll_newSinglyLinkedList();
+    }
+    for(int i = 0; i < 5; i++) {
+        ds_sll_appendElement(linkedList, newInt(i));
+    }
+
+    CHECK_EQ_INT(ds_sll_traceStart(TRACE_PATH), DS_SLL_NO_ERROR);
+    CHECK_EQ_INT(ds_sll_partitionByHash(linkedList, segments, 3, hashInt), DS_SLL_NO_ERROR);
+    ds_sll_concatenateSegments(linkedList, segments, 3);
+    CHECK_EQ_INT(ds_sll_traceStop(), DS_SLL_NO_ERROR);
+
+    // the partition itself is a known gap of the trace, the concatenations are recorded one per segment
+    int count = readTrace(records);
+    CHECK_EQ_INT(count, 3);
+    for(int i = 0; i < count; i++) {
+        CHECK_EQ_INT(records[i].op, DS_SLL_TRACE_CONCATENATE);
+        CHECK(records[i].list_id != records[i].other_list_id);
+    }
+
+    for(int i = 0; i < 3; i++) {
+        free(segments[i]);
+    }
+    ds_sll_destroySinglyLinkedList(&linkedList);
+}
+
+
+int main(void) {
+    RUN_TEST(testInternalCallsAreNotRecorded);
+    RUN_TEST(testEpochCallsAreNotRecorded);
+    RUN_TEST(testAsyncDestroyForgetsTheList);
+    RUN_TEST(testPartitionRecordsOnlyTheConcatenations);
+    return TEST_EXIT_CODE();
+}